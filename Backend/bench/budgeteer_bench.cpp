@@ -0,0 +1,544 @@
+/**
+ * @file budgeteer_bench.cpp
+ * @brief Reproducible micro and macro benchmarks for the Budgeteer backend
+ *
+ * Measures the catalogue hot paths (CSV loading, search, filters, statistics,
+ * JSON serialization and basket ranking) and reports ns/op, allocations/op,
+ * bytes allocated/op and ops/s as JSON. Every benchmark is deterministic:
+ * inputs are fixed query strings over a fixed dataset, and each benchmark is
+ * repeated several times with the median reported.
+ *
+ * With --llm-endpoint (typically a local budgeteer_mock_llm) the report also
+ * compares the sequential and single-pass LLM pipelines on a fixed set of
+ * shopping requests: wall time, GPT round trips, list size, basket cost and
+ * how much the two lists overlap. GPT mode needs GITHUB_TOKEN set; the mock
+ * accepts any value.
+ *
+ * Usage:
+ *   budgeteer_bench [--dataset <csv>] [--filter <substring>] [--min-time-ms <n>]
+ *                   [--repetitions <n>] [--workload <tsv>] [--llm-endpoint <url>]
+ *                   [--out <file>] [--list]
+ *
+ * Example:
+ *   ./bin/budgeteer_bench --filter search --out search.json
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "ApiServer.h"
+#include "BasketOptimizer.h"
+#include "Database.h"
+#include "LLMInterface.h"
+#include "RequestContext.h"
+#include "StoreApiClient.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+// ==================== Allocation tracking ====================
+//
+// Replacing the global allocation functions lets every benchmark report how
+// many heap allocations (and bytes) a single operation performs.
+
+namespace {
+std::atomic<uint64_t> allocationCount{0};
+std::atomic<uint64_t> allocatedBytes{0};
+}
+
+// GCC flags free() on memory from operator new, which is exactly what the
+// replacement pair below does on purpose
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+// std::pmr's default resource allocates through the aligned forms. The block
+// is over-allocated and the malloc() pointer is kept just in front of it.
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    const auto align = static_cast<std::uintptr_t>(alignment);
+    if (void* raw = std::malloc(size + align + sizeof(void*))) {
+        auto aligned = (reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*) + align - 1) & ~(align - 1);
+        reinterpret_cast<void**>(aligned)[-1] = raw;
+        return reinterpret_cast<void*>(aligned);
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    if (ptr) std::free(static_cast<void**>(ptr)[-1]);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    if (ptr) std::free(static_cast<void**>(ptr)[-1]);
+}
+
+namespace {
+
+// ==================== Benchmark harness ====================
+
+/// Prevents the optimizer from discarding benchmark results
+std::atomic<size_t> sink{0};
+
+template <typename T>
+void keep(const T& value) {
+    sink.fetch_add(value.size(), std::memory_order_relaxed);
+}
+
+struct Benchmark {
+    std::string name;
+    std::string category;                 ///< "micro" or "macro"
+    std::function<size_t()> run;          ///< Runs one iteration, returns the operations it performed (queries, lookups, rows parsed)
+};
+
+struct Result {
+    std::string name;
+    std::string category;
+    uint64_t iterations;
+    double nsPerOp;
+    double allocsPerOp;
+    double bytesPerOp;
+    double opsPerSecond;
+};
+
+struct Options {
+    std::string dataset = "SampleDataset/yec_competition_dataset.csv";
+    std::string filter;
+    std::string outFile;
+    std::string workloadFile;            ///< Query workload from budgeteer_datagen
+    std::string llmEndpoint;             ///< Chat completions endpoint for the pipeline comparison
+    int minTimeMs = 200;
+    int repetitions = 5;
+    bool listOnly = false;
+};
+
+Result measure(const Benchmark& bench, const Options& options) {
+    // Warm-up run (fills caches, triggers lazy static initialization)
+    bench.run();
+
+    std::vector<Result> reps;
+    for (int rep = 0; rep < options.repetitions; rep++) {
+        uint64_t iterations = 0;
+        size_t operations = 0;
+        uint64_t allocsBefore = allocationCount.load();
+        uint64_t bytesBefore = allocatedBytes.load();
+        auto start = std::chrono::steady_clock::now();
+        auto deadline = start + std::chrono::milliseconds(options.minTimeMs);
+
+        do {
+            operations += bench.run();
+            iterations++;
+        } while (std::chrono::steady_clock::now() < deadline);
+
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+
+        // Per-operation figures share one denominator, so ns_per_op == 1e9 / ops_per_second
+        const double ops = static_cast<double>(std::max<size_t>(1, operations));
+        Result r;
+        r.name = bench.name;
+        r.category = bench.category;
+        r.iterations = iterations;
+        r.nsPerOp = ns / ops;
+        r.allocsPerOp = static_cast<double>(allocationCount.load() - allocsBefore) / ops;
+        r.bytesPerOp = static_cast<double>(allocatedBytes.load() - bytesBefore) / ops;
+        r.opsPerSecond = ns > 0 ? ops * 1e9 / ns : 0.0;
+        reps.push_back(r);
+    }
+
+    // Report the median repetition by ns/op
+    std::sort(reps.begin(), reps.end(), [](const Result& a, const Result& b) {
+        return a.nsPerOp < b.nsPerOp;
+    });
+    return reps[reps.size() / 2];
+}
+
+Options parseArgs(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--dataset" && i + 1 < argc) {
+            options.dataset = argv[++i];
+        } else if (arg == "--filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (arg == "--min-time-ms" && i + 1 < argc) {
+            options.minTimeMs = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            options.repetitions = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--out" && i + 1 < argc) {
+            options.outFile = argv[++i];
+        } else if (arg == "--workload" && i + 1 < argc) {
+            options.workloadFile = argv[++i];
+        } else if (arg == "--llm-endpoint" && i + 1 < argc) {
+            options.llmEndpoint = argv[++i];
+        } else if (arg == "--list") {
+            options.listOnly = true;
+        } else if (arg == "--help") {
+            std::cout << "Usage: " << argv[0] << " [options]\n\n";
+            std::cout << "Options:\n";
+            std::cout << "  --dataset <csv>       Catalogue to load (default: SampleDataset/yec_competition_dataset.csv)\n";
+            std::cout << "  --filter <substring>  Only run benchmarks whose name contains <substring>\n";
+            std::cout << "  --min-time-ms <n>     Minimum measured time per repetition (default: 200)\n";
+            std::cout << "  --repetitions <n>     Repetitions per benchmark, median is reported (default: 5)\n";
+            std::cout << "  --workload <tsv>      Add search/workload_file over queries from budgeteer_datagen\n";
+            std::cout << "  --llm-endpoint <url>  Compare LLM pipelines against this endpoint (e.g. budgeteer_mock_llm)\n";
+            std::cout << "  --out <file>          Write JSON results to <file> instead of stdout\n";
+            std::cout << "  --list                List benchmark names and exit\n";
+            std::exit(0);
+        }
+    }
+    return options;
+}
+
+/// Concatenated search results used as input to the ranking benchmarks
+std::vector<Item> basketCandidates(Database& db) {
+    std::vector<Item> candidates;
+    for (const char* term : {"chips", "cookies", "milk", "eggs", "bread", "butter", "cheese", "coffee"}) {
+        auto results = db.searchItems(term);
+        candidates.insert(candidates.end(), results.begin(), results.end());
+    }
+    return candidates;
+}
+
+/// Queries from a budgeteer_datagen workload file ("kind<TAB>query" per line)
+std::vector<std::string> loadWorkload(const std::string& path) {
+    std::vector<std::string> queries;
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);   // Header
+    while (std::getline(in, line)) {
+        size_t tab = line.find('\t');
+        if (tab != std::string::npos && tab + 1 < line.size()) {
+            queries.push_back(line.substr(tab + 1));
+        }
+    }
+    return queries;
+}
+
+// ==================== Pipeline comparison ====================
+
+struct PipelineRun {
+    double milliseconds;
+    int gptCalls;
+    std::vector<Item> items;
+};
+
+/// Generate one shopping list under a request context so GPT round trips are counted
+PipelineRun runPipeline(LLMInterface& llm, const std::string& request, LLMInterface::Pipeline pipeline) {
+    RequestContext context(std::chrono::minutes(2));
+    RequestContext::Scope scope(context);
+    auto start = std::chrono::steady_clock::now();
+    auto items = llm.generateShoppingList(request, pipeline);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return {std::chrono::duration<double, std::milli>(elapsed).count(), context.getUpstreamCalls(), std::move(items)};
+}
+
+double basketCost(const std::vector<Item>& items) {
+    Money total;
+    for (const auto& item : items) total += item.getCurrentPrice();
+    return total.dollars();
+}
+
+/// Jaccard similarity of the product names on two lists
+double nameOverlap(const std::vector<Item>& a, const std::vector<Item>& b) {
+    std::set<std::string> namesA, namesB, both;
+    for (const auto& item : a) namesA.insert(item.getItemName());
+    for (const auto& item : b) namesB.insert(item.getItemName());
+    std::set_union(namesA.begin(), namesA.end(), namesB.begin(), namesB.end(), std::inserter(both, both.begin()));
+    if (both.empty()) return 1.0;
+    size_t shared = namesA.size() + namesB.size() - both.size();
+    return static_cast<double>(shared) / static_cast<double>(both.size());
+}
+
+/// Run both pipelines over fixed requests, repeating each and keeping the median time
+nlohmann::json comparePipelines(LLMInterface& llm, int repetitions) {
+    const std::vector<std::string> requests = {
+        "cake ingredients", "party snacks for ten people", "healthy breakfast for the week",
+        "pasta dinner for two", "weekly groceries under $50"
+    };
+
+    nlohmann::json rows = nlohmann::json::array();
+    for (const auto& request : requests) {
+        nlohmann::json row = {{"request", request}};
+        std::vector<Item> lists[2];
+        for (auto pipeline : {LLMInterface::Pipeline::SEQUENTIAL, LLMInterface::Pipeline::SINGLE_PASS}) {
+            std::vector<PipelineRun> runs;
+            for (int rep = 0; rep < repetitions; rep++) {
+                runs.push_back(runPipeline(llm, request, pipeline));
+            }
+            std::sort(runs.begin(), runs.end(), [](const PipelineRun& a, const PipelineRun& b) {
+                return a.milliseconds < b.milliseconds;
+            });
+            const PipelineRun& median = runs[runs.size() / 2];
+            row[LLMInterface::pipelineName(pipeline)] = {
+                {"ms", median.milliseconds},
+                {"gpt_calls", median.gptCalls},
+                {"items", median.items.size()},
+                {"basket_cost", basketCost(median.items)}
+            };
+            lists[pipeline == LLMInterface::Pipeline::SINGLE_PASS] = median.items;
+            std::cerr << "[Bench] pipeline/" << LLMInterface::pipelineName(pipeline) << " \"" << request << "\": "
+                      << static_cast<int>(median.milliseconds) << " ms, " << median.gptCalls << " GPT calls" << std::endl;
+        }
+        row["overlap"] = nameOverlap(lists[0], lists[1]);
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options = parseArgs(argc, argv);
+
+    // Silence component logging; results go to the saved stdout buffer
+    std::streambuf* stdoutBuf = std::cout.rdbuf();
+    std::ostringstream discarded;
+    std::cout.rdbuf(discarded.rdbuf());
+
+    auto database = std::make_shared<Database>(options.dataset);
+    if (!database->loadFromCSV()) {
+        std::cout.rdbuf(stdoutBuf);
+        std::cerr << "Failed to load dataset " << options.dataset << std::endl;
+        return 1;
+    }
+    const size_t rows = static_cast<size_t>(database->getItemCount());
+
+    auto storeClient = std::make_shared<StoreApiClient>(database);
+    LLMInterface llm(storeClient);
+    llm.enableGPTMode(false);
+    ApiServer server(options.dataset);
+
+    const auto searchResults = database->searchItems("eggs");
+    const auto allItems = database->getAllItems();
+    const auto candidates = basketCandidates(*database);
+    const int statsItemId = allItems.empty() ? 0 : allItems.front().getItemId();
+    const PriceMatrix catalogueMatrix = PriceMatrix::byItemName(allItems);
+    BasketOptimizer::Options twoStores;
+    twoStores.maxStores = 2;
+    twoStores.tripCosts.assign(catalogueMatrix.storeCount(), Money::fromCents(200));
+
+    // Every catalogue product once, and 256 varied baskets drawn from it
+    const PriceTable& priceTable = database->getPriceTable();
+    const auto catalogueBasket = priceTable.basketOf(allItems);
+    std::vector<std::vector<PriceTable::BasketLine>> whatIfBaskets(256);
+    for (size_t b = 0; b < whatIfBaskets.size(); b++) {
+        for (size_t row = b % 3; row < priceTable.productCount(); row += 1 + b % 4) {
+            whatIfBaskets[b].push_back({static_cast<int>(row), 1 + static_cast<int>(b % 2)});
+        }
+    }
+
+    const std::vector<std::string> workload = {
+        "milk", "Eggs (18 pack)", "chiken brest", "greek yogurt", "paper towels",
+        "coca cola", "samsung tv", "baby wipes", "coffee beans", "ground beef"
+    };
+
+    std::vector<Benchmark> benchmarks = {
+        // ---- Loading ----
+        {"load/csv", "macro", [&] {
+            Database db(options.dataset);
+            db.loadFromCSV();
+            return static_cast<size_t>(db.getItemCount());
+        }},
+
+        // ---- Search ----
+        {"search/exact", "micro", [&] { keep(database->searchItems("Eggs (18 pack)")); return size_t{1}; }},
+        {"search/prefix", "micro", [&] { keep(database->searchItems("eggs")); return size_t{1}; }},
+        {"search/typo", "micro", [&] { keep(database->searchItems("chiken brest")); return size_t{1}; }},
+        {"search/multi_word", "micro", [&] { keep(database->searchItems("greek yogurt cheese")); return size_t{1}; }},
+        {"search/request_arena", "micro", [&] {
+            // Same query inside a request, so temporaries come from its arena
+            RequestContext context(std::chrono::minutes(1));
+            RequestContext::Scope scope(context);
+            keep(database->searchItems("greek yogurt cheese"));
+            return size_t{1};
+        }},
+        {"search/workload", "macro", [&] {
+            for (const auto& q : workload) keep(database->searchItems(q));
+            return workload.size();
+        }},
+
+        // ---- Filters ----
+        {"filter/by_name", "micro", [&] { keep(database->getItemsByName("Milk")); return size_t{1}; }},
+        {"filter/by_store", "micro", [&] { keep(database->getItemsByStore("Walmart")); return size_t{1}; }},
+        {"filter/by_category", "micro", [&] { keep(database->getItemsByCategory("dairy")); return size_t{1}; }},
+        {"filter/by_categories_all", "micro", [&] {
+            keep(database->getItemsByCategories({"dairy", "breakfast"}, true));
+            return size_t{1};
+        }},
+        {"filter/by_price", "micro", [&] { keep(database->getItemsByPriceRange(Money::fromCents(500), Money::fromCents(2000))); return size_t{1}; }},
+        {"filter/by_id", "micro", [&] { keep(database->getItemById(statsItemId)); return size_t{1}; }},
+
+        // ---- Statistics ----
+        {"stats/item_prices", "micro", [&] {
+            Money total = database->getAveragePrice(statsItemId) + database->getMinPrice(statsItemId) +
+                          database->getMaxPrice(statsItemId);
+            sink.fetch_add(static_cast<size_t>(total.cents()), std::memory_order_relaxed);
+            return size_t{3};
+        }},
+        {"stats/stores", "micro", [&] { keep(database->getAllStores()); return size_t{1}; }},
+        {"stats/categories", "micro", [&] { keep(database->getAllCategories()); return size_t{1}; }},
+
+        // ---- Serialization ----
+        {"json/item_to_json", "micro", [&] {
+            for (const auto& item : searchResults) keep(item.toJson());
+            return searchResults.size();
+        }},
+        {"json/search_response", "micro", [&] {
+            keep(server.createJsonResponse(searchResults));
+            return searchResults.size();
+        }},
+        {"json/all_items_response", "macro", [&] {
+            keep(server.createJsonResponse(allItems));
+            return allItems.size();
+        }},
+
+        // ---- Ranking ----
+        {"rank/cheapest_mix", "micro", [&] { keep(llm.rankByCheapestMix(candidates)); return candidates.size(); }},
+        {"rank/single_store", "micro", [&] { keep(llm.rankBySingleStore(candidates)); return candidates.size(); }},
+
+        // ---- Basket optimisation (every catalogue product, latest prices) ----
+        {"basket/price_matrix", "macro", [&] {
+            sink.fetch_add(PriceMatrix::byItemName(allItems).productCount(), std::memory_order_relaxed);
+            return allItems.size();
+        }},
+        {"basket/optimize_k2", "micro", [&] {
+            keep(BasketOptimizer::optimize(catalogueMatrix, twoStores).stores);
+            return catalogueMatrix.productCount();
+        }},
+        {"basket/store_totals", "micro", [&] {
+            keep(priceTable.basketTotals(catalogueBasket).cost);
+            return catalogueBasket.size();
+        }},
+        {"basket/compare_many", "micro", [&] {
+            keep(priceTable.compareBaskets(whatIfBaskets));
+            return whatIfBaskets.size();
+        }},
+
+        // ---- Budget-constrained shopping lists ----
+        {"list/constraints_parse", "micro", [&] {
+            keep(ShoppingConstraints::parse("3 pizzas and 2 bags of chips under $40, not at Costco",
+                                            {"Walmart", "Loblaws", "Costco"}).quantities);
+            return size_t{1};
+        }},
+        {"list/local_budget", "macro", [&] {
+            keep(llm.generateShoppingListLocally("breakfast under $15 at Walmart"));
+            return size_t{1};
+        }},
+
+        // ---- Local query classification ----
+        {"local/classify", "micro", [&] {
+            for (const auto& q : workload) keep(llm.classifyQuery(q).categories);
+            return workload.size();
+        }},
+    };
+
+    // Generated workloads are replayed in order, one query per operation
+    const auto fileWorkload = options.workloadFile.empty() ? std::vector<std::string>{}
+                                                           : loadWorkload(options.workloadFile);
+    size_t nextQuery = 0;
+    if (!fileWorkload.empty()) {
+        benchmarks.push_back({"search/workload_file", "macro", [&] {
+            keep(database->searchItems(fileWorkload[nextQuery++ % fileWorkload.size()]));
+            return size_t{1};
+        }});
+    }
+
+    if (options.listOnly) {
+        std::cout.rdbuf(stdoutBuf);
+        for (const auto& bench : benchmarks) {
+            std::cout << bench.name << " (" << bench.category << ")\n";
+        }
+        return 0;
+    }
+
+    nlohmann::json results = nlohmann::json::array();
+    for (const auto& bench : benchmarks) {
+        if (!options.filter.empty() && bench.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        Result r = measure(bench, options);
+        discarded.str("");
+        std::cerr << "[Bench] " << r.name << ": " << static_cast<uint64_t>(r.nsPerOp) << " ns/op" << std::endl;
+
+        results.push_back({
+            {"name", r.name},
+            {"category", r.category},
+            {"iterations", r.iterations},
+            {"ns_per_op", r.nsPerOp},
+            {"allocs_per_op", r.allocsPerOp},
+            {"bytes_per_op", r.bytesPerOp},
+            {"ops_per_second", r.opsPerSecond}
+        });
+    }
+
+    // Pipeline comparison needs a chat completions endpoint
+    nlohmann::json pipelines = nlohmann::json::array();
+    const bool comparePipelinesRequested = !options.llmEndpoint.empty() &&
+        (options.filter.empty() || std::string("pipeline/").find(options.filter) != std::string::npos);
+    if (comparePipelinesRequested) {
+        LLMInterface plannerLlm(storeClient);
+        plannerLlm.setGPTEndpoint(options.llmEndpoint);
+        pipelines = comparePipelines(plannerLlm, std::min(options.repetitions, 3));
+        discarded.str("");
+    }
+
+    nlohmann::json report = {
+        {"context", {
+            {"dataset", options.dataset},
+            {"workload", options.workloadFile},
+            {"llm_endpoint", options.llmEndpoint},
+            {"rows", rows},
+            {"min_time_ms", options.minTimeMs},
+            {"repetitions", options.repetitions},
+            {"hardware_concurrency", std::thread::hardware_concurrency()},
+            {"timestamp", static_cast<int64_t>(std::time(nullptr))}
+        }},
+        {"benchmarks", results},
+        {"pipelines", pipelines}
+    };
+
+    std::cout.rdbuf(stdoutBuf);
+    if (options.outFile.empty()) {
+        std::cout << report.dump(2) << std::endl;
+    } else {
+        std::ofstream out(options.outFile);
+        out << report.dump(2) << std::endl;
+        std::cerr << "[Bench] Results written to " << options.outFile << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file AdaptiveRouter.h
+ * @brief Latency- and error-aware circuit breaker for the GPT upstream
+ *
+ * Tracks the outcome and latency of recent GPT calls over a rolling window.
+ * When too many of them fail or are slow the breaker opens and queries go
+ * straight to local processing instead of each waiting out its own timeout.
+ * After a cool-off the breaker lets a single probe call through, then doubles
+ * the number of concurrent probes after every success until enough have
+ * passed to close again. A failed probe reopens the breaker with a longer
+ * cool-off.
+ *
+ *   CLOSED --(failure/slow rate over threshold)--> OPEN
+ *   OPEN --(cool-off elapsed)--> HALF_OPEN
+ *   HALF_OPEN --(probe fails)--> OPEN (cool-off doubled)
+ *   HALF_OPEN --(closeAfterProbes successes)--> CLOSED
+ *
+ * The window also provides a typical GPT latency, which callers use to skip
+ * optional stages that the remaining request budget can no longer afford.
+ *
+ * Example usage:
+ *   auto permit = router.acquire();
+ *   if (permit == AdaptiveRouter::Permit::REJECTED) { ...use local path... }
+ *   ...call upstream...
+ *   router.record(permit, succeeded, latency);
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#ifndef ADAPTIVE_ROUTER_H
+#define ADAPTIVE_ROUTER_H
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <string>
+
+/**
+ * @class AdaptiveRouter
+ * @brief Rolling-window circuit breaker with a gradual half-open ramp
+ */
+class AdaptiveRouter {
+public:
+    enum class State {
+        CLOSED,      // Upstream healthy, all calls allowed
+        OPEN,        // Upstream degraded, calls short-circuited
+        HALF_OPEN    // Probing whether upstream recovered
+    };
+
+    enum class Permit {
+        ALLOWED,     // Normal call while closed
+        PROBE,       // Trial call while half-open
+        REJECTED     // Short-circuited; do not call upstream
+    };
+
+    struct Config {
+        size_t windowSize = 40;                         ///< Most recent calls considered
+        std::chrono::seconds windowAge{60};             ///< Older samples are discarded
+        size_t minSamples = 8;                          ///< Calls needed before the breaker may open
+        double failureRateThreshold = 0.5;              ///< Open when (failed + slow) / calls reaches this
+        std::chrono::milliseconds slowCallThreshold{8000};
+        std::chrono::milliseconds openCooloff{5000};    ///< First wait before probing
+        std::chrono::milliseconds maxCooloff{60000};
+        int closeAfterProbes = 4;                       ///< Successful probes needed to close
+        std::chrono::milliseconds defaultLatency{3000}; ///< Typical latency before any samples
+    };
+
+    AdaptiveRouter();
+    explicit AdaptiveRouter(const Config& config);
+
+    /// Ask to make one upstream call; PROBE permits must be passed back to record()
+    Permit acquire();
+
+    /**
+     * @brief Report how a permitted call went
+     * @param succeeded False for upstream errors and timeouts
+     */
+    void record(Permit permit, bool succeeded, std::chrono::steady_clock::duration latency);
+
+    /// Return a permit whose call never reached upstream (cancelled, quota, ...)
+    void abandon(Permit permit);
+
+    /// Whether a call would currently be let through (does not reserve a probe)
+    bool isAcceptingCalls();
+
+    /// 75th percentile latency of recent successful calls
+    std::chrono::milliseconds typicalLatency() const;
+
+    State getState() const;
+    static std::string stateName(State state);
+
+private:
+    struct Sample {
+        std::chrono::steady_clock::time_point at;
+        bool failed;                                    ///< Error, timeout or slow call
+        std::chrono::milliseconds latency;
+        bool succeeded;
+    };
+
+    Config config;
+    mutable std::mutex mutex;
+    std::deque<Sample> window;
+    State state;
+    std::chrono::steady_clock::time_point openedAt;
+    std::chrono::milliseconds cooloff;
+    int probesInFlight;
+    int probeLimit;                                     ///< Doubles after each successful probe
+    int probeSuccesses;
+
+    void prune(std::chrono::steady_clock::time_point now);
+    void transitionTo(State next, std::chrono::steady_clock::time_point now);
+    void maybeHalfOpen(std::chrono::steady_clock::time_point now);
+};
+
+#endif // ADAPTIVE_ROUTER_H
@@ -0,0 +1,141 @@
+/**
+ * @file AdmissionControl.h
+ * @brief Rate limiting and load shedding in front of the LLM endpoints
+ *
+ * Every LLM request asks the AdmissionController for a ticket before any
+ * work is queued. A request is turned away straight away when:
+ *   - its client has used up its token bucket           -> 429 Too Many Requests
+ *   - the global concurrency cap is reached             -> 503 Service Unavailable
+ *   - the estimated queue wait exceeds the latency budget -> 503 Service Unavailable
+ * Each rejection carries a Retry-After hint. Shedding early keeps admitted
+ * requests fast instead of letting every request time out.
+ *
+ * The queue-wait estimate is (requests ahead / worker threads) multiplied by
+ * an exponentially weighted moving average of recent service times. Service
+ * time runs from markStarted() to markFinished() (or release), so time spent
+ * queued is not counted twice.
+ *
+ * Example usage:
+ *   auto decision = admission.admit(clientId);
+ *   if (!decision.admitted) { reply decision.status with Retry-After; }
+ *   // when the work starts running: decision.ticket->markStarted();
+ *   // decision.ticket is released (and the service time recorded) when the work finishes
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#ifndef ADMISSION_CONTROL_H
+#define ADMISSION_CONTROL_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @class TokenBucketLimiter
+ * @brief Per-client token buckets, sharded to keep lock contention low
+ */
+class TokenBucketLimiter {
+private:
+    struct Bucket {
+        double tokens;
+        std::chrono::steady_clock::time_point lastRefill;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, Bucket> buckets;
+    };
+
+    static constexpr size_t kShardCount = 16;
+    static constexpr size_t kMaxBucketsPerShard = 4096;   ///< Idle full buckets are evicted beyond this
+
+    double ratePerSecond;
+    double burst;
+    std::array<Shard, kShardCount> shards;
+
+    Shard& shardFor(const std::string& clientId);
+
+public:
+    TokenBucketLimiter(double ratePerSecond, double burst);
+
+    /**
+     * @brief Take one token for clientId
+     * @param retryAfterSeconds Set to the time until a token is available when refused
+     * @return true if the request may proceed
+     */
+    bool tryAcquire(const std::string& clientId, double& retryAfterSeconds);
+};
+
+/**
+ * @class AdmissionController
+ * @brief Global concurrency cap, latency-budget shedding and per-client rate limits
+ */
+class AdmissionController {
+public:
+    struct Config {
+        double clientRatePerSecond = 1.0;   ///< Sustained requests per client
+        double clientBurst = 5.0;           ///< Requests a client may make back to back
+        int maxConcurrent = 24;             ///< Admitted requests in flight (running + queued)
+        int workerThreads = 8;              ///< Threads serving admitted requests
+        int latencyBudgetMs = 12000;        ///< Shed when the estimated queue wait exceeds this
+    };
+
+    /// Held while an admitted request is in flight; releasing it records the service time
+    class Ticket {
+    private:
+        AdmissionController* controller;
+        std::optional<std::chrono::steady_clock::time_point> startedAt;
+        std::optional<std::chrono::steady_clock::time_point> finishedAt;
+
+    public:
+        explicit Ticket(AdmissionController* controller);
+        ~Ticket();
+
+        /// Call when the request starts running; a ticket released without it records no sample
+        void markStarted() { startedAt = std::chrono::steady_clock::now(); }
+
+        /// Call when the work is done, if the ticket is held longer (e.g. while a stream drains)
+        void markFinished() { finishedAt = std::chrono::steady_clock::now(); }
+
+        Ticket(const Ticket&) = delete;
+        Ticket& operator=(const Ticket&) = delete;
+    };
+
+    struct Decision {
+        bool admitted;
+        int status;                         ///< 429 or 503 when rejected
+        int retryAfterSeconds;
+        std::string reason;                 ///< "rate_limited", "concurrency" or "latency_budget"
+        std::shared_ptr<Ticket> ticket;     ///< Set when admitted
+    };
+
+    explicit AdmissionController(const Config& config);
+
+    Decision admit(const std::string& clientId);
+
+    int getInFlight() const { return inFlight.load(); }
+    double getServiceTimeEstimateMs() const { return serviceTimeMs.load(); }
+
+    /// Estimated wait before a newly admitted request would start running
+    double estimatedQueueWaitMs() const;
+
+private:
+    Config config;
+    TokenBucketLimiter limiter;
+    std::atomic<int> inFlight;
+    std::atomic<double> serviceTimeMs;      ///< EWMA of admitted request run times (excluding queue wait)
+
+    void release(std::optional<std::chrono::steady_clock::duration> serviceTime);
+    Decision reject(int status, double retryAfterSeconds, const std::string& reason);
+};
+
+#endif // ADMISSION_CONTROL_H
@@ -4,6 +4,8 @@
 #include "Database.h"
 #include "StoreApiClient.h"
 #include "LLMInterface.h"
+#include "Executor.h"
+#include "AdmissionControl.h"
 #include <string>
 #include <memory>
 #include <map>
@@ -17,16 +19,18 @@ private:
     std::unique_ptr<Database> database;
     std::shared_ptr<StoreApiClient> storeClient;
     std::unique_ptr<LLMInterface> llmInterface;
+    std::unique_ptr<Executor> llmExecutor;   // Runs LLM requests off the HTTP workers
+    std::unique_ptr<AdmissionController> admission;   // Rate limits and sheds LLM requests
     int port;
     bool useRealTimeApis;
+    int llmDeadlineMs;                       // End-to-end budget for one LLM request
     
-    // Response helpers
-    std::string createJsonResponse(const std::vector<Item>& items) const;
-    std::string createErrorResponse(const std::string& message) const;
-    std::string createStatsResponse(int itemId) const;
-    std::string createStoresResponse() const;
-    std::string createCategoriesResponse() const;
-    std::string createShoppingListResponse(const std::vector<Item>& items) const;
+    // Worker sizing per route class (see configureWorkers)
+    int catalogueThreads;
+    int llmThreads;
+    int llmQueueCapacity;
+    AdmissionController::Config admissionConfig;   // maxConcurrent 0 = llm threads + queue
+    std::vector<std::string> trustedProxies;       // Peers whose X-Forwarded-For is believed
     
     // Request handlers - Database
     std::string handleGetAllItems() const;
@@ -34,7 +38,8 @@ private:
     std::string handleGetItemsByName(const std::string& name) const;
     std::string handleGetItemsByStore(const std::string& store) const;
     std::string handleGetItemsByCategory(const std::string& category) const;
-    std::string handleGetItemsByPriceRange(double minPrice, double maxPrice) const;
+    std::string handleGetItemsByCategories(const std::vector<std::string>& categories, bool matchAll) const;
+    std::string handleGetItemsByPriceRange(Money minPrice, Money maxPrice) const;
     std::string handleSearchItems(const std::string& searchTerm) const;
     std::string handleGetStats(int itemId) const;
     std::string handleGetStores() const;
@@ -44,9 +49,15 @@ private:
     std::string handleSearchRealTime(const std::string& query);
     std::string handleComparePrices(const std::string& productName);
     
+    // Request handlers - Basket optimisation
+    std::string handleOptimizeBasket(const std::vector<std::string>& products, int maxStores,
+                                     const std::map<std::string, Money>& tripCosts) const;
+    std::string handleCompareBaskets(const std::vector<std::string>& names,
+                                     const std::vector<std::vector<std::pair<std::string, int>>>& baskets) const;
+    
     // Request handlers - LLM Interface
-    std::string handleNaturalLanguageQuery(const std::string& query);
-    std::string handleGenerateShoppingList(const std::string& request);
+    std::string handleNaturalLanguageQuery(const std::string& query, LLMInterface::Pipeline pipeline);
+    std::string handleGenerateShoppingList(const std::string& request, LLMInterface::Pipeline pipeline);
     std::string handleBudgetInsight(const std::vector<Item>& items);
     
 public:
@@ -60,13 +71,33 @@ public:
     void run();
     void startHttpServer(); // HTTP server mode
     
+    // Response helpers (public so the benchmark suite can measure serialization)
+    std::string createJsonResponse(const std::vector<Item>& items) const;
+    std::string createErrorResponse(const std::string& message) const;
+    std::string createStatsResponse(int itemId) const;
+    std::string createStoresResponse() const;
+    std::string createCategoriesResponse() const;
+    std::string createShoppingListResponse(const std::vector<Item>& items) const;
+    
     // Configuration
     void setUseRealTimeApis(bool use);
     void setStoreApiKey(const std::string& key);
+    void setLLMEndpoint(const std::string& baseUrl);
+    void setLLMDeadline(int milliseconds);
+    bool setLLMPipeline(const std::string& name);
+    bool setSearchParameters(const std::string& spec);
+    bool setIntentModel(const std::string& path);
+    void configureWorkers(int catalogueWorkers, int llmWorkers, int llmQueue);
+    void configureAdmission(double clientRatePerSecond, double clientBurst, int maxConcurrent, int latencyBudgetMs);
+    void setTrustedProxies(const std::vector<std::string>& addresses);
     
     // Getters
     int getPort() const;
     bool isUsingRealTimeApis() const;
+    int getLLMDeadline() const;
+    int getCatalogueThreads() const;
+    int getLLMThreads() const;
+    int getLLMQueueCapacity() const;
 };
 
 #endif // APISERVER_H
@@ -0,0 +1,122 @@
+/**
+ * @file BasketOptimizer.h
+ * @brief Exact multi-store basket optimisation over a latest-price matrix
+ *
+ * A PriceMatrix holds, for every requested product and every store, the
+ * latest observed price of the cheapest catalogue row that satisfies the
+ * product at that store (or nothing when the store does not carry it).
+ * Historical price rows never count twice: only the newest price_date of
+ * each item name at each store is used.
+ *
+ * BasketOptimizer picks the set of at most k stores that covers the most
+ * products at the lowest total cost, where the total is the cheapest price
+ * of each product among the chosen stores plus an optional trip cost per
+ * store visited. The search is a depth-first enumeration of store subsets
+ * with branch-and-bound: stores are tried cheapest first, and a branch is cut
+ * when even adding every remaining store could not beat the best plan found
+ * so far. The bound uses suffix minima of the price matrix, so each search
+ * node costs one pass over the products. The result is exact unless the
+ * node budget runs out, which only happens for very wide store sets.
+ *
+ * Example usage:
+ *   PriceMatrix matrix;
+ *   matrix.addProduct("milk", database->searchItems("milk"));
+ *   matrix.addProduct("eggs", database->searchItems("eggs"));
+ *   BasketOptimizer::Options options;
+ *   options.maxStores = 2;
+ *   BasketPlan plan = BasketOptimizer::optimize(matrix, options);
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#ifndef BASKET_OPTIMIZER_H
+#define BASKET_OPTIMIZER_H
+
+#include "Item.h"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class PriceMatrix
+ * @brief Product x store table of latest prices
+ */
+class PriceMatrix {
+public:
+    /**
+     * @brief Add a product row
+     * @param label Name reported for the product
+     * @param candidates Every catalogue row that satisfies the product (any store, any date)
+     * @return Row index of the product
+     */
+    size_t addProduct(const std::string& label, const std::vector<Item>& candidates);
+
+    /// One row per distinct item name in items
+    static PriceMatrix byItemName(const std::vector<Item>& items);
+
+    size_t productCount() const { return products.size(); }
+    size_t storeCount() const { return stores.size(); }
+    const std::string& productLabel(size_t product) const { return products[product].label; }
+    const std::string& storeName(size_t store) const { return stores[store]; }
+
+    /// Index of a store, or -1 when no product row has seen it
+    int storeIndex(const std::string& name) const;
+
+    bool carries(size_t product, size_t store) const;
+
+    /// Latest price of the product at the store; only valid when carries() is true
+    Money price(size_t product, size_t store) const;
+
+    /// The catalogue row behind price(); only valid when carries() is true
+    const Item& item(size_t product, size_t store) const;
+
+private:
+    struct Product {
+        std::string label;
+        std::vector<int> cells;     ///< Per store: index into items, -1 when not carried
+    };
+
+    std::vector<Product> products;
+    std::vector<std::string> stores;
+    std::unordered_map<std::string, size_t> storeIndexes;
+    std::vector<Item> items;        ///< Latest row chosen for each carried cell
+};
+
+/**
+ * @struct BasketPlan
+ * @brief Where to buy each product
+ */
+struct BasketPlan {
+    std::vector<size_t> stores;     ///< Stores visited, as matrix store indices
+    std::vector<int> storeOf;       ///< Per product: store to buy it at, or -1 when none of the stores has it
+    Money itemCost;
+    Money tripCost;
+    size_t missing = 0;             ///< Products no visited store carries
+    bool exact = true;              ///< False when the search stopped at its node budget
+
+    Money totalCost() const { return itemCost + tripCost; }
+};
+
+/**
+ * @class BasketOptimizer
+ * @brief Branch-and-bound search for the cheapest store set
+ */
+class BasketOptimizer {
+public:
+    struct Options {
+        int maxStores = 0;                  ///< Stores the shopper will visit (0 = no limit)
+        std::vector<Money> tripCosts;       ///< Per matrix store index; missing entries cost nothing
+        size_t nodeBudget = 250000;         ///< Search nodes before settling for the best plan so far
+    };
+
+    /// Best plan: fewest missing products first, then lowest total cost
+    static BasketPlan optimize(const PriceMatrix& matrix, const Options& options);
+
+    /// Every store on its own, best first
+    static std::vector<BasketPlan> singleStorePlans(const PriceMatrix& matrix, const Options& options);
+};
+
+#endif // BASKET_OPTIMIZER_H
@@ -0,0 +1,86 @@
+/**
+ * @file BudgetSolver.h
+ * @brief Shopping-request constraint parsing and budget-constrained item selection
+ *
+ * ShoppingConstraints pulls the hard constraints out of a request such as
+ * "party snacks under $40 at Walmart" or "3 pizzas and 2 bags of chips, not
+ * Costco": a budget, item quantities, and stores to use or avoid. Parsing is a
+ * single pass over the words of the request, with no GPT call.
+ *
+ * BudgetSolver then picks at most one product for each group (one group per
+ * needed product, e.g. one search term) so that the list never costs more than
+ * the budget. Among the lists that fit it prefers, in order: more groups
+ * covered, lower cost, better search matches. This is a multiple-choice
+ * knapsack, solved exactly by dynamic programming over the budget in whole
+ * cents. Prices are rounded up when the budget is too large for one cell per
+ * cent, so the result stays within budget.
+ *
+ * Example usage:
+ *   auto constraints = ShoppingConstraints::parse("snacks under $40", {"Walmart", "Costco"});
+ *   std::vector<BudgetSolver::Group> groups = { {"chips", searchResults, 1}, ... };
+ *   auto selection = BudgetSolver::solve(groups, *constraints.budget);
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#ifndef BUDGET_SOLVER_H
+#define BUDGET_SOLVER_H
+
+#include "Item.h"
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @struct ShoppingConstraints
+ * @brief Budget, quantities and store preferences stated in a request
+ */
+struct ShoppingConstraints {
+    std::optional<Money> budget;                          ///< Unset when no budget was given
+    std::vector<std::pair<std::string, int>> quantities;  ///< Lowercased singular product word -> packs wanted ("12 eggs" is one pack)
+    std::vector<std::string> stores;                      ///< Only shop at these (empty = any store)
+    std::vector<std::string> excludedStores;
+    std::string remainder;                                ///< Request without budget and store phrases
+
+    /**
+     * @brief Parse a free-text request
+     * @param knownStores Store names to look for (matched case-insensitively)
+     */
+    static ShoppingConstraints parse(const std::string& request, const std::vector<std::string>& knownStores);
+
+    /// Count requested for a product or search term (1 when none was stated)
+    int quantityFor(const std::string& term) const;
+
+    bool allowsStore(const std::string& store) const;
+};
+
+/**
+ * @class BudgetSolver
+ * @brief Exact multiple-choice knapsack over integer cents
+ */
+class BudgetSolver {
+public:
+    struct Group {
+        std::string label;
+        std::vector<Item> options;      ///< Best search match first
+        int quantity = 1;
+    };
+
+    struct Selection {
+        std::vector<int> choice;        ///< Per group: index into options, or -1 when left out
+        size_t covered = 0;
+        Money totalCost;                ///< Including quantities
+    };
+
+    /// Most groups covered within budget, then cheapest, then best-ranked options
+    static Selection solve(const std::vector<Group>& groups, Money budget);
+
+    /// Budget cells used by the DP; larger budgets are solved in coarser units
+    static constexpr size_t kMaxCells = 20000;
+};
+
+#endif // BUDGET_SOLVER_H
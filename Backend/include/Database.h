@@ -2,26 +2,86 @@
 #define DATABASE_H
 
 #include "Item.h"
+#include "PriceTable.h"
+#include "SearchIndex.h"
+#include "StringDictionary.h"
+#include <atomic>
+#include <bitset>
+#include <cstdint>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <memory>
+#include <memory_resource>
 #include <unordered_map>
 
+class ScanPool;
+
 /**
  * @class Database
  * @brief Handles database operations and CSV file parsing
  */
 class Database {
+public:
+    static constexpr size_t kMaxCategories = 256;   ///< Category tags with a filter bit; later ones are compared by id
+    
 private:
-    std::vector<Item> items;
+    using CategorySet = std::bitset<kMaxCategories>;
+    
+    /**
+     * The CSV repeats a product's name, description, tags and image URL on
+     * every (store, date) row. They are kept once per product here, and each
+     * row becomes a 16-byte Observation. Store and category names are interned
+     * into dense ids; a product's categories are also a bitset, so category
+     * filters (and their AND/OR combinations) are bit operations. Only the
+     * first kMaxCategories tags get a bit; filters on later tags search the
+     * product's tag ids instead. Items are only materialized for query results.
+     */
+    struct Product {
+        int itemId = 0;
+        std::string name;
+        std::string description;
+        std::string imageUrl;
+        std::vector<uint16_t> tags;         ///< Category ids, in file order
+        CategorySet tagSet;                 ///< Same ids as bits (those below kMaxCategories), for filters
+        uint32_t firstObservation = 0;      ///< A product's observations are contiguous, in file order
+        uint32_t observationCount = 0;
+    };
+    
+    struct Observation {
+        uint32_t product;                   ///< Index into products
+        int32_t day;                        ///< Days since 1970-01-01
+        int32_t cents;
+        uint16_t store;                     ///< Id in storeDictionary
+    };
+    
+    std::vector<Product> products;
+    std::vector<Observation> observations;
+    StringDictionary storeDictionary;
+    StringDictionary categoryDictionary;
+    std::vector<std::string> sortedStores;       // Rebuilt on load for getAllStores()
+    std::vector<std::string> sortedCategories;
+    std::unordered_map<int, std::vector<uint32_t>> productsByItemId;   // Usually one product per id
     std::string csvFilePath;
+    PriceTable priceTable;   // Latest price per product and store, rebuilt on load
+    SearchIndex searchIndex;   // BM25F over folded names and descriptions, rebuilt on load
+    ScanPool* scanPool = nullptr;                      // nullptr: ScanPool::shared()
+    mutable std::atomic<size_t> searchesInFlight{0};   // Busy periods keep each search on one thread
+    
+    Item itemAt(const Observation& observation) const;
+    void appendObservations(const Product& product, std::vector<Item>& result) const;
+    std::vector<int32_t> pricesOf(int itemId) const;   ///< Cents of every observation of an item ID
+    std::vector<Item> itemsWithCategories(const CategorySet& mask, const std::vector<uint16_t>& unmasked,
+                                          bool matchAll) const;
+    double scoreProduct(uint32_t index, std::string_view query,
+                        const std::pmr::vector<std::string_view>& searchWords) const;
+    std::pmr::vector<SearchIndex::Hit> scanProducts(std::string_view query, std::pmr::memory_resource* memory) const;
     
     // Helper methods
     std::vector<std::string> splitString(const std::string& str, char delimiter) const;
     std::vector<std::string> parseCategories(const std::string& categoriesStr);
-    int calculateLevenshteinDistance(const std::string& s1, const std::string& s2) const;
-    double calculateSimilarity(const std::string& s1, const std::string& s2) const;
-    bool containsWord(const std::string& text, const std::string& word) const;
+    int calculateLevenshteinDistance(std::string_view s1, std::string_view s2) const;
+    double calculateSimilarity(std::string_view s1, std::string_view s2) const;
     
 public:
     // Constructor
@@ -35,17 +95,29 @@ public:
     std::vector<Item> getAllItems() const;
     std::vector<Item> getItemById(int itemId) const;
     std::vector<Item> getItemsByName(const std::string& name) const;
+    std::vector<Item> getItemsByExactName(const std::string& name) const;   ///< Whole name, compared folded (case and accents ignored)
     std::vector<Item> getItemsByStore(const std::string& store) const;
     std::vector<Item> getItemsByCategory(const std::string& category) const;
-    std::vector<Item> getItemsByPriceRange(double minPrice, double maxPrice) const;
+    std::vector<Item> getItemsByCategories(const std::vector<std::string>& categories, bool matchAll) const;
+    std::vector<Item> getItemsByPriceRange(Money minPrice, Money maxPrice) const;
     std::vector<Item> searchItems(const std::string& searchTerm) const;
     
     // Statistics methods
-    double getAveragePrice(int itemId) const;
-    double getMinPrice(int itemId) const;
-    double getMaxPrice(int itemId) const;
+    Money getAveragePrice(int itemId) const;
+    Money getMinPrice(int itemId) const;
+    Money getMaxPrice(int itemId) const;
     std::vector<std::string> getAllStores() const;
     std::vector<std::string> getAllCategories() const;
+    
+    // Whole-basket pricing
+    const PriceTable& getPriceTable() const;
+    
+    /// Threads used to scan large catalogues in parallel (default: ScanPool::shared())
+    void setScanPool(ScanPool& pool) { scanPool = &pool; }
+    
+    /// Ranking parameters of searchItems; set before serving searches (kept across reloads)
+    void setSearchParameters(const SearchIndex::Parameters& parameters);
+    const SearchIndex::Parameters& getSearchParameters() const;
 };
 
 #endif // DATABASE_H
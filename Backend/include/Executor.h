@@ -0,0 +1,118 @@
+/**
+ * @file Executor.h
+ * @brief Fixed-size thread pool for running request work off the HTTP workers
+ *
+ * LLM requests spend most of their time waiting on upstream round trips.
+ * Running them on a dedicated executor keeps that waiting off the httplib
+ * worker threads, which only block for as long as the request's deadline
+ * allows (see RequestContext).
+ *
+ * The queue can be bounded: trySubmit() refuses work once maxQueue tasks are
+ * waiting, so callers can shed load instead of piling up blocked requests.
+ * Each executor exports its queue depth, busy threads, queue wait and
+ * rejections as metrics labelled with its name.
+ *
+ * Example usage:
+ *   Executor executor("llm", 8, 16);
+ *   auto result = executor.trySubmit([] { return runPipeline(); });
+ *   if (!result) { ...queue full, reject... }
+ *   if (result->wait_for(std::chrono::seconds(5)) == std::future_status::ready) { ... }
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include "Metrics.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @class Executor
+ * @brief Thread pool with a FIFO task queue and future-returning submit()
+ */
+class Executor {
+private:
+    struct QueuedTask {
+        std::function<void()> run;
+        std::chrono::steady_clock::time_point enqueuedAt;
+    };
+
+    std::string name;
+    size_t maxQueue;                       ///< kUnbounded = no limit
+    std::vector<std::thread> workers;
+    std::queue<QueuedTask> tasks;
+    size_t busyThreads;
+    mutable std::mutex mutex;
+    std::condition_variable available;
+    bool stopping;
+
+    // Metric series for this executor
+    Gauge& queueDepthGauge;
+    Gauge& busyThreadsGauge;
+    Histogram& queueWait;
+    Counter& rejected;
+
+    bool enqueue(std::function<void()> task, bool bounded);
+    void workerLoop();
+
+public:
+    static constexpr size_t kUnbounded = SIZE_MAX;
+
+    Executor(std::string name, size_t threadCount, size_t maxQueue = kUnbounded);
+    ~Executor();   // Runs the tasks already queued, then joins the workers
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    /**
+     * @brief Queue a callable and return a future for its result
+     *
+     * Exceptions thrown by the callable are delivered through the future.
+     */
+    template <typename F>
+    std::future<std::invoke_result_t<std::decay_t<F>>> submit(F&& work) {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(work));
+        std::future<Result> future = task->get_future();
+        enqueue([task]() { (*task)(); }, false);
+        return future;
+    }
+
+    /**
+     * @brief Like submit(), but returns std::nullopt when the queue is full
+     */
+    template <typename F>
+    std::optional<std::future<std::invoke_result_t<std::decay_t<F>>>> trySubmit(F&& work) {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(work));
+        std::future<Result> future = task->get_future();
+        if (!enqueue([task]() { (*task)(); }, true)) {
+            return std::nullopt;
+        }
+        return future;
+    }
+
+    size_t getThreadCount() const { return workers.size(); }
+    size_t getMaxQueue() const { return maxQueue; }
+    size_t getQueueDepth() const;
+    size_t getBusyThreads() const;
+    const std::string& getName() const { return name; }
+};
+
+#endif // EXECUTOR_H
@@ -0,0 +1,98 @@
+/**
+ * @file IntentClassifier.h
+ * @brief Hashed n-gram logistic regression for local/GPT routing and mode choice
+ *
+ * Predicts, from the query text alone, whether a natural-language query can
+ * be answered by local processing and which processing mode suits it. The
+ * features are word unigrams and bigrams (catalogue tokens such as "milk" or
+ * "2l"), character trigrams of each word (so "chiken" still looks like
+ * "chicken"), a word-count bucket and a digit flag. Each is hashed into a
+ * fixed number of buckets, so the model needs no vocabulary and prediction
+ * costs a few hash computations and one weight lookup per feature.
+ *
+ * Two heads share the features: a binary logistic regression giving the
+ * probability that local processing suffices, and a softmax over the mode
+ * labels seen in training. Both are trained offline with SGD by
+ * budgeteer_train_intent and saved as a small sparse text file.
+ *
+ * Example usage:
+ *   IntentClassifier model;
+ *   if (model.load("intent.model")) {
+ *       auto prediction = model.predict("cheapest eggs");
+ *       bool local = prediction.localProbability >= 0.5;
+ *   }
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#ifndef INTENT_CLASSIFIER_H
+#define INTENT_CLASSIFIER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class IntentClassifier
+ * @brief Route and mode classifier over hashed query features
+ */
+class IntentClassifier {
+public:
+    static constexpr size_t kDefaultBuckets = 1 << 14;
+
+    /// One labelled query; mode is an index into the mode labels, or -1 when unknown
+    struct Example {
+        std::string query;
+        bool local;
+        int mode;
+    };
+
+    struct TrainingOptions {
+        int epochs = 12;
+        double learningRate = 0.2;
+        double l2 = 1e-5;
+        uint64_t seed = 42;
+    };
+
+    struct Prediction {
+        double localProbability = 0.5;
+        int mode = -1;                    ///< Index into getModeLabels(), -1 without a mode head
+        double modeProbability = 0.0;
+    };
+
+    explicit IntentClassifier(size_t buckets = kDefaultBuckets);
+
+    /**
+     * @brief Fit both heads from scratch
+     * @param modeLabels Names of the mode classes that Example::mode indexes
+     */
+    void train(const std::vector<Example>& examples, const std::vector<std::string>& modeLabels,
+               const TrainingOptions& options);
+
+    Prediction predict(const std::string& query) const;
+
+    /// Load a model written by save(); returns false (leaving the model untrained) on any error
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+
+    bool isTrained() const { return trained; }
+    const std::vector<std::string>& getModeLabels() const { return modeLabels; }
+
+    /// Hashed feature buckets of a query (duplicates kept; they count twice)
+    static void extractFeatures(const std::string& query, size_t buckets, std::vector<uint32_t>& features);
+
+private:
+    size_t buckets;
+    bool trained;
+    std::vector<std::string> modeLabels;
+    std::vector<float> routeWeights;      ///< buckets weights for the local-vs-GPT logit
+    std::vector<float> modeWeights;       ///< modeLabels.size() * buckets, one row per mode
+
+    double routeLogit(const std::vector<uint32_t>& features) const;
+    void modeProbabilities(const std::vector<uint32_t>& features, std::vector<double>& probabilities) const;
+};
+
+#endif // INTENT_CLASSIFIER_H
@@ -14,6 +14,7 @@
 #ifndef ITEM_H
 #define ITEM_H
 
+#include "Money.h"
 #include <string>
 #include <vector>
 
@@ -37,7 +38,7 @@ private:
     int itemId;                             ///< Unique product identifier (shared across stores/dates)
     std::string itemName;                   ///< Product name (e.g., "2% Milk (2L)")
     std::string itemDescription;            ///< Detailed product description
-    double currentPrice;                    ///< Current price in dollars
+    Money currentPrice;                     ///< Current price (exact cents)
     std::string store;                      ///< Store name (Walmart, Loblaws, Costco)
     std::vector<std::string> categoryTags;  ///< Product categories (e.g., ["dairy", "beverages"])
     std::string imageUrl;                   ///< URL to product image
@@ -63,14 +64,14 @@ public:
      * @param date Price date
      */
     Item(int id, const std::string& name, const std::string& description,
-         double price, const std::string& store, const std::vector<std::string>& tags,
+         Money price, const std::string& store, const std::vector<std::string>& tags,
          const std::string& imgUrl, const std::string& date);
 
     // Getters
     int getItemId() const;
     std::string getItemName() const;
     std::string getItemDescription() const;
-    double getCurrentPrice() const;
+    Money getCurrentPrice() const;
     std::string getStore() const;
     std::vector<std::string> getCategoryTags() const;
     std::string getImageUrl() const;
@@ -80,7 +81,7 @@ public:
     void setItemId(int id);
     void setItemName(const std::string& name);
     void setItemDescription(const std::string& description);
-    void setCurrentPrice(double price);
+    void setCurrentPrice(Money price);
     void setStore(const std::string& store);
     void setCategoryTags(const std::vector<std::string>& tags);
     void setImageUrl(const std::string& imgUrl);
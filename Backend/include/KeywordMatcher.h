@@ -0,0 +1,79 @@
+/**
+ * @file KeywordMatcher.h
+ * @brief Single-pass multi-keyword matcher (Aho-Corasick automaton)
+ *
+ * Local query classification checks a query against several keyword tables
+ * (intent words, brand and size indicators, shopping scenarios, category
+ * names). Instead of one find() per keyword, all keywords are compiled into
+ * one automaton and the query is scanned once, byte by byte, reporting every
+ * keyword it contains.
+ *
+ * Matching is case-insensitive (ASCII) and by substring, like the find()
+ * calls it replaces. The automaton is a full transition table over the
+ * characters that occur in keywords, so each input byte costs one lookup.
+ *
+ * Each keyword carries a caller-defined group and value. Matches are reported
+ * in insertion order, so callers that add their highest-precedence keywords
+ * first can take the first match of a group.
+ *
+ * Example usage:
+ *   KeywordMatcher matcher;
+ *   matcher.add("compare", INTENT, COMPARE);
+ *   matcher.add("cake", SCENARIO, 5);
+ *   matcher.build();
+ *   for (int id : matcher.scan("Compare cake prices")) { ...matcher.keyword(id).group... }
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#ifndef KEYWORD_MATCHER_H
+#define KEYWORD_MATCHER_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class KeywordMatcher
+ * @brief Compiles keywords once, then finds all of them in a text in one pass
+ */
+class KeywordMatcher {
+public:
+    struct Keyword {
+        std::string text;    ///< Lowercased
+        int group;
+        int value;
+    };
+
+    KeywordMatcher();
+
+    /**
+     * @brief Register a keyword; takes effect at the next build()
+     * @return The keyword's ID (insertion order)
+     */
+    int add(const std::string& text, int group, int value = 0);
+
+    /// Drop all keywords and the compiled automaton
+    void clear();
+
+    /// Compile the automaton over the keywords added so far
+    void build();
+
+    /// IDs of the keywords found in text, ascending and without duplicates
+    std::vector<int> scan(const std::string& text) const;
+
+    const Keyword& keyword(int id) const { return keywords[id]; }
+    size_t size() const { return keywords.size(); }
+
+private:
+    std::vector<Keyword> keywords;
+    std::array<uint8_t, 256> symbolOf;      ///< Lowercased byte -> alphabet index (0 = not in any keyword)
+    size_t alphabetSize;
+    std::vector<int32_t> transitions;       ///< state * alphabetSize + symbol -> next state
+    std::vector<std::vector<int>> outputs;  ///< Keywords ending at each state, including via suffix links
+};
+
+#endif // KEYWORD_MATCHER_H
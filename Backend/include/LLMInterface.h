@@ -3,10 +3,17 @@
 
 #include "Item.h"
 #include "StoreApiClient.h"
+#include "SingleFlight.h"
+#include "AdaptiveRouter.h"
+#include "KeywordMatcher.h"
+#include "IntentClassifier.h"
+#include "BudgetSolver.h"
+#include <atomic>
 #include <string>
 #include <vector>
 #include <memory>
 #include <map>
+#include <optional>
 
 /**
  * @class LLMInterface
@@ -19,17 +26,33 @@ private:
     
     // GPT API configuration
     std::string openaiApiKey;
+    std::string gptEndpoint;   // Base URL, e.g. https://models.github.ai/inference
     bool useGPT;
     std::string gptModel;
     int maxTokens;
     double temperature;
     
-    // Usage tracking
-    int dailyQueryCount;
-    int dailyQueryLimit;
+    // Usage tracking (updated concurrently by LLM executor threads)
+    std::atomic<int> dailyQueryCount;
+    std::atomic<int> dailyQueryLimit;
+    std::atomic<long long> quotaDay;   // Days since epoch the count belongs to
     
     // Category expansion mappings
     std::map<std::string, std::vector<std::string>> categoryExpansions;
+    
+    // Intent, indicator, scenario and category keywords compiled into one automaton
+    KeywordMatcher queryKeywords;
+    void rebuildQueryKeywords();
+    
+    // Learned local-vs-GPT router and mode picker; the keyword rules apply without one
+    std::shared_ptr<const IntentClassifier> intentModel;
+    
+    // Circuit breaker over recent GPT latency and errors
+    AdaptiveRouter gptRouter;
+    
+    // Concurrent identical requests share one computation
+    SingleFlight<std::string> queryFlights;
+    SingleFlight<std::vector<Item>> listFlights;
 
 public:
     // Query processing modes (declared early for use in private methods)
@@ -38,12 +61,24 @@ public:
         SINGLE_STORE,      // Minimize total cost at one store
         BUDGET_INSIGHT     // Provide budget analysis
     };
+    
+    // How GPT-backed requests are planned
+    enum class Pipeline {
+        SEQUENTIAL,        // Term extraction, cherry-pick, reasoning and validation calls in turn
+        SINGLE_PASS        // Local pre-search, then one structured planning call
+    };
 
 private:
+    Pipeline defaultPipeline;   // Used when a request does not choose one
+    
     // GPT API methods
-    std::string callGPTAPI(const std::string& prompt);
+    // streamStage names the stage whose tokens are forwarded to a streaming request
+    std::string callGPTAPI(const std::string& prompt, const char* streamStage = nullptr);
     std::string buildPrompt(const std::string& query, const std::string& context);
     bool canMakeGPTRequest();
+    bool tryReserveGPTQuery();
+    void releaseGPTQuery();
+    bool canAffordGPTStage(const char* stage, int gptCalls);
     std::vector<Item> cherryPickRelevantItems(const std::string& query, const std::vector<Item>& items);
     
     // Reasoning methods
@@ -63,6 +98,7 @@ private:
     bool isSpecificQuery(const std::string& query);
     bool isGenericQuery(const std::string& query);
     bool isSimpleQuery(const std::string& query);
+    bool prefersLocalProcessing(const std::string& query, const char*& decidedBy);
     
     // Query processing
     std::vector<std::string> expandCategory(const std::string& category);
@@ -70,18 +106,21 @@ private:
     
     // Processing methods
     std::string processQueryWithGPT(const std::string& query, Mode mode);
+    std::string processQueryWithPlan(const std::string& query, Mode mode);
     std::string processQueryLocally(const std::string& query, Mode mode);
     
-    // Result ranking
-    struct RankedResult {
-        std::vector<Item> items;
-        double totalCost;
-        std::string store;
-        double score;
-    };
+    // Single-pass planning
+    std::vector<std::string> planningSearchTerms(const std::string& request);
+    std::optional<std::vector<Item>> planShoppingList(const std::string& request);
     
-    std::vector<RankedResult> rankByCheapestMix(const std::vector<Item>& items);
-    std::vector<RankedResult> rankBySingleStore(const std::vector<Item>& items);
+    // Budget, quantity and store constraints applied to per-product search results.
+    // Applies with or without a budget: excluded stores are dropped, each product
+    // is priced at its latest row per store, and quantities add copies.
+    std::vector<Item> assembleShoppingList(const ShoppingConstraints& constraints, std::vector<BudgetSolver::Group> groups);
+    
+    // Entry points without request coalescing
+    std::string processNaturalLanguageQueryUncoalesced(const std::string& query, Mode mode, Pipeline pipeline);
+    std::vector<Item> generateShoppingListUncoalesced(const std::string& request, Pipeline pipeline);
     
 public:
     // Constructor
@@ -93,13 +132,49 @@ public:
     void setDailyQueryLimit(int limit);
     void setGPTModel(const std::string& model);
     std::string getGPTModel() const;
+    void setGPTEndpoint(const std::string& baseUrl);
+    std::string getGPTEndpoint() const;
+    AdaptiveRouter::State getGPTCircuitState() const;
+    void setDefaultPipeline(Pipeline pipeline);
+    Pipeline getDefaultPipeline() const;
+    static std::string pipelineName(Pipeline pipeline);
+    static std::optional<Pipeline> parsePipeline(const std::string& name);
+    bool loadIntentModel(const std::string& path);
+    static std::string modeName(Mode mode);
+    static std::optional<Mode> parseMode(const std::string& name);
+    
+    // Processing mode the intent model predicts for a query, or fallback when unsure
+    Mode chooseMode(const std::string& query, Mode fallback) const;
+    
+    // Local keyword classification of a query, found in one pass
+    struct QueryKeywords {
+        std::string intent = "GENERIC";             // SEARCH, COMPARE, SHOPPING_LIST, BUDGET or GENERIC
+        bool hasSimpleIndicator = false;            // "find", "price of", ...
+        bool hasSpecificIndicator = false;          // Brand names and sizes
+        std::string scenario;                       // First matching shopping scenario, or empty
+        std::vector<std::string> categories;        // Matching category expansions, in map order
+    };
+    QueryKeywords classifyQuery(const std::string& query) const;
     
     // Main interface methods
     std::string processNaturalLanguageQuery(const std::string& query, Mode mode = Mode::CHEAPEST_MIX);
+    std::string processNaturalLanguageQuery(const std::string& query, Mode mode, Pipeline pipeline);
     std::vector<Item> generateShoppingList(const std::string& request);
+    std::vector<Item> generateShoppingList(const std::string& request, Pipeline pipeline);
     std::vector<Item> generateShoppingListLocally(const std::string& request);
     std::string getBudgetInsight(const std::vector<Item>& items);
     
+    // Result ranking
+    struct RankedResult {
+        std::vector<Item> items;
+        Money totalCost;
+        std::string store;
+        double score;
+    };
+    
+    std::vector<RankedResult> rankByCheapestMix(const std::vector<Item>& items);
+    std::vector<RankedResult> rankBySingleStore(const std::vector<Item>& items);
+    
     // Response formatting
     std::string formatResponse(const std::vector<Item>& items, Mode mode);
     std::string formatTableResponse(const std::vector<Item>& items);
@@ -0,0 +1,181 @@
+/**
+ * @file Metrics.h
+ * @brief Process-wide metrics registry with Prometheus text exposition
+ *
+ * Provides counters, gauges and HDR-style latency histograms that can be
+ * updated from any httplib worker thread without taking a lock. Metric
+ * series are registered once (under a mutex) and then updated through
+ * plain atomics, so hot paths should cache the returned references.
+ *
+ * Example usage:
+ *   static Histogram& latency = MetricsRegistry::instance().histogram(
+ *       "budgeteer_db_query_duration_seconds", "Database query latency",
+ *       {{"method", "searchItems"}});
+ *   ScopedTimer timer(latency);
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// Ordered label set attached to a metric series (e.g. {{"route", "GET /items"}})
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * @class Counter
+ * @brief Monotonically increasing lock-free counter
+ */
+class Counter {
+private:
+    std::atomic<uint64_t> value{0};
+
+public:
+    void increment(uint64_t amount = 1) { value.fetch_add(amount, std::memory_order_relaxed); }
+    uint64_t get() const { return value.load(std::memory_order_relaxed); }
+};
+
+/**
+ * @class Gauge
+ * @brief Lock-free value that can go up and down
+ */
+class Gauge {
+private:
+    std::atomic<double> value{0.0};
+
+public:
+    void set(double v) { value.store(v, std::memory_order_relaxed); }
+    void add(double delta);
+    void increment() { add(1.0); }
+    void decrement() { add(-1.0); }
+    double get() const { return value.load(std::memory_order_relaxed); }
+};
+
+/**
+ * @class Histogram
+ * @brief HDR-style log-linear histogram with lock-free recording
+ *
+ * Values are recorded as unsigned integers in a base unit (microseconds for
+ * latencies, plain counts for sizes). Every power of two is split into 8
+ * linear sub-buckets, giving ~12.5% relative precision over the full 64-bit
+ * range with a fixed 496-bucket footprint.
+ *
+ * For exposition every sample is also counted under the first export bound
+ * (expressed in the exported unit, e.g. seconds) at or above its exact
+ * value, so the exported "le" buckets agree with _count and _sum even when
+ * a fine bucket straddles an export bound.
+ */
+class Histogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int BUCKET_COUNT = SUB_BUCKETS + (64 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+    /**
+     * @param unitScale Factor converting the recorded unit to the exported unit
+     *                  (1e-6 for microseconds exported as seconds)
+     * @param exportBounds Upper bounds of the exported "le" buckets, ascending
+     */
+    Histogram(double unitScale, std::vector<double> exportBounds);
+
+    void record(uint64_t value);
+    uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+    double getSum() const;                     ///< Sum in exported units
+    double percentile(double q) const;         ///< Approximate quantile in exported units (q in [0, 1])
+
+    const std::vector<double>& getExportBounds() const { return exportBounds; }
+    std::vector<uint64_t> cumulativeExportCounts() const;
+
+    // Default export layouts
+    static std::vector<double> latencyBounds();   ///< 100us .. 60s, in seconds
+    static std::vector<double> sizeBounds();      ///< 0 .. 100k, plain counts
+
+    static int bucketIndex(uint64_t value);
+    static uint64_t bucketUpperBound(int index);  ///< Inclusive upper edge of a fine bucket
+
+private:
+    double unitScale;
+    std::vector<double> exportBounds;
+    std::vector<uint64_t> exportLimits;     ///< Largest recorded value under each export bound
+    std::unique_ptr<std::atomic<uint64_t>[]> buckets;
+    std::unique_ptr<std::atomic<uint64_t>[]> exportCounts;   ///< Per export bound, plus +Inf
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sum{0};
+};
+
+/**
+ * @class ScopedTimer
+ * @brief Records the lifetime of the object into a latency histogram (microseconds)
+ */
+class ScopedTimer {
+private:
+    Histogram& histogram;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit ScopedTimer(Histogram& h) : histogram(h), start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer();
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    /// Elapsed time so far in microseconds
+    uint64_t elapsedMicros() const;
+};
+
+/**
+ * @class MetricsRegistry
+ * @brief Owns every metric series and renders them in Prometheus text format
+ *
+ * Lookups are idempotent: asking twice for the same name and labels returns
+ * the same object, which stays valid for the lifetime of the process.
+ */
+class MetricsRegistry {
+private:
+    enum class Type { COUNTER, GAUGE, HISTOGRAM };
+
+    struct Family {
+        std::string help;
+        Type type;
+        std::map<std::string, std::unique_ptr<Counter>> counters;
+        std::map<std::string, std::unique_ptr<Gauge>> gauges;
+        std::map<std::string, std::unique_ptr<Histogram>> histograms;
+    };
+
+    mutable std::mutex mutex;
+    std::map<std::string, Family> families;
+
+    Family& family(const std::string& name, const std::string& help, Type type);
+    static std::string formatLabels(const MetricLabels& labels);
+    static std::string escapeLabelValue(const std::string& value);
+
+    MetricsRegistry() = default;
+
+public:
+    static MetricsRegistry& instance();
+
+    Counter& counter(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+    Gauge& gauge(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+    Histogram& histogram(const std::string& name, const std::string& help, const MetricLabels& labels = {},
+                         double unitScale = 1e-6, std::vector<double> exportBounds = Histogram::latencyBounds());
+
+    /// Render every registered series in Prometheus text exposition format (version 0.0.4)
+    std::string renderPrometheus() const;
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+};
+
+#endif // METRICS_H
@@ -0,0 +1,90 @@
+/**
+ * @file Money.h
+ * @brief Fixed-point money amounts in whole cents
+ *
+ * Prices, totals and budgets are held as a signed 64-bit count of cents, so
+ * sums are exact and comparisons never depend on rounding. Amounts are
+ * parsed straight from text ("4.99", "$1,299", "12.5") and written back with
+ * exactly two decimals without going through floating point. Conversion to
+ * and from double is explicit and only used at the edges (GPT prompts,
+ * real-time API payloads).
+ *
+ * Example usage:
+ *   Money total;
+ *   for (const auto& item : items) total += item.getCurrentPrice();
+ *   std::cout << "Total: $" << total << std::endl;   // "Total: $23.47"
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * @class Money
+ * @brief An amount of dollars stored as integer cents
+ */
+class Money {
+public:
+    constexpr Money() = default;
+
+    static constexpr Money fromCents(long long cents) { return Money(cents); }
+
+    /// Rounds to the nearest cent
+    static Money fromDollars(double dollars);
+
+    /**
+     * @brief Parse a decimal amount without floating point
+     *
+     * Accepts an optional sign and '$', digits with optional ',' separators
+     * and an optional fraction. A third decimal rounds half up; further
+     * decimals are ignored. Surrounding spaces are allowed.
+     * @return The amount, or nullopt when the text is not a number
+     */
+    static std::optional<Money> parse(std::string_view text);
+
+    constexpr long long cents() const { return amount; }
+    double dollars() const { return static_cast<double>(amount) / 100.0; }
+
+    /// "-12.05": optional sign, whole dollars, two decimals
+    std::string toString() const;
+
+    /// Writes toString() into out (at least kMaxChars bytes) and returns the end
+    char* format(char* out) const;
+    static constexpr size_t kMaxChars = 24;
+
+    /// Rounded to the nearest cent (halves away from zero); zero for count <= 0
+    Money dividedBy(long long count) const;
+
+    constexpr Money operator-() const { return Money(-amount); }
+    constexpr Money operator+(Money other) const { return Money(amount + other.amount); }
+    constexpr Money operator-(Money other) const { return Money(amount - other.amount); }
+    constexpr Money operator*(long long count) const { return Money(amount * count); }
+    Money& operator+=(Money other) { amount += other.amount; return *this; }
+    Money& operator-=(Money other) { amount -= other.amount; return *this; }
+
+    constexpr bool operator==(Money other) const { return amount == other.amount; }
+    constexpr bool operator!=(Money other) const { return amount != other.amount; }
+    constexpr bool operator<(Money other) const { return amount < other.amount; }
+    constexpr bool operator<=(Money other) const { return amount <= other.amount; }
+    constexpr bool operator>(Money other) const { return amount > other.amount; }
+    constexpr bool operator>=(Money other) const { return amount >= other.amount; }
+
+private:
+    constexpr explicit Money(long long cents) : amount(cents) {}
+
+    long long amount = 0;
+};
+
+/// Same text as toString(); honours the stream's width and alignment
+std::ostream& operator<<(std::ostream& out, Money money);
+
+#endif // MONEY_H
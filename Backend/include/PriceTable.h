@@ -0,0 +1,123 @@
+/**
+ * @file PriceTable.h
+ * @brief Dense product x store table of current prices with vectorized basket totals
+ *
+ * The catalogue keeps every historical price row, and item IDs are specific
+ * to one store. Whole-basket questions ("what would this list cost at each
+ * store?") need the current price of each product at every store, so the
+ * table has one row per product (distinct item name) and one column per
+ * store. Every item ID maps to its product's row. Each cell packs the latest
+ * price in cents (low 32 bits) with a "carried" flag (bit 32); cells of
+ * stores that do not carry the product are zero.
+ *
+ * Rows are padded to a multiple of four stores and the storage is 64-byte
+ * aligned, so a row is read with whole vector loads. A basket's totals for
+ * every store are one pass over its rows in integer arithmetic: each row's
+ * cents are multiplied by the line's quantity and added lane by lane, and the
+ * flags add up to the number of lines each store carries. AVX2 is used when
+ * the build enables it (BUDGETEER_NATIVE_ARCH), otherwise SSE2 on x86-64,
+ * otherwise plain loops.
+ *
+ * Example usage:
+ *   const PriceTable& table = database->getPriceTable();
+ *   std::vector<PriceTable::BasketLine> basket = {{table.rowOfItemId(1001), 1}, {table.rowOfName("Butter (454g)"), 2}};
+ *   PriceTable::StoreTotals totals = table.basketTotals(basket);
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#ifndef PRICE_TABLE_H
+#define PRICE_TABLE_H
+
+#include "Item.h"
+#include "Money.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class PriceTable
+ * @brief Latest price of every product at every store
+ */
+class PriceTable {
+public:
+    /// One product of a basket; row is a table row, quantity multiplies its price
+    struct BasketLine {
+        int row;
+        int quantity = 1;
+    };
+
+    /// Per store (indexed like storeName()): cost of the lines it carries and how many it lacks
+    struct StoreTotals {
+        std::vector<Money> cost;
+        std::vector<size_t> missing;
+
+        /// Store with the fewest missing lines, then the lowest cost; -1 without stores
+        int cheapestStore() const;
+    };
+
+    /// Rebuild from catalogue rows, keeping the newest price_date per product and store
+    void build(const std::vector<Item>& items);
+
+    size_t productCount() const { return productNames.size(); }
+    size_t storeCount() const { return storeNames.size(); }
+    const std::string& productName(size_t row) const { return productNames[row]; }
+    const std::string& storeName(size_t store) const { return storeNames[store]; }
+
+    /// Row of the product an item ID belongs to, or -1
+    int rowOfItemId(int itemId) const;
+
+    /// Row of a product by exact item name, or -1
+    int rowOfName(const std::string& name) const;
+
+    bool carries(size_t row, size_t store) const { return (cells[row * stride + store] >> 32) != 0; }
+
+    /// Latest price; only meaningful when carries() is true
+    Money price(size_t row, size_t store) const {
+        return Money::fromCents(static_cast<long long>(cells[row * stride + store] & 0xFFFFFFFFu));
+    }
+
+    /// Basket of catalogue rows; repeated products add to one line's quantity, unknown ones are skipped
+    std::vector<BasketLine> basketOf(const std::vector<Item>& items) const;
+
+    StoreTotals basketTotals(const std::vector<BasketLine>& lines) const;
+
+    /// Totals for many baskets at once (dashboards compare whole sets of baskets); each runs the vectorized kernel
+    std::vector<StoreTotals> compareBaskets(const std::vector<std::vector<BasketLine>>& baskets) const;
+
+    /// Instruction set used by basketTotals: "avx2", "sse2" or "scalar"
+    static const char* simdPath();
+
+private:
+    /// Allocates on 64-byte (cache line) boundaries
+    template <typename T>
+    struct CacheAlignedAllocator {
+        using value_type = T;
+        CacheAlignedAllocator() = default;
+        template <typename U>
+        CacheAlignedAllocator(const CacheAlignedAllocator<U>&) {}
+        T* allocate(size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(64))); }
+        void deallocate(T* p, size_t) { ::operator delete(p, std::align_val_t(64)); }
+        bool operator==(const CacheAlignedAllocator&) const { return true; }
+        bool operator!=(const CacheAlignedAllocator&) const { return false; }
+    };
+
+    std::vector<std::string> productNames;
+    std::vector<std::string> storeNames;
+    std::unordered_map<std::string, int> rowsByName;
+    std::unordered_map<int, int> rowsByItemId;
+
+    size_t stride = 0;                  ///< Cells per row: storeCount() rounded up to 4
+    std::vector<uint64_t, CacheAlignedAllocator<uint64_t>> cells;   ///< productCount() * stride, row-major
+
+    /// basketTotals with caller-owned scratch buffers, so compareBaskets allocates them once
+    StoreTotals totalsOf(const std::vector<BasketLine>& lines, std::vector<BasketLine>& valid,
+                         std::vector<uint64_t>& cost, std::vector<uint64_t>& carried) const;
+};
+
+#endif // PRICE_TABLE_H
@@ -0,0 +1,77 @@
+/**
+ * @file PromptCatalog.h
+ * @brief Compact numeric-ID encoding of product lists in GPT prompts
+ *
+ * Prompts list products as short numbered lines ("12. Great Value Milk 2L")
+ * and ask GPT to answer with the numbers instead of echoing full names. The
+ * catalog assigns each distinct name a stable 1-based ID in insertion order,
+ * remembers which rows (items) carry that name, and maps IDs in a reply back
+ * to rows with a single array lookup. This cuts output tokens and replaces
+ * fuzzy name re-matching with exact lookups.
+ *
+ * Replies that still use names instead of IDs are resolved through a hash
+ * map on the exact (case-insensitive) name, so a model that ignores the
+ * instruction degrades gracefully instead of failing.
+ *
+ * Example usage:
+ *   PromptCatalog catalog;
+ *   for (size_t i = 0; i < items.size(); i++) catalog.add(items[i].getItemName(), i);
+ *   prompt << catalog.listing(50);
+ *   for (int id : catalog.resolve(reply["selected_ids"], 50)) { ...catalog.rowsOf(id)... }
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#ifndef PROMPT_CATALOG_H
+#define PROMPT_CATALOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json_fwd.hpp>
+
+/**
+ * @class PromptCatalog
+ * @brief Bidirectional name <-> ID table for one prompt
+ */
+class PromptCatalog {
+public:
+    static constexpr size_t kNoRow = SIZE_MAX;
+
+    /**
+     * @brief Register a name, optionally with the row it came from
+     * @return The name's ID (existing ID when the name was already added)
+     */
+    int add(const std::string& name, size_t row = kNoRow);
+
+    /// ID of a name already added, or 0
+    int idOf(const std::string& name) const;
+
+    size_t size() const { return names.size(); }
+    bool contains(int id) const { return id >= 1 && static_cast<size_t>(id) <= names.size(); }
+    const std::string& nameOf(int id) const { return names[id - 1]; }
+    const std::vector<size_t>& rowsOf(int id) const { return rows[id - 1]; }
+
+    /// "id. name" lines for the first limit IDs
+    std::string listing(size_t limit = SIZE_MAX) const;
+
+    /**
+     * @brief IDs referenced by a reply array, in order and without duplicates
+     *
+     * Accepts numbers, numeric strings ("12") and exact names; anything that
+     * does not resolve to a listed ID is ignored. Pass the limit given to
+     * listing() so IDs the model was never shown are ignored too.
+     */
+    std::vector<int> resolve(const nlohmann::json& values, size_t limit = SIZE_MAX) const;
+
+private:
+    std::vector<std::string> names;
+    std::vector<std::vector<size_t>> rows;
+    std::unordered_map<std::string, int> idsByName;   ///< Lowercased name -> ID
+};
+
+#endif // PROMPT_CATALOG_H
@@ -0,0 +1,74 @@
+/**
+ * @file RequestArena.h
+ * @brief Bump allocator for the temporaries of one request
+ *
+ * A request allocates many short-lived containers while it runs: search
+ * candidate lists, name sets, lowered copies of product names. Every
+ * RequestContext owns a RequestArena, and code running under the context
+ * takes its temporaries from it with RequestContext::memory():
+ *
+ *   std::pmr::vector<uint32_t> rows(RequestContext::memory());
+ *
+ * Allocation is a pointer bump into blocks taken from the heap; deallocation
+ * is a no-op, and the blocks are released together when the request ends.
+ * Nothing allocated from the arena may outlive the request, so results
+ * handed back to callers keep using ordinary containers.
+ *
+ * The arena is shared by every thread working on the request, so it is
+ * guarded by a mutex. It counts allocations, bytes and heap blocks, which
+ * RequestContext reports as metrics when the request finishes.
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#ifndef REQUEST_ARENA_H
+#define REQUEST_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+
+/**
+ * @class RequestArena
+ * @brief Thread-safe monotonic memory resource with allocation counters
+ */
+class RequestArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t kInitialBlockSize = 16 * 1024;
+
+    RequestArena();
+
+    RequestArena(const RequestArena&) = delete;
+    RequestArena& operator=(const RequestArena&) = delete;
+
+    uint64_t getAllocations() const;
+    uint64_t getBytes() const;        ///< Bytes handed out, before alignment padding
+    uint64_t getBlocks() const;       ///< Blocks taken from the heap
+
+private:
+    /// Passes blocks through to the default resource, counting them
+    class BlockSource : public std::pmr::memory_resource {
+    public:
+        uint64_t blocks = 0;
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    };
+
+    mutable std::mutex mutex;
+    BlockSource blockSource;
+    std::pmr::monotonic_buffer_resource buffer;
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+#endif // REQUEST_ARENA_H
@@ -0,0 +1,131 @@
+/**
+ * @file RequestContext.h
+ * @brief Per-request deadline and cancellation state for the LLM pipeline
+ *
+ * A RequestContext carries a request's end-to-end deadline, a cancellation
+ * flag and, optionally, its Trace. It is activated on the thread running the
+ * request with RequestContext::Scope (which also activates the trace), so
+ * pipeline stages can consult it without threading it through every call:
+ *
+ *   if (RequestContext::shouldStop()) return bestSoFar;
+ *   auto budget = RequestContext::remainingOr(std::chrono::seconds(30));
+ *
+ * When no context is active (CLI mode, benchmarks) shouldStop() is always
+ * false and remainingOr() returns the fallback, so stages behave as before.
+ *
+ * Streaming requests also install an event sink; stages publish progress
+ * (intent, search terms, candidates, ...) with emitEvent(), which is a no-op
+ * for ordinary requests.
+ *
+ * Each context also owns a RequestArena. memory() hands it out to code that
+ * builds short-lived containers, and the heap when no request is active.
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#ifndef REQUEST_CONTEXT_H
+#define REQUEST_CONTEXT_H
+
+#include "RequestArena.h"
+#include "Tracing.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+
+/**
+ * @class RequestContext
+ * @brief Deadline, cancellation and trace for one in-flight request
+ */
+class RequestContext {
+public:
+    using Clock = std::chrono::steady_clock;
+    using EventSink = std::function<void(const std::string& event, const std::string& data)>;
+
+    /**
+     * @class Scope
+     * @brief Makes a context (and its trace) current on this thread
+     */
+    class Scope {
+    private:
+        RequestContext* previous;
+        std::unique_ptr<Trace::Scope> traceScope;
+
+    public:
+        explicit Scope(RequestContext& context);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    explicit RequestContext(std::chrono::milliseconds budget);
+    ~RequestContext();   ///< Reports the arena's allocation counts
+
+    /// Request cancellation; the first reason given is kept
+    void cancel(const std::string& reason);
+
+    /// True once cancelled, past the deadline, or the client has gone away
+    bool isCancelled();
+
+    std::chrono::milliseconds remaining() const;
+    Clock::time_point getDeadline() const { return deadline; }
+    std::string getCancelReason() const;
+
+    /**
+     * @brief Install a callback reporting whether the client has disconnected
+     *
+     * The probe is called from whichever thread runs the request, so it must
+     * be safe to call off the HTTP worker thread.
+     */
+    void setDisconnectProbe(std::function<bool()> probe);
+
+    /// Count upstream (GPT) round trips made on behalf of this request
+    void noteUpstreamCall(int count = 1) { upstreamCalls.fetch_add(count, std::memory_order_relaxed); }
+    int getUpstreamCalls() const { return upstreamCalls.load(std::memory_order_relaxed); }
+
+    /// Receive progress events published while the request runs (streaming responses)
+    void setEventSink(EventSink sink) { eventSink = std::move(sink); }
+
+    void setTrace(std::shared_ptr<Trace> requestTrace) { trace = std::move(requestTrace); }
+    std::shared_ptr<Trace> getTrace() const { return trace; }
+
+    /// Arena for this request's temporaries
+    RequestArena& getArena() { return arena; }
+
+    /// Context active on the calling thread, or nullptr
+    static RequestContext* current();
+
+    /// Arena of the active request, or the default (heap) resource when none is active
+    static std::pmr::memory_resource* memory();
+
+    /// True when the active request (if any) should stop optional work
+    static bool shouldStop();
+
+    /// Remaining budget of the active request, or fallback when none is active
+    static std::chrono::milliseconds remainingOr(std::chrono::milliseconds fallback);
+
+    /// True when the active request streams progress events
+    static bool isStreaming();
+
+    /// Publish a progress event (data is a JSON document) to the active request's sink, if any
+    static void emitEvent(const std::string& event, const std::string& data);
+
+private:
+    Clock::time_point deadline;
+    std::atomic<bool> cancelled;
+    std::atomic<int> upstreamCalls;
+    mutable std::mutex mutex;
+    std::string cancelReason;
+    std::function<bool()> disconnectProbe;
+    EventSink eventSink;
+    std::shared_ptr<Trace> trace;
+    RequestArena arena;
+};
+
+#endif // REQUEST_CONTEXT_H
@@ -0,0 +1,79 @@
+/**
+ * @file ScanPool.h
+ * @brief Helper threads that split one large scan across cores
+ *
+ * A catalogue search scores every product. On a large catalogue that is one
+ * long loop on one core while the rest idle. parallelFor() cuts the range
+ * into fixed-size morsels; the calling thread and any idle pool threads
+ * claim morsels from a shared cursor until none are left, so a thread that
+ * finishes early simply takes the next morsel instead of waiting.
+ *
+ * The caller always scans too. When every pool thread is busy (other
+ * queries, high load) the caller just scans the whole range itself, so
+ * parallelFor() never waits for a thread to become free.
+ *
+ * Example usage:
+ *   ScanPool::shared().parallelFor(products.size(), 1024, 4,
+ *       [&](size_t worker, size_t begin, size_t end) { ...score [begin, end) into state[worker]... });
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#ifndef SCAN_POOL_H
+#define SCAN_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ScanPool
+ * @brief Morsel-driven parallel loop over a shared set of helper threads
+ */
+class ScanPool {
+public:
+    /// Scans morsels [begin, end); worker is 0 (the caller) .. maxWorkers - 1
+    using MorselBody = std::function<void(size_t worker, size_t begin, size_t end)>;
+
+    explicit ScanPool(size_t helperThreads);
+    ~ScanPool();
+
+    ScanPool(const ScanPool&) = delete;
+    ScanPool& operator=(const ScanPool&) = delete;
+
+    /// Process-wide pool with one helper per core beyond the first
+    static ScanPool& shared();
+
+    /**
+     * @brief Run body over [0, count) in morsels, on up to maxWorkers threads
+     *
+     * Returns once every morsel has been scanned. Each worker index is used
+     * by one thread at a time, so per-worker state needs no locking.
+     *
+     * @return Number of threads that scanned at least one morsel
+     */
+    size_t parallelFor(size_t count, size_t morselSize, size_t maxWorkers, const MorselBody& body);
+
+    size_t getHelperCount() const { return helpers.size(); }
+
+private:
+    struct Scan;
+
+    std::vector<std::thread> helpers;
+    std::queue<std::shared_ptr<Scan>> invitations;   ///< One entry per helper wanted by a scan
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping;
+
+    void helperLoop();
+    static size_t runMorsels(Scan& scan, size_t worker);
+};
+
+#endif // SCAN_POOL_H
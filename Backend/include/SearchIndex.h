@@ -0,0 +1,164 @@
+/**
+ * @file SearchIndex.h
+ * @brief BM25F inverted index over product names and descriptions
+ *
+ * Every product is a document with two fields, its folded name and folded
+ * description (see TextSearch). A term's weight in a document is BM25F:
+ * the term frequencies of both fields are normalized by field length,
+ * weighted, summed, and saturated with k1, then scaled by the term's idf.
+ * Those weights ("impacts") are computed once per build, and each term's
+ * postings are stored highest impact first.
+ *
+ * topK() walks the postings of the query terms in impact order, always
+ * advancing the list with the largest next impact. Each newly seen product
+ * is scored exactly by looking its terms up in a per-product forward list.
+ * The sum of the next impacts of all lists bounds the score of any product
+ * not seen yet. Once the k-th best score beats that bound the walk stops,
+ * usually after a small fraction of the postings. A postings budget
+ * (maxPostings) can cap the walk on very large catalogues; the result is
+ * then the best k among the highest-impact postings, not always the exact
+ * top k.
+ *
+ * Ranking features on top of BM25F:
+ *   - the exact name and names starting with the query ("eggs" -> "eggs 12
+ *     pack") get additive boosts; such products are found through a sorted
+ *     name list, not the postings
+ *   - query words also match dictionary terms they are a prefix of ("egg"
+ *     -> "eggs") and, when unknown, terms one or two edits away ("chiken" ->
+ *     "chicken"), each at a reduced weight
+ *
+ * Every constant is a Parameters field and can be set per deployment, e.g.
+ * from "k1=1.5,name_weight=4,prefix_boost=6".
+ *
+ * Example usage:
+ *   SearchIndex index;
+ *   index.build(std::move(foldedNames), std::move(foldedDescriptions));
+ *   for (const auto& hit : index.topK(TextSearch::fold("greek yogurt"), 50)) { ... }
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#ifndef SEARCH_INDEX_H
+#define SEARCH_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class SearchIndex
+ * @brief Impact-ordered inverted index with early-terminating top-k retrieval
+ */
+class SearchIndex {
+public:
+    struct Parameters {
+        double k1 = 1.2;                  ///< Term frequency saturation
+        double nameWeight = 3.0;          ///< BM25F field weights
+        double descriptionWeight = 1.0;
+        double nameB = 0.75;              ///< Field length normalization (0 = none, 1 = full)
+        double descriptionB = 0.75;
+        double exactBoost = 20.0;         ///< Added when the name equals the query
+        double prefixBoost = 10.0;        ///< Added when the name starts with the query as whole words
+        double prefixWeight = 0.7;        ///< Weight of terms a query word is a prefix of
+        double typoWeight = 0.5;          ///< Weight of terms one or two edits from an unknown word
+        size_t maxExpansions = 8;         ///< Prefix or typo terms added per query word
+        size_t maxPostings = 0;           ///< Stop the walk after this many postings (0 = exact top k)
+
+        /**
+         * @brief Parse "key=value,key=value" on top of these values
+         *
+         * Keys: k1, name_weight, description_weight, name_b, description_b,
+         * exact_boost, prefix_boost, prefix_weight, typo_weight, max_expansions,
+         * max_postings.
+         * Returns std::nullopt on an unknown key or an invalid value.
+         */
+        std::optional<Parameters> with(const std::string& spec) const;
+
+        std::string toString() const;
+    };
+
+    struct Hit {
+        uint32_t document;
+        double score;
+    };
+
+    /// Work done by one topK() call
+    struct Stats {
+        size_t postingsVisited = 0;
+        size_t documentsScored = 0;
+    };
+
+    /**
+     * @brief Index documents 0 .. names.size() - 1
+     *
+     * Both vectors hold folded text (TextSearch::fold) and must have the
+     * same size. The index keeps them for name(), description() and the
+     * prefix boost.
+     */
+    void build(std::vector<std::string> names, std::vector<std::string> descriptions);
+
+    /// Recompute the impacts (and impact order) for new parameters
+    void setParameters(const Parameters& parameters);
+    const Parameters& getParameters() const { return params; }
+
+    /**
+     * @brief The best k documents for a folded query, best first
+     *
+     * Equal scores are ordered by document number. Documents that match no
+     * query term (and get no boost) are never returned.
+     */
+    std::pmr::vector<Hit> topK(std::string_view foldedQuery, size_t k,
+                               std::pmr::memory_resource* memory = std::pmr::get_default_resource(),
+                               Stats* stats = nullptr) const;
+
+    size_t getDocumentCount() const { return names.size(); }
+    size_t getTermCount() const { return terms.size(); }
+    size_t getPostingCount() const { return postings.size(); }
+    const std::string& name(uint32_t document) const { return names[document]; }
+    const std::string& description(uint32_t document) const { return descriptions[document]; }
+
+private:
+    struct Posting {
+        uint32_t document;
+        float impact;
+        uint16_t nameFrequency;
+        uint16_t descriptionFrequency;
+    };
+
+    struct TermImpact {
+        uint32_t term;
+        float impact;
+    };
+
+    /// A list of postings walked by one query, with its weight
+    struct QueryTerm {
+        uint32_t term;
+        double weight;
+    };
+
+    Parameters params;
+    std::vector<std::string> names;
+    std::vector<std::string> descriptions;
+    std::vector<uint16_t> nameLengths;          ///< Terms per field, per document
+    std::vector<uint16_t> descriptionLengths;
+    std::vector<std::string> terms;             ///< Sorted; a term's id is its position
+    std::vector<uint32_t> postingOffsets;       ///< Postings of term t: [offsets[t], offsets[t + 1])
+    std::vector<Posting> postings;              ///< Highest impact first within a term
+    std::vector<uint32_t> forwardOffsets;       ///< Terms of document d, ascending: [offsets[d], offsets[d + 1])
+    std::vector<TermImpact> forward;
+    std::vector<uint32_t> nameOrder;            ///< Documents sorted by name, for exact and prefix lookups
+
+    void computeImpacts();
+    int findTerm(std::string_view term) const;
+    std::pmr::vector<QueryTerm> expandQuery(std::string_view foldedQuery, std::pmr::memory_resource* memory) const;
+    double boostOf(uint32_t document, std::string_view foldedQuery) const;
+    double scoreOf(uint32_t document, std::string_view foldedQuery, const std::pmr::vector<QueryTerm>& query) const;
+};
+
+#endif // SEARCH_INDEX_H
@@ -0,0 +1,162 @@
+/**
+ * @file SingleFlight.h
+ * @brief Coalesces concurrent identical computations into one in-flight call
+ *
+ * The first caller for a key (the leader) runs the computation; callers that
+ * arrive with the same key while it is running (followers) wait for and
+ * share its result instead of starting their own. Once the computation
+ * finishes the key is released, so later calls compute afresh — this is
+ * coalescing, not caching.
+ *
+ * A follower waits no longer than its own deadline, and gives up early when
+ * its abandon check says so (its client went away). It then runs compute
+ * itself, which under an expired or cancelled request is the cheap fallback
+ * path. waitingFollowers() lets the leader see whether anyone still wants
+ * the shared result. The leader's fan-in counts itself plus the followers
+ * still waiting when the result was published; those that gave up earlier
+ * did their own work and are not counted.
+ *
+ * Example usage:
+ *   SingleFlight<std::string> flights;
+ *   auto outcome = flights.run("query|cake ingredients", [&] { return expensive(); });
+ *   if (outcome.leader) fanIn.record(outcome.fanIn);
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#ifndef SINGLE_FLIGHT_H
+#define SINGLE_FLIGHT_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @class SingleFlight
+ * @brief Per-key deduplication of concurrent calls
+ */
+template <typename T>
+class SingleFlight {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Outcome {
+        T value;
+        bool leader;      ///< True for the caller that ran the computation
+        size_t fanIn;     ///< Callers that received the computation's result (leader only)
+        bool abandoned;   ///< True for a follower that stopped waiting and computed on its own
+    };
+
+    /**
+     * @brief Run compute for key, or join an identical call already in flight
+     *
+     * Exceptions thrown by the leader's computation are rethrown to every
+     * caller sharing it. A follower stops waiting at deadline or once
+     * abandon() returns true (checked every kPollInterval).
+     */
+    Outcome run(const std::string& key, const std::function<T()>& compute,
+                Clock::time_point deadline = Clock::time_point::max(),
+                const std::function<bool()>& abandon = nullptr) {
+        std::promise<T> promise;
+        std::shared_ptr<Call> call;
+        bool leader = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = inFlight.find(key);
+            if (it != inFlight.end()) {
+                call = it->second;
+                call->waiting++;
+            } else {
+                call = std::make_shared<Call>();
+                call->result = promise.get_future().share();
+                inFlight.emplace(key, call);
+                leader = true;
+            }
+        }
+
+        if (!leader) {
+            bool ready = waitFor(*call, deadline, abandon);
+            {
+                // Decide under the lock the leader publishes under, so a follower
+                // that still waited at publication always takes the result and is
+                // the only kind counted in the leader's fan-in.
+                std::lock_guard<std::mutex> lock(mutex);
+                ready = ready || call->result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                call->waiting--;
+            }
+            if (ready) {
+                return {call->result.get(), false, 0, false};
+            }
+            return {compute(), false, 0, true};
+        }
+
+        std::exception_ptr error;
+        std::unique_ptr<T> value;
+        try {
+            value = std::make_unique<T>(compute());
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        size_t fanIn = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (error) {
+                promise.set_exception(error);
+            } else {
+                promise.set_value(std::move(*value));
+            }
+            fanIn = 1 + call->waiting;
+            inFlight.erase(key);
+        }
+        return {call->result.get(), true, fanIn, false};
+    }
+
+    /// Followers still waiting for the computation running for key
+    size_t waitingFollowers(const std::string& key) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = inFlight.find(key);
+        return it == inFlight.end() ? 0 : it->second->waiting;
+    }
+
+    /// Number of distinct keys currently being computed
+    size_t inFlightCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return inFlight.size();
+    }
+
+private:
+    struct Call {
+        std::shared_future<T> result;
+        size_t waiting = 0;
+    };
+
+    static constexpr std::chrono::milliseconds kPollInterval{50};
+
+    /// Wait for the result until deadline or abandon(); true when it is ready
+    static bool waitFor(const Call& call, Clock::time_point deadline, const std::function<bool()>& abandon) {
+        while (true) {
+            auto until = std::min(deadline, Clock::now() + kPollInterval);
+            if (call.result.wait_until(until) == std::future_status::ready) {
+                return true;
+            }
+            if (Clock::now() >= deadline || (abandon && abandon())) {
+                return false;
+            }
+        }
+    }
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<Call>> inFlight;
+};
+
+#endif // SINGLE_FLIGHT_H
@@ -28,6 +28,7 @@ public:
     
     // Price comparison
     std::vector<Item> comparePrices(const std::string& productName);
+    const PriceTable& getPriceTable() const;
 };
 
 #endif // STORE_API_CLIENT_H
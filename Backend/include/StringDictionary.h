@@ -0,0 +1,59 @@
+/**
+ * @file StringDictionary.h
+ * @brief Dense integer ids for repeated strings (store names, category tags)
+ *
+ * The catalogue repeats a handful of store names and a few dozen category
+ * tags on every row. The database interns them at load time, so rows and
+ * products hold small ids, and filters compare integers (or test bits)
+ * instead of strings. Ids are assigned 0, 1, 2, ... in first-seen order.
+ *
+ * Example usage:
+ *   StringDictionary stores(std::numeric_limits<uint16_t>::max() + 1);
+ *   uint32_t walmart = stores.intern("Walmart");   // 0
+ *   int id = stores.find("Costco");                // -1 until interned
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#ifndef STRING_DICTIONARY_H
+#define STRING_DICTIONARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class StringDictionary
+ * @brief Bidirectional string <-> dense id map with a fixed capacity
+ */
+class StringDictionary {
+public:
+    /// capacity bounds the number of distinct strings (ids are < capacity)
+    explicit StringDictionary(size_t capacity);
+
+    /// Id of value, assigning the next one when first seen; throws std::length_error when full
+    uint32_t intern(const std::string& value);
+
+    /// Id of value, or -1 when it was never interned
+    int find(const std::string& value) const;
+
+    const std::string& name(size_t id) const { return names[id]; }
+    size_t size() const { return names.size(); }
+    size_t capacity() const { return limit; }
+
+    /// Every interned string, alphabetically
+    std::vector<std::string> sortedNames() const;
+
+    void clear();
+
+private:
+    size_t limit;
+    std::vector<std::string> names;
+    std::unordered_map<std::string, uint32_t> ids;
+};
+
+#endif // STRING_DICTIONARY_H
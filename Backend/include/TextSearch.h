@@ -0,0 +1,54 @@
+/**
+ * @file TextSearch.h
+ * @brief Text folding and a vectorized substring search for catalogue matching
+ *
+ * Search compares a query against every product's name and description.
+ * Both sides are folded the same way once (the catalogue at load time, the
+ * query once per request), so matching is a plain byte-wise substring test:
+ *   - ASCII letters are lowercased and accented Latin-1 letters (UTF-8) lose
+ *     their accent ("Crème" -> "creme")
+ *   - apostrophes are dropped ("Kellogg's" -> "kelloggs")
+ *   - any other punctuation or whitespace becomes one space, trimmed at the
+ *     ends ("Milk 2% (4L)" -> "milk 2 4l")
+ *
+ * contains() tests the first and last needle bytes against 16 or 32
+ * haystack positions at a time and only compares whole needles where both
+ * match. The instruction set (AVX2, SSE2, or scalar) is chosen once at run
+ * time from the CPU, so one binary runs everywhere.
+ *
+ * Example usage:
+ *   std::string name = TextSearch::fold("Crème Fraîche (250ml)");   // "creme fraiche 250ml"
+ *   bool hit = TextSearch::contains(name, TextSearch::fold("fraiche"));
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#ifndef TEXT_SEARCH_H
+#define TEXT_SEARCH_H
+
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+/**
+ * @class TextSearch
+ * @brief Folding and substring search over folded text
+ */
+class TextSearch {
+public:
+    /// Folded form of text (see file comment)
+    static std::string fold(std::string_view text);
+
+    /// Folded form of text, allocated from memory (e.g. a request arena)
+    static std::pmr::string fold(std::string_view text, std::pmr::memory_resource* memory);
+
+    /// True when needle occurs in haystack; an empty needle always matches
+    static bool contains(std::string_view haystack, std::string_view needle);
+
+    /// Kernel picked for this CPU: "avx2", "sse2" or "scalar"
+    static const char* kernelName();
+};
+
+#endif // TEXT_SEARCH_H
@@ -0,0 +1,137 @@
+/**
+ * @file Tracing.h
+ * @brief Lightweight request tracing with nested timing spans
+ *
+ * A Trace collects the spans recorded while handling one request. The trace
+ * is activated on the handling thread with Trace::Scope; TraceSpan objects
+ * created on that thread then attach themselves to it, using the innermost
+ * open span as their parent. When no trace is active, TraceSpan is a no-op,
+ * so pipeline code can be instrumented unconditionally.
+ *
+ * A finished trace can be rendered as a Server-Timing header value and
+ * appended to a Chrome trace-event JSON file (load it in chrome://tracing
+ * or https://ui.perfetto.dev).
+ *
+ * Example usage:
+ *   Trace trace("POST /api/llm/query");
+ *   {
+ *       Trace::Scope scope(trace);
+ *       TraceSpan span("cherry_pick");
+ *       span.setAttribute("candidates", 42);
+ *   }
+ *   res.set_header("Server-Timing", trace.serverTimingHeader());
+ *   trace.finish();
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#ifndef TRACING_H
+#define TRACING_H
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @class Trace
+ * @brief Span collection for a single request
+ */
+class Trace {
+public:
+    /// One completed (or still open) span
+    struct SpanRecord {
+        int id;
+        int parentId;                                            ///< -1 for top-level spans
+        std::string name;
+        int64_t startMicros;                                     ///< Offset from trace start
+        int64_t durationMicros;                                  ///< -1 while the span is open
+        uint64_t threadId;
+        std::vector<std::pair<std::string, std::string>> attributes;
+    };
+
+    /**
+     * @class Scope
+     * @brief Makes a trace current on this thread for the lifetime of the scope
+     */
+    class Scope {
+    private:
+        Trace* previousTrace;
+        int previousSpan;
+
+    public:
+        explicit Scope(Trace& trace);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    explicit Trace(std::string name);
+
+    int beginSpan(const std::string& name, int parentId);
+    void endSpan(int spanId);
+    void addAttribute(int spanId, const std::string& key, const std::string& value);
+
+    std::vector<SpanRecord> getSpans() const;
+    const std::string& getName() const { return name; }
+
+    /**
+     * @brief Render spans as a Server-Timing header value
+     *
+     * Spans sharing a name are merged (durations summed) so repeated stages
+     * such as per-term searches stay compact: "search;dur=12.4;desc=\"x5\"".
+     */
+    std::string serverTimingHeader() const;
+
+    /// Append the trace to the Chrome trace file, if one is configured
+    void finish() const;
+
+    // Global configuration
+    static void setChromeTraceFile(const std::string& path);
+    static std::string getChromeTraceFile();
+
+    /// Trace active on the calling thread, or nullptr
+    static Trace* current();
+
+private:
+    std::string name;
+    std::chrono::steady_clock::time_point start;
+    int64_t startEpochMicros;                                    ///< Wall clock of start, for the Chrome timeline
+    mutable std::mutex mutex;
+    std::vector<SpanRecord> spans;
+
+    friend class TraceSpan;
+};
+
+/**
+ * @class TraceSpan
+ * @brief RAII span attached to the calling thread's current trace
+ */
+class TraceSpan {
+private:
+    Trace* trace;
+    int spanId;
+    int previousSpan;
+
+public:
+    explicit TraceSpan(const std::string& name);
+    ~TraceSpan();
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    void setAttribute(const std::string& key, const std::string& value);
+    void setAttribute(const std::string& key, const char* value);
+    void setAttribute(const std::string& key, long long value);
+    void setAttribute(const std::string& key, int value) { setAttribute(key, static_cast<long long>(value)); }
+    void setAttribute(const std::string& key, size_t value) { setAttribute(key, static_cast<long long>(value)); }
+    void setAttribute(const std::string& key, double value);
+    void setAttribute(const std::string& key, bool value);
+};
+
+#endif // TRACING_H
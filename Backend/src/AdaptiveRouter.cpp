@@ -0,0 +1,189 @@
+/**
+ * @file AdaptiveRouter.cpp
+ * @brief Implementation of the GPT circuit breaker
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "AdaptiveRouter.h"
+#include "Metrics.h"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+Gauge& stateGauge() {
+    static Gauge& gauge = MetricsRegistry::instance().gauge(
+        "budgeteer_llm_circuit_state", "GPT circuit breaker state (0 closed, 1 half-open, 2 open)");
+    return gauge;
+}
+
+void recordTransition(const std::string& to) {
+    MetricsRegistry::instance().counter(
+        "budgeteer_llm_circuit_transitions_total", "GPT circuit breaker state changes",
+        {{"to", to}}).increment();
+}
+
+} // namespace
+
+AdaptiveRouter::AdaptiveRouter() : AdaptiveRouter(Config{}) {}
+
+AdaptiveRouter::AdaptiveRouter(const Config& config)
+    : config(config),
+      state(State::CLOSED),
+      cooloff(config.openCooloff),
+      probesInFlight(0),
+      probeLimit(1),
+      probeSuccesses(0) {}
+
+std::string AdaptiveRouter::stateName(State state) {
+    switch (state) {
+        case State::CLOSED: return "closed";
+        case State::OPEN: return "open";
+        case State::HALF_OPEN: return "half_open";
+    }
+    return "unknown";
+}
+
+void AdaptiveRouter::prune(std::chrono::steady_clock::time_point now) {
+    while (!window.empty() &&
+           (window.size() > config.windowSize || now - window.front().at > config.windowAge)) {
+        window.pop_front();
+    }
+}
+
+void AdaptiveRouter::transitionTo(State next, std::chrono::steady_clock::time_point now) {
+    if (next == state) {
+        return;
+    }
+    state = next;
+    probesInFlight = 0;
+    probeLimit = 1;
+    probeSuccesses = 0;
+    if (next == State::OPEN) {
+        openedAt = now;
+    } else if (next == State::CLOSED) {
+        // Judge the recovered upstream on fresh calls only; successes still inform the latency estimate
+        window.erase(std::remove_if(window.begin(), window.end(),
+                                    [](const Sample& sample) { return sample.failed; }),
+                     window.end());
+        cooloff = config.openCooloff;
+    }
+
+    stateGauge().set(next == State::CLOSED ? 0 : next == State::HALF_OPEN ? 1 : 2);
+    recordTransition(stateName(next));
+    std::cout << "[Router] GPT circuit " << stateName(next);
+    if (next == State::OPEN) {
+        std::cout << " for " << cooloff.count() << " ms, routing queries locally";
+    }
+    std::cout << std::endl;
+}
+
+void AdaptiveRouter::maybeHalfOpen(std::chrono::steady_clock::time_point now) {
+    if (state == State::OPEN && now - openedAt >= cooloff) {
+        transitionTo(State::HALF_OPEN, now);
+    }
+}
+
+AdaptiveRouter::Permit AdaptiveRouter::acquire() {
+    std::lock_guard<std::mutex> lock(mutex);
+    maybeHalfOpen(std::chrono::steady_clock::now());
+
+    switch (state) {
+        case State::CLOSED:
+            return Permit::ALLOWED;
+        case State::HALF_OPEN:
+            if (probesInFlight < probeLimit) {
+                probesInFlight++;
+                return Permit::PROBE;
+            }
+            return Permit::REJECTED;
+        case State::OPEN:
+            break;
+    }
+    return Permit::REJECTED;
+}
+
+void AdaptiveRouter::record(Permit permit, bool succeeded, std::chrono::steady_clock::duration latency) {
+    if (permit == Permit::REJECTED) {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    auto latencyMs = std::chrono::duration_cast<std::chrono::milliseconds>(latency);
+    bool failed = !succeeded || latencyMs >= config.slowCallThreshold;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    window.push_back({now, failed, latencyMs, succeeded});
+    prune(now);
+
+    if (permit == Permit::PROBE) {
+        if (state != State::HALF_OPEN) {
+            return;   // Stale probe from an earlier half-open period
+        }
+        probesInFlight = std::max(0, probesInFlight - 1);
+        if (failed) {
+            cooloff = std::min(config.maxCooloff, cooloff * 2);
+            transitionTo(State::OPEN, now);
+        } else if (++probeSuccesses >= config.closeAfterProbes) {
+            transitionTo(State::CLOSED, now);
+        } else {
+            probeLimit *= 2;   // Let more traffic through as confidence grows
+        }
+        return;
+    }
+
+    if (state != State::CLOSED || window.size() < config.minSamples) {
+        return;
+    }
+    size_t failures = static_cast<size_t>(std::count_if(window.begin(), window.end(),
+        [](const Sample& sample) { return sample.failed; }));
+    double failureRate = static_cast<double>(failures) / static_cast<double>(window.size());
+    if (failureRate >= config.failureRateThreshold) {
+        std::cout << "[Router] " << failures << "/" << window.size()
+                  << " recent GPT calls failed or were slow" << std::endl;
+        transitionTo(State::OPEN, now);
+    }
+}
+
+void AdaptiveRouter::abandon(Permit permit) {
+    if (permit != Permit::PROBE) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (state == State::HALF_OPEN) {
+        probesInFlight = std::max(0, probesInFlight - 1);
+    }
+}
+
+bool AdaptiveRouter::isAcceptingCalls() {
+    std::lock_guard<std::mutex> lock(mutex);
+    maybeHalfOpen(std::chrono::steady_clock::now());
+    return state == State::CLOSED || (state == State::HALF_OPEN && probesInFlight < probeLimit);
+}
+
+std::chrono::milliseconds AdaptiveRouter::typicalLatency() const {
+    std::vector<std::chrono::milliseconds> latencies;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& sample : window) {
+            if (sample.succeeded) {
+                latencies.push_back(sample.latency);
+            }
+        }
+    }
+    if (latencies.empty()) {
+        return config.defaultLatency;
+    }
+    auto p75 = latencies.begin() + (latencies.size() * 3) / 4;
+    std::nth_element(latencies.begin(), p75, latencies.end());
+    return *p75;
+}
+
+AdaptiveRouter::State AdaptiveRouter::getState() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return state;
+}
@@ -0,0 +1,171 @@
+/**
+ * @file AdmissionControl.cpp
+ * @brief Implementation of per-client rate limiting and load shedding
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "AdmissionControl.h"
+#include "Metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+
+namespace {
+
+// Weight of the newest sample in the service-time moving average
+constexpr double kServiceTimeAlpha = 0.2;
+
+Counter& rejections(const std::string& reason) {
+    return MetricsRegistry::instance().counter(
+        "budgeteer_admission_rejected_total", "LLM requests refused before queuing by reason",
+        {{"reason", reason}});
+}
+
+Gauge& inFlightGauge() {
+    static Gauge& gauge = MetricsRegistry::instance().gauge(
+        "budgeteer_admission_in_flight", "Admitted LLM requests running or queued");
+    return gauge;
+}
+
+Gauge& serviceTimeGauge() {
+    static Gauge& gauge = MetricsRegistry::instance().gauge(
+        "budgeteer_admission_service_time_seconds", "Moving average of admitted LLM request run times, excluding queue wait");
+    return gauge;
+}
+
+Gauge& estimatedWaitGauge() {
+    static Gauge& gauge = MetricsRegistry::instance().gauge(
+        "budgeteer_admission_estimated_wait_seconds", "Estimated queue wait for the next LLM request");
+    return gauge;
+}
+
+int retryAfter(double seconds) {
+    return std::max(1, static_cast<int>(std::ceil(seconds)));
+}
+
+} // namespace
+
+// ==================== TokenBucketLimiter ====================
+
+TokenBucketLimiter::TokenBucketLimiter(double ratePerSecond, double burst)
+    : ratePerSecond(std::max(ratePerSecond, 0.001)), burst(std::max(burst, 1.0)) {}
+
+TokenBucketLimiter::Shard& TokenBucketLimiter::shardFor(const std::string& clientId) {
+    return shards[std::hash<std::string>{}(clientId) % kShardCount];
+}
+
+bool TokenBucketLimiter::tryAcquire(const std::string& clientId, double& retryAfterSeconds) {
+    auto now = std::chrono::steady_clock::now();
+    Shard& shard = shardFor(clientId);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // Drop buckets that have refilled completely; they behave like new clients
+    if (shard.buckets.size() >= kMaxBucketsPerShard) {
+        for (auto it = shard.buckets.begin(); it != shard.buckets.end();) {
+            double idleSeconds = std::chrono::duration<double>(now - it->second.lastRefill).count();
+            if (it->second.tokens + idleSeconds * ratePerSecond >= burst) {
+                it = shard.buckets.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    auto [it, inserted] = shard.buckets.try_emplace(clientId, Bucket{burst, now});
+    Bucket& bucket = it->second;
+    if (!inserted) {
+        double elapsed = std::chrono::duration<double>(now - bucket.lastRefill).count();
+        bucket.tokens = std::min(burst, bucket.tokens + elapsed * ratePerSecond);
+        bucket.lastRefill = now;
+    }
+
+    if (bucket.tokens >= 1.0) {
+        bucket.tokens -= 1.0;
+        return true;
+    }
+    retryAfterSeconds = (1.0 - bucket.tokens) / ratePerSecond;
+    return false;
+}
+
+// ==================== AdmissionController ====================
+
+AdmissionController::Ticket::Ticket(AdmissionController* controller) : controller(controller) {}
+
+AdmissionController::Ticket::~Ticket() {
+    std::optional<std::chrono::steady_clock::duration> serviceTime;
+    if (startedAt) {
+        serviceTime = finishedAt.value_or(std::chrono::steady_clock::now()) - *startedAt;
+    }
+    controller->release(serviceTime);
+}
+
+AdmissionController::AdmissionController(const Config& config)
+    : config(config),
+      limiter(config.clientRatePerSecond, config.clientBurst),
+      inFlight(0),
+      serviceTimeMs(0.0) {
+    std::cout << "[Admission] " << config.clientRatePerSecond << " req/s per client (burst "
+              << config.clientBurst << "), max " << config.maxConcurrent << " in flight, "
+              << config.latencyBudgetMs << " ms queue budget" << std::endl;
+}
+
+double AdmissionController::estimatedQueueWaitMs() const {
+    int ahead = inFlight.load() - std::max(1, config.workerThreads) + 1;
+    if (ahead <= 0) {
+        return 0.0;
+    }
+    return static_cast<double>(ahead) * serviceTimeMs.load() / std::max(1, config.workerThreads);
+}
+
+AdmissionController::Decision AdmissionController::reject(int status, double retryAfterSeconds,
+                                                          const std::string& reason) {
+    rejections(reason).increment();
+    return {false, status, retryAfter(retryAfterSeconds), reason, nullptr};
+}
+
+AdmissionController::Decision AdmissionController::admit(const std::string& clientId) {
+    // Shed on server-wide pressure first so a rejected request doesn't cost the client a token
+    double waitMs = estimatedQueueWaitMs();
+    estimatedWaitGauge().set(waitMs / 1000.0);
+    if (waitMs > config.latencyBudgetMs) {
+        return reject(503, waitMs / 1000.0, "latency_budget");
+    }
+
+    int current = inFlight.load();
+    do {
+        if (current >= config.maxConcurrent) {
+            return reject(503, serviceTimeMs.load() / 1000.0, "concurrency");
+        }
+    } while (!inFlight.compare_exchange_weak(current, current + 1));
+
+    // Only a request the server can take costs the client a token
+    double retryAfterSeconds = 0.0;
+    if (!limiter.tryAcquire(clientId, retryAfterSeconds)) {
+        inFlight.fetch_sub(1);
+        return reject(429, retryAfterSeconds, "rate_limited");
+    }
+    inFlightGauge().set(current + 1);
+
+    return {true, 200, 0, "", std::make_shared<Ticket>(this)};
+}
+
+void AdmissionController::release(std::optional<std::chrono::steady_clock::duration> serviceTime) {
+    int remaining = inFlight.fetch_sub(1) - 1;
+    inFlightGauge().set(remaining);
+
+    // Requests that never ran (refused by the executor) say nothing about service time
+    if (!serviceTime) {
+        return;
+    }
+    double sample = std::chrono::duration<double, std::milli>(*serviceTime).count();
+    double average = serviceTimeMs.load();
+    double updated;
+    do {
+        updated = average == 0.0 ? sample : average + kServiceTimeAlpha * (sample - average);
+    } while (!serviceTimeMs.compare_exchange_weak(average, updated));
+    serviceTimeGauge().set(updated / 1000.0);
+}
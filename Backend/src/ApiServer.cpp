@@ -1,5 +1,21 @@
 #include "ApiServer.h"
+#include "BasketOptimizer.h"
+#include "Metrics.h"
+#include "RequestContext.h"
+#include "Tracing.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <sstream>
 #include <iomanip>
 #include <httplib.h>
@@ -9,7 +25,12 @@
 ApiServer::ApiServer(const std::string& dbPath, int serverPort, bool useRealTime)
     : database(std::make_unique<Database>(dbPath)),
       port(serverPort),
-      useRealTimeApis(useRealTime) {
+      useRealTimeApis(useRealTime),
+      llmDeadlineMs(25000),
+      catalogueThreads(static_cast<int>(std::max(4u, std::thread::hardware_concurrency()))),
+      llmThreads(8),
+      llmQueueCapacity(16) {
+    admissionConfig.maxConcurrent = 0;   // Derived from the LLM executor size at startup
     // Create shared pointer to database for StoreApiClient
     auto dbPtr = std::shared_ptr<Database>(database.get(), [](Database*){});
     storeClient = std::make_shared<StoreApiClient>(dbPtr);
@@ -125,7 +146,7 @@ std::string ApiServer::createShoppingListResponse(const std::vector<Item>& items
     json << "    \"item_count\": " << items.size() << ",\n";
     json << "    \"total_cost\": ";
     
-    double totalCost = 0.0;
+    Money totalCost;
     for (const auto& item : items) {
         totalCost += item.getCurrentPrice();
     }
@@ -137,7 +158,18 @@ std::string ApiServer::createShoppingListResponse(const std::vector<Item>& items
         if (i < items.size() - 1) json << ",";
         json << "\n";
     }
-    json << "    ]\n";
+    json << "    ],\n";
+    
+    // The same list bought entirely at each store, at current prices
+    const PriceTable& table = database->getPriceTable();
+    PriceTable::StoreTotals storeTotals = table.basketTotals(table.basketOf(items));
+    json << "    \"store_totals\": [";
+    for (size_t store = 0; store < storeTotals.cost.size(); store++) {
+        json << "{\"store\": \"" << table.storeName(store) << "\", \"total_cost\": " << storeTotals.cost[store]
+             << ", \"missing\": " << storeTotals.missing[store] << "}";
+        if (store + 1 < storeTotals.cost.size()) json << ", ";
+    }
+    json << "]\n";
     json << "  }\n";
     json << "}";
     return json.str();
@@ -172,7 +204,12 @@ std::string ApiServer::handleGetItemsByCategory(const std::string& category) con
     return createJsonResponse(items);
 }
 
-std::string ApiServer::handleGetItemsByPriceRange(double minPrice, double maxPrice) const {
+std::string ApiServer::handleGetItemsByCategories(const std::vector<std::string>& categories, bool matchAll) const {
+    auto items = database->getItemsByCategories(categories, matchAll);
+    return createJsonResponse(items);
+}
+
+std::string ApiServer::handleGetItemsByPriceRange(Money minPrice, Money maxPrice) const {
     auto items = database->getItemsByPriceRange(minPrice, maxPrice);
     return createJsonResponse(items);
 }
@@ -237,10 +274,11 @@ std::string escapeJsonString(const std::string& input) {
 }
 
 // LLM Interface handlers
-std::string ApiServer::handleNaturalLanguageQuery(const std::string& query) {
+std::string ApiServer::handleNaturalLanguageQuery(const std::string& query, LLMInterface::Pipeline pipeline) {
     std::cout << "[API] Natural language query: " << query << std::endl;
     
-    std::string response = llmInterface->processNaturalLanguageQuery(query);
+    LLMInterface::Mode mode = llmInterface->chooseMode(query, LLMInterface::Mode::CHEAPEST_MIX);
+    std::string response = llmInterface->processNaturalLanguageQuery(query, mode, pipeline);
     
     // Escape both query and response for safe JSON embedding
     std::string escapedQuery = escapeJsonString(query);
@@ -255,10 +293,10 @@ std::string ApiServer::handleNaturalLanguageQuery(const std::string& query) {
     return json.str();
 }
 
-std::string ApiServer::handleGenerateShoppingList(const std::string& request) {
+std::string ApiServer::handleGenerateShoppingList(const std::string& request, LLMInterface::Pipeline pipeline) {
     std::cout << "[API] Generate shopping list: " << request << std::endl;
     
-    auto items = llmInterface->generateShoppingList(request);
+    auto items = llmInterface->generateShoppingList(request, pipeline);
     return createShoppingListResponse(items);
 }
 
@@ -275,6 +313,163 @@ std::string ApiServer::handleBudgetInsight(const std::vector<Item>& items) {
     return json.str();
 }
 
+// Basket optimisation handler
+std::string ApiServer::handleOptimizeBasket(const std::vector<std::string>& products, int maxStores,
+                                            const std::map<std::string, Money>& tripCosts) const {
+    std::cout << "[API] Optimize basket of " << products.size() << " products, max stores " << maxStores << std::endl;
+    
+    // Each entry is an item name (in any case), an item id, or failing those a search term
+    PriceMatrix matrix;
+    for (const auto& product : products) {
+        std::vector<Item> candidates = database->getItemsByExactName(product);
+        if (candidates.empty() && !product.empty() &&
+            std::all_of(product.begin(), product.end(), [](unsigned char c) { return std::isdigit(c); })) {
+            auto byId = database->getItemById(std::atoi(product.c_str()));
+            if (!byId.empty()) {
+                candidates = database->getItemsByExactName(byId.front().getItemName());
+            }
+        }
+        if (candidates.empty()) {
+            candidates = database->searchItems(product);
+        }
+        matrix.addProduct(product, candidates);
+    }
+    
+    BasketOptimizer::Options options;
+    options.maxStores = maxStores;
+    options.tripCosts.assign(matrix.storeCount(), Money());
+    for (const auto& [store, cost] : tripCosts) {
+        int index = matrix.storeIndex(store);
+        if (index >= 0) {
+            options.tripCosts[index] = cost;
+        }
+    }
+    
+    BasketPlan plan = BasketOptimizer::optimize(matrix, options);
+    std::vector<BasketPlan> singleStore = BasketOptimizer::singleStorePlans(matrix, options);
+    
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(2);
+    json << "{\n";
+    json << "  \"success\": true,\n";
+    json << "  \"max_stores\": " << maxStores << ",\n";
+    json << "  \"total_cost\": " << plan.totalCost() << ",\n";
+    json << "  \"item_cost\": " << plan.itemCost << ",\n";
+    json << "  \"trip_cost\": " << plan.tripCost << ",\n";
+    json << "  \"exact\": " << (plan.exact ? "true" : "false") << ",\n";
+    
+    json << "  \"stores\": [";
+    for (size_t i = 0; i < plan.stores.size(); i++) {
+        json << "\"" << escapeJsonString(matrix.storeName(plan.stores[i])) << "\"";
+        if (i < plan.stores.size() - 1) json << ", ";
+    }
+    json << "],\n";
+    
+    json << "  \"items\": [\n";
+    bool first = true;
+    std::vector<std::string> unavailable;
+    for (size_t product = 0; product < matrix.productCount(); product++) {
+        int store = plan.storeOf[product];
+        if (store < 0) {
+            unavailable.push_back(matrix.productLabel(product));
+            continue;
+        }
+        if (!first) json << ",\n";
+        first = false;
+        json << "    {\"product\": \"" << escapeJsonString(matrix.productLabel(product)) << "\", ";
+        json << "\"store\": \"" << escapeJsonString(matrix.storeName(store)) << "\", ";
+        json << "\"price\": " << matrix.price(product, store) << ", ";
+        json << "\"item\": " << matrix.item(product, store).toJson() << "}";
+    }
+    json << "\n  ],\n";
+    
+    json << "  \"unavailable\": [";
+    for (size_t i = 0; i < unavailable.size(); i++) {
+        json << "\"" << escapeJsonString(unavailable[i]) << "\"";
+        if (i < unavailable.size() - 1) json << ", ";
+    }
+    json << "],\n";
+    
+    // Every store on its own, for comparison with the chosen plan
+    json << "  \"single_store\": [";
+    first = true;
+    for (const auto& alone : singleStore) {
+        if (alone.stores.empty()) continue;
+        if (!first) json << ", ";
+        first = false;
+        json << "{\"store\": \"" << escapeJsonString(matrix.storeName(alone.stores.front())) << "\", ";
+        json << "\"total_cost\": " << alone.totalCost() << ", ";
+        json << "\"missing\": " << alone.missing << "}";
+    }
+    json << "]\n";
+    json << "}";
+    return json.str();
+}
+
+// Basket comparison handler: every basket priced at every store in one pass per basket
+std::string ApiServer::handleCompareBaskets(const std::vector<std::string>& names,
+                                            const std::vector<std::vector<std::pair<std::string, int>>>& baskets) const {
+    std::cout << "[API] Compare " << baskets.size() << " baskets" << std::endl;
+    const PriceTable& table = database->getPriceTable();
+    
+    // Entries are item ids, exact item names, or search terms (best match)
+    std::vector<std::vector<PriceTable::BasketLine>> lines(baskets.size());
+    std::vector<std::vector<std::string>> unresolved(baskets.size());
+    for (size_t b = 0; b < baskets.size(); b++) {
+        for (const auto& [reference, quantity] : baskets[b]) {
+            int row = -1;
+            if (!reference.empty() && std::all_of(reference.begin(), reference.end(), [](unsigned char c) { return std::isdigit(c); })) {
+                row = table.rowOfItemId(std::atoi(reference.c_str()));
+            }
+            if (row < 0) {
+                row = table.rowOfName(reference);
+            }
+            if (row < 0) {
+                auto matches = database->searchItems(reference);
+                if (!matches.empty()) row = table.rowOfName(matches.front().getItemName());
+            }
+            if (row < 0) {
+                unresolved[b].push_back(reference);
+            } else {
+                lines[b].push_back({row, quantity});
+            }
+        }
+    }
+    
+    std::vector<PriceTable::StoreTotals> totals = table.compareBaskets(lines);
+    
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(2);
+    json << "{\n";
+    json << "  \"success\": true,\n";
+    json << "  \"simd\": \"" << PriceTable::simdPath() << "\",\n";
+    json << "  \"baskets\": [\n";
+    for (size_t b = 0; b < baskets.size(); b++) {
+        int cheapest = totals[b].cheapestStore();
+        json << "    {\"name\": \"" << escapeJsonString(names[b]) << "\", ";
+        json << "\"products\": " << lines[b].size() << ", ";
+        json << "\"cheapest_store\": ";
+        if (cheapest < 0) json << "null"; else json << "\"" << escapeJsonString(table.storeName(cheapest)) << "\"";
+        json << ", \"unresolved\": [";
+        for (size_t i = 0; i < unresolved[b].size(); i++) {
+            json << "\"" << escapeJsonString(unresolved[b][i]) << "\"";
+            if (i + 1 < unresolved[b].size()) json << ", ";
+        }
+        json << "], \"stores\": [";
+        for (size_t store = 0; store < totals[b].cost.size(); store++) {
+            json << "{\"store\": \"" << escapeJsonString(table.storeName(store)) << "\", \"total_cost\": "
+                 << totals[b].cost[store] << ", \"missing\": " << totals[b].missing[store] << "}";
+            if (store + 1 < totals[b].cost.size()) json << ", ";
+        }
+        json << "]}";
+        if (b + 1 < baskets.size()) json << ",";
+        json << "\n";
+    }
+    json << "  ]\n";
+    json << "}";
+    return json.str();
+}
+
 // Print menu
 void ApiServer::printMenu() const {
     std::cout << "\n========================================\n";
@@ -356,11 +551,13 @@ void ApiServer::processRequest(int option) {
             break;
         }
         case 6: {
-            double minPrice, maxPrice;
+            std::string minText, maxText;
             std::cout << "Enter minimum price: ";
-            std::cin >> minPrice;
+            std::cin >> minText;
             std::cout << "Enter maximum price: ";
-            std::cin >> maxPrice;
+            std::cin >> maxText;
+            Money minPrice = Money::parse(minText).value_or(Money());
+            Money maxPrice = Money::parse(maxText).value_or(Money());
             std::cout << "\n[API] GET /items?min=" << minPrice << "&max=" << maxPrice << "\n";
             response = handleGetItemsByPriceRange(minPrice, maxPrice);
             break;
@@ -424,7 +621,7 @@ void ApiServer::processRequest(int option) {
             std::cin.ignore();
             std::getline(std::cin, query);
             std::cout << "\n[API] POST /api/llm/query\n";
-            response = handleNaturalLanguageQuery(query);
+            response = handleNaturalLanguageQuery(query, llmInterface->getDefaultPipeline());
             break;
         }
         case 14: {
@@ -433,7 +630,7 @@ void ApiServer::processRequest(int option) {
             std::cin.ignore();
             std::getline(std::cin, request);
             std::cout << "\n[API] POST /api/llm/shopping-list\n";
-            response = handleGenerateShoppingList(request);
+            response = handleGenerateShoppingList(request, llmInterface->getDefaultPipeline());
             break;
         }
         case 15: {
@@ -473,6 +670,450 @@ void ApiServer::run() {
     } while (true);
 }
 
+#ifdef CPPHTTPLIB_HTTPLIB_H
+namespace {
+
+/// Latency and in-flight series of one route, for routes that finish after their handler returns
+struct RouteMetrics {
+    Histogram* latency;
+    Gauge* inFlight;
+    Gauge* classInFlight;
+    
+    void begin() const {
+        inFlight->increment();
+        classInFlight->increment();
+    }
+    
+    void end() const {
+        inFlight->decrement();
+        classInFlight->decrement();
+    }
+};
+
+RouteMetrics routeMetrics(const std::string& route, const std::string& routeClass) {
+    auto& registry = MetricsRegistry::instance();
+    return {
+        &registry.histogram("budgeteer_http_request_duration_seconds", "HTTP request latency by route", {{"route", route}}),
+        &registry.gauge("budgeteer_http_requests_in_flight", "HTTP requests currently being handled", {{"route", route}}),
+        &registry.gauge("budgeteer_route_class_in_flight", "HTTP requests being handled per route class",
+                        {{"class", routeClass}})
+    };
+}
+
+/**
+ * Wrap a route handler with per-route request, in-flight and latency metrics,
+ * plus an in-flight gauge for its route class ("catalogue" or "llm").
+ * Metric series are resolved once at registration so the request path only
+ * touches atomics. Streaming routes keep writing after the handler returns,
+ * so they pass streamed = true and track their own latency and in-flight
+ * gauges (routeMetrics) until the stream ends; only status counts are kept here.
+ */
+httplib::Server::Handler instrumented(const std::string& route, httplib::Server::Handler handler,
+                                      const std::string& routeClass = "catalogue", bool streamed = false) {
+    auto& registry = MetricsRegistry::instance();
+    const std::string requestsHelp = "HTTP requests by route and status class";
+    
+    const RouteMetrics metrics = routeMetrics(route, routeClass);
+    Counter* ok = &registry.counter("budgeteer_http_requests_total", requestsHelp, {{"route", route}, {"code", "2xx"}});
+    Counter* clientError = &registry.counter("budgeteer_http_requests_total", requestsHelp, {{"route", route}, {"code", "4xx"}});
+    Counter* serverError = &registry.counter("budgeteer_http_requests_total", requestsHelp, {{"route", route}, {"code", "5xx"}});
+    
+    return [=](const httplib::Request& req, httplib::Response& res) {
+        std::optional<ScopedTimer> timer;
+        if (!streamed) {
+            metrics.begin();
+            timer.emplace(*metrics.latency);
+        }
+        try {
+            handler(req, res);
+        } catch (...) {
+            if (!streamed) {
+                metrics.end();
+            }
+            serverError->increment();
+            throw;
+        }
+        if (!streamed) {
+            metrics.end();
+        }
+        
+        int status = res.status == -1 ? 200 : res.status;
+        if (status >= 500) {
+            serverError->increment();
+        } else if (status >= 400) {
+            clientError->increment();
+        } else {
+            ok->increment();
+        }
+    };
+}
+
+/**
+ * httplib's worker pool, with a gauge of accepted connections still waiting
+ * for a worker. LLM routes hold at most as many workers as admission control
+ * lets in, so while this stays at zero every catalogue request found a free
+ * worker straight away.
+ */
+class CountingTaskQueue : public httplib::TaskQueue {
+private:
+    httplib::ThreadPool pool;
+    Gauge& waiting;
+
+public:
+    explicit CountingTaskQueue(size_t threads)
+        : pool(threads),
+          waiting(MetricsRegistry::instance().gauge("budgeteer_http_connections_queued",
+                                                    "Accepted connections waiting for an HTTP worker")) {}
+    
+    bool enqueue(std::function<void()> fn) override {
+        waiting.increment();
+        bool queued = pool.enqueue([this, fn = std::move(fn)]() {
+            waiting.decrement();
+            fn();
+        });
+        if (!queued) {
+            waiting.decrement();
+        }
+        return queued;
+    }
+    
+    void shutdown() override {
+        pool.shutdown();
+    }
+};
+
+/// Extra time a cancelled pipeline gets to hand back its best result so far
+constexpr std::chrono::milliseconds kCancelGrace(500);
+
+/// How often a waiting LLM route checks whether its client has gone away
+constexpr std::chrono::milliseconds kDisconnectPoll(100);
+
+/**
+ * True when the client of req has closed its connection. Newer cpp-httplib
+ * releases expose Request::is_connection_closed; with older ones the
+ * fallback overload reports the client as connected.
+ */
+template <typename Request>
+auto connectionClosed(const Request& req, int) -> decltype(req.is_connection_closed(), bool()) {
+    return req.is_connection_closed();
+}
+
+template <typename Request>
+bool connectionClosed(const Request&, long) {
+    return false;
+}
+
+/// Handler body for LLM routes: request body in, JSON response out
+using LLMRouteHandler = std::function<std::string(const std::string& body)>;
+
+/// Per-request budget: the optional "deadline_ms" body field, capped by the server limit
+std::chrono::milliseconds requestBudget(const std::string& body, int serverLimitMs) {
+    auto parsed = nlohmann::json::parse(body, nullptr, false);
+    if (parsed.is_object() && parsed.contains("deadline_ms") && parsed["deadline_ms"].is_number()) {
+        int requested = parsed["deadline_ms"].get<int>();
+        if (requested > 0) {
+            return std::chrono::milliseconds(std::min(requested, serverLimitMs));
+        }
+    }
+    return std::chrono::milliseconds(serverLimitMs);
+}
+
+/// The optional "pipeline" body field ("sequential" or "single_pass"), else the server default
+LLMInterface::Pipeline requestedPipeline(const nlohmann::json& body, LLMInterface::Pipeline fallback) {
+    if (body.contains("pipeline") && body["pipeline"].is_string()) {
+        return LLMInterface::parsePipeline(body["pipeline"].get<std::string>()).value_or(fallback);
+    }
+    return fallback;
+}
+
+/**
+ * Client identity for rate limiting: the peer address. X-Forwarded-For is
+ * only believed when the peer is a trusted proxy; each trusted hop vouches
+ * for the one before it, so the client is the nearest entry, from the right,
+ * that is not itself a trusted proxy. Any client can set the header, so an
+ * untrusted peer's header is ignored.
+ */
+std::string clientIdFor(const httplib::Request& req, const std::vector<std::string>& trustedProxies) {
+    auto trusted = [&trustedProxies](const std::string& address) {
+        return std::find(trustedProxies.begin(), trustedProxies.end(), address) != trustedProxies.end();
+    };
+    
+    std::string client = req.remote_addr;
+    std::string forwarded = req.get_header_value("X-Forwarded-For");
+    size_t end = forwarded.size();
+    while (trusted(client) && end > 0) {
+        size_t comma = forwarded.rfind(',', end - 1);
+        size_t start = comma == std::string::npos ? 0 : comma + 1;
+        size_t first = forwarded.find_first_not_of(' ', start);
+        size_t last = forwarded.find_last_not_of(' ', end - 1);
+        if (first != std::string::npos && first < end && last >= first) {
+            client = forwarded.substr(first, last - first + 1);
+        }
+        end = comma == std::string::npos ? 0 : comma;
+    }
+    return client;
+}
+
+/**
+ * Run an LLM route on the LLM executor under an end-to-end deadline, inside
+ * a request trace. The HTTP worker waits at most until the deadline (plus a
+ * short grace period for the pipeline to return its best result so far);
+ * pipeline stages observe the deadline through RequestContext. Requests are
+ * first put through admission control (429 when the client is over its rate,
+ * 503 when the server is saturated or the estimated queue wait exceeds the
+ * latency budget). When the executor's queue is full the request is also
+ * rejected with 503 straight away, so LLM traffic can never hold more HTTP
+ * workers than the executor has threads plus queue slots. Stage spans are returned as a Server-Timing
+ * header and appended to the Chrome trace file when one is configured.
+ */
+httplib::Server::Handler llmRoute(const std::string& route, Executor& executor, AdmissionController& admission,
+                                  const std::vector<std::string>& trustedProxies, const int& deadlineMs,
+                                  LLMRouteHandler handler) {
+    static Counter& timeouts = MetricsRegistry::instance().counter(
+        "budgeteer_llm_deadline_exceeded_total", "LLM requests answered with 504 after their deadline");
+    
+    return [=, &executor, &admission, &trustedProxies, &deadlineMs](const httplib::Request& req, httplib::Response& res) {
+        auto decision = admission.admit(clientIdFor(req, trustedProxies));
+        if (!decision.admitted) {
+            res.status = decision.status;
+            res.set_header("Retry-After", std::to_string(decision.retryAfterSeconds));
+            res.set_content(decision.status == 429
+                ? "{\n  \"success\": false,\n  \"error\": \"Too many requests, please slow down\"\n}"
+                : "{\n  \"success\": false,\n  \"error\": \"LLM service is overloaded, please retry\"\n}",
+                "application/json");
+            return;
+        }
+        
+        auto context = std::make_shared<RequestContext>(requestBudget(req.body, deadlineMs));
+        auto trace = std::make_shared<Trace>(route);
+        context->setTrace(trace);
+        
+        // The task owns copies of everything it touches, so it can outlive this handler.
+        // The ticket is released when the pipeline finishes, even if the handler gave up waiting.
+        auto submitted = executor.trySubmit([context, handler, body = req.body, ticket = decision.ticket]() mutable {
+            ticket->markStarted();
+            RequestContext::Scope scope(*context);
+            TraceSpan span("request");
+            std::string response = handler(body);
+            ticket->markFinished();
+            ticket.reset();
+            return response;
+        });
+        
+        if (!submitted) {
+            res.status = 503;
+            res.set_header("Retry-After", "1");
+            res.set_content("{\n  \"success\": false,\n  \"error\": \"LLM service is at capacity, please retry\"\n}", "application/json");
+            return;
+        }
+        
+        // Wait for the pipeline, cancelling it if the client hangs up in the meantime
+        auto& result = *submitted;
+        auto giveUpAt = context->getDeadline() + kCancelGrace;
+        bool ready = false;
+        bool clientGone = false;
+        while (!ready && !clientGone && RequestContext::Clock::now() < giveUpAt) {
+            auto until = std::min(giveUpAt, RequestContext::Clock::now() + kDisconnectPoll);
+            ready = result.wait_until(until) == std::future_status::ready;
+            clientGone = !ready && connectionClosed(req, 0);
+        }
+        
+        if (ready) {
+            res.set_content(result.get(), "application/json");
+        } else if (clientGone) {
+            // Nobody is listening; stop the pipeline and free this worker
+            context->cancel("client_disconnected");
+            res.status = 499;
+        } else {
+            context->cancel("deadline");
+            timeouts.increment();
+            res.status = 504;
+            res.set_content("{\n  \"success\": false,\n  \"error\": \"Request deadline exceeded\"\n}", "application/json");
+        }
+        
+        if (context->isCancelled()) {
+            res.set_header("X-Budgeteer-Cancelled", context->getCancelReason());
+        }
+        res.set_header("X-Budgeteer-GPT-Calls", std::to_string(context->getUpstreamCalls()));
+        res.set_header("Server-Timing", trace->serverTimingHeader());
+        trace->finish();
+    };
+}
+
+/**
+ * Server-sent-event frames handed from the pipeline thread to the HTTP worker
+ * writing the response. Events pushed after close() are dropped.
+ */
+class StreamChannel {
+private:
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<std::string> frames;
+    bool closed = false;
+
+public:
+    std::atomic<bool> clientGone{false};
+
+    void push(const std::string& event, const std::string& data) {
+        // Multi-line payloads become one "data:" line per line
+        std::string frame = "event: " + event + "\n";
+        size_t start = 0;
+        do {
+            size_t end = data.find('\n', start);
+            frame += "data: " + data.substr(start, end == std::string::npos ? std::string::npos : end - start) + "\n";
+            start = end == std::string::npos ? data.size() + 1 : end + 1;
+        } while (start <= data.size());
+        frame += "\n";
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (closed) {
+                return;
+            }
+            frames.push_back(std::move(frame));
+        }
+        ready.notify_one();
+    }
+    
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+        }
+        ready.notify_one();
+    }
+    
+    /// Wait up to timeout for frames; returns false once closed and fully drained
+    bool take(std::chrono::milliseconds timeout, std::deque<std::string>& out) {
+        std::unique_lock<std::mutex> lock(mutex);
+        ready.wait_for(lock, timeout, [this] { return closed || !frames.empty(); });
+        out.swap(frames);
+        return !(closed && out.empty());
+    }
+};
+
+constexpr std::chrono::seconds kStreamHeartbeat(15);
+
+/**
+ * Streaming variant of llmRoute: the pipeline runs on the LLM executor under
+ * the same admission control and deadline, and its progress events (intent,
+ * search terms, candidates, refinements and upstream tokens) are written to
+ * the client as server-sent events while it works. The final "result" event
+ * carries the same JSON as the non-streaming route, followed by "done".
+ * Comment heartbeats keep idle proxies from closing the connection, and a
+ * client that goes away cancels the pipeline.
+ */
+httplib::Server::Handler llmStreamRoute(const std::string& route, Executor& executor, AdmissionController& admission,
+                                        const std::vector<std::string>& trustedProxies, const int& deadlineMs,
+                                        LLMRouteHandler handler) {
+    static Counter& timeouts = MetricsRegistry::instance().counter(
+        "budgeteer_llm_deadline_exceeded_total", "LLM requests answered with 504 after their deadline");
+    const RouteMetrics metrics = routeMetrics(route, "llm");
+    
+    return [=, &executor, &admission, &trustedProxies, &deadlineMs](const httplib::Request& req, httplib::Response& res) {
+        // The request counts as in flight, and is timed, until the stream ends (or it is rejected)
+        metrics.begin();
+        const auto started = RequestContext::Clock::now();
+        auto finishRequest = [metrics, started]() {
+            metrics.latency->record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                RequestContext::Clock::now() - started).count()));
+            metrics.end();
+        };
+        
+        auto decision = admission.admit(clientIdFor(req, trustedProxies));
+        if (!decision.admitted) {
+            res.status = decision.status;
+            res.set_header("Retry-After", std::to_string(decision.retryAfterSeconds));
+            res.set_content(decision.status == 429
+                ? "{\n  \"success\": false,\n  \"error\": \"Too many requests, please slow down\"\n}"
+                : "{\n  \"success\": false,\n  \"error\": \"LLM service is overloaded, please retry\"\n}",
+                "application/json");
+            finishRequest();
+            return;
+        }
+        
+        auto channel = std::make_shared<StreamChannel>();
+        auto context = std::make_shared<RequestContext>(requestBudget(req.body, deadlineMs));
+        auto trace = std::make_shared<Trace>(route);
+        context->setTrace(trace);
+        context->setEventSink([channel](const std::string& event, const std::string& data) {
+            channel->push(event, data);
+        });
+        context->setDisconnectProbe([channel]() { return channel->clientGone.load(); });
+        
+        auto submitted = executor.trySubmit([context, channel, handler, body = req.body, ticket = decision.ticket]() mutable {
+            ticket->markStarted();
+            RequestContext::Scope scope(*context);
+            TraceSpan span("request");
+            try {
+                channel->push("result", handler(body));
+                nlohmann::json done = {{"gpt_calls", context->getUpstreamCalls()}};
+                done["cancelled"] = context->isCancelled() ? nlohmann::json(context->getCancelReason()) : nlohmann::json();
+                channel->push("done", done.dump());
+            } catch (const std::exception& e) {
+                channel->push("error", nlohmann::json{{"error", e.what()}}.dump());
+            }
+            ticket->markFinished();
+            ticket.reset();
+            channel->close();
+        });
+        
+        if (!submitted) {
+            res.status = 503;
+            res.set_header("Retry-After", "1");
+            res.set_content("{\n  \"success\": false,\n  \"error\": \"LLM service is at capacity, please retry\"\n}", "application/json");
+            finishRequest();
+            return;
+        }
+        
+        res.set_header("Cache-Control", "no-cache");
+        res.set_header("X-Accel-Buffering", "no");
+        res.set_chunked_content_provider("text/event-stream",
+            [channel, context, lastWrite = RequestContext::Clock::now()](size_t, httplib::DataSink& sink) mutable {
+                std::deque<std::string> frames;
+                bool open = channel->take(std::chrono::seconds(1), frames);
+                auto now = RequestContext::Clock::now();
+                if (now - lastWrite >= kStreamHeartbeat) {
+                    frames.push_back(": keep-alive\n\n");
+                }
+                if (open && now > context->getDeadline() + kCancelGrace) {
+                    context->cancel("deadline");
+                    timeouts.increment();
+                    channel->close();
+                    frames.push_back("event: error\ndata: {\"error\": \"Request deadline exceeded\"}\n\n");
+                    open = false;
+                }
+                
+                for (const auto& frame : frames) {
+                    if (!sink.write(frame.data(), frame.size())) {
+                        channel->clientGone = true;
+                        context->cancel("client_disconnected");
+                        return false;
+                    }
+                    lastWrite = now;
+                }
+                if (!open) {
+                    sink.done();
+                }
+                return true;
+            },
+            // The ticket is held until the stream ends, so admission also bounds the workers streams hold
+            [channel, context, trace, finishRequest, ticket = decision.ticket](bool success) mutable {
+                if (!success) {
+                    channel->clientGone = true;
+                    context->cancel("client_disconnected");
+                }
+                channel->close();
+                trace->finish();
+                finishRequest();
+                ticket.reset();
+            });
+    };
+}
+
+} // namespace
+#endif
+
 // HTTP Server
 void ApiServer::startHttpServer() {
     std::cout << "\n========================================\n";
@@ -483,11 +1124,35 @@ void ApiServer::startHttpServer() {
     // cpp-httplib is available
     httplib::Server svr;
     
+    // httplib hands whole connections to its pool before routing, so both
+    // route classes share it and the isolation rests on its size. LLM requests
+    // hold a worker only while they hold an admission ticket, so at most
+    // maxConcurrent (<= llmThreads + llmQueueCapacity) workers; the rest are
+    // rejected with 503 straight away. Sizing the pool as catalogueThreads plus
+    // that cap leaves catalogueThreads workers that LLM traffic cannot take,
+    // and catalogue handlers run on them directly. maxConcurrent is clamped
+    // below so the sum always holds. Rejections and idle keep-alive connections
+    // still hold a worker briefly; budgeteer_http_connections_queued shows
+    // whether any connection had to wait.
+    llmExecutor = std::make_unique<Executor>("llm", llmThreads, llmQueueCapacity);
+    AdmissionController::Config admissionLimits = admissionConfig;
+    admissionLimits.workerThreads = llmThreads;
+    if (admissionLimits.maxConcurrent <= 0 || admissionLimits.maxConcurrent > llmThreads + llmQueueCapacity) {
+        admissionLimits.maxConcurrent = llmThreads + llmQueueCapacity;
+    }
+    admission = std::make_unique<AdmissionController>(admissionLimits);
+    const size_t httpWorkers = static_cast<size_t>(catalogueThreads + llmThreads + llmQueueCapacity);
+    svr.new_task_queue = [httpWorkers] { return new CountingTaskQueue(httpWorkers); };
+    std::cout << "HTTP workers: " << httpWorkers << " (catalogue " << catalogueThreads << ", llm "
+              << llmThreads << " + queue " << llmQueueCapacity << ")" << std::endl;
+    
     // Enable CORS for frontend
     svr.set_default_headers({
         {"Access-Control-Allow-Origin", "*"},
         {"Access-Control-Allow-Methods", "GET, POST, OPTIONS"},
-        {"Access-Control-Allow-Headers", "Content-Type"}
+        {"Access-Control-Allow-Headers", "Content-Type"},
+        {"Access-Control-Expose-Headers", "Server-Timing, X-Budgeteer-Cancelled, X-Budgeteer-GPT-Calls, Retry-After"},
+        {"Timing-Allow-Origin", "*"}
     });
     
     // Handle OPTIONS preflight requests
@@ -496,28 +1161,30 @@ void ApiServer::startHttpServer() {
         res.status = 200;
     });
     
+    
     // Root endpoint
-    svr.Get("/", [](const httplib::Request&, httplib::Response& res) {
-        res.set_content("{\"message\":\"Budgeteer API Server\",\"version\":\"1.0\",\"status\":\"running\"}", "application/json");
-    });
+    svr.Get("/", instrumented("GET /", [this](const httplib::Request&, httplib::Response& res) {
+        std::string circuit = AdaptiveRouter::stateName(llmInterface->getGPTCircuitState());
+        res.set_content("{\"message\":\"Budgeteer API Server\",\"version\":\"1.0\",\"status\":\"running\",\"llm_circuit\":\"" + circuit + "\"}", "application/json");
+    }));
     
     // GET /items - Get all items
-    svr.Get("/items", [this](const httplib::Request&, httplib::Response& res) {
+    svr.Get("/items", instrumented("GET /items", [this](const httplib::Request&, httplib::Response& res) {
         std::cout << "[HTTP] GET /items" << std::endl;
         std::string response = handleGetAllItems();
         res.set_content(response, "application/json");
-    });
+    }));
     
     // GET /items/:id - Get item by ID
-    svr.Get("/items/(\\d+)", [this](const httplib::Request& req, httplib::Response& res) {
+    svr.Get("/items/(\\d+)", instrumented("GET /items/:id", [this](const httplib::Request& req, httplib::Response& res) {
         int itemId = std::stoi(req.matches[1]);
         std::cout << "[HTTP] GET /items/" << itemId << std::endl;
         std::string response = handleGetItemById(itemId);
         res.set_content(response, "application/json");
-    });
+    }));
     
     // GET /search - Search items
-    svr.Get("/search", [this](const httplib::Request& req, httplib::Response& res) {
+    svr.Get("/search", instrumented("GET /search", [this](const httplib::Request& req, httplib::Response& res) {
         if (req.has_param("q")) {
             std::string query = req.get_param_value("q");
             std::cout << "[HTTP] GET /search?q=" << query << std::endl;
@@ -534,89 +1201,117 @@ void ApiServer::startHttpServer() {
             std::string response = handleGetItemsByStore(store);
             res.set_content(response, "application/json");
         } else if (req.has_param("category")) {
+            // "category=dairy,snacks" matches either; add "match=all" to require both
             std::string category = req.get_param_value("category");
-            std::cout << "[HTTP] GET /search?category=" << category << std::endl;
-            std::string response = handleGetItemsByCategory(category);
+            bool matchAll = req.get_param_value("match") == "all";
+            std::cout << "[HTTP] GET /search?category=" << category << (matchAll ? "&match=all" : "") << std::endl;
+            std::string response;
+            if (category.find(',') == std::string::npos) {
+                response = handleGetItemsByCategory(category);
+            } else {
+                std::vector<std::string> categories;
+                std::istringstream list(category);
+                std::string entry;
+                while (std::getline(list, entry, ',')) {
+                    entry.erase(0, entry.find_first_not_of(' '));
+                    entry.erase(entry.find_last_not_of(' ') + 1);
+                    if (!entry.empty()) categories.push_back(entry);
+                }
+                response = handleGetItemsByCategories(categories, matchAll);
+            }
             res.set_content(response, "application/json");
         } else if (req.has_param("min") && req.has_param("max")) {
-            double minPrice = std::stod(req.get_param_value("min"));
-            double maxPrice = std::stod(req.get_param_value("max"));
-            std::cout << "[HTTP] GET /search?min=" << minPrice << "&max=" << maxPrice << std::endl;
-            std::string response = handleGetItemsByPriceRange(minPrice, maxPrice);
+            auto minPrice = Money::parse(req.get_param_value("min"));
+            auto maxPrice = Money::parse(req.get_param_value("max"));
+            if (!minPrice || !maxPrice) {
+                res.set_content(createErrorResponse("Invalid price range"), "application/json");
+                return;
+            }
+            std::cout << "[HTTP] GET /search?min=" << *minPrice << "&max=" << *maxPrice << std::endl;
+            std::string response = handleGetItemsByPriceRange(*minPrice, *maxPrice);
             res.set_content(response, "application/json");
         } else {
             res.set_content(createErrorResponse("Missing query parameter"), "application/json");
         }
-    });
+    }));
     
     // GET /stores - Get all stores
-    svr.Get("/stores", [this](const httplib::Request&, httplib::Response& res) {
+    svr.Get("/stores", instrumented("GET /stores", [this](const httplib::Request&, httplib::Response& res) {
         std::cout << "[HTTP] GET /stores" << std::endl;
         std::string response = handleGetStores();
         res.set_content(response, "application/json");
-    });
+    }));
     
     // GET /categories - Get all categories
-    svr.Get("/categories", [this](const httplib::Request&, httplib::Response& res) {
+    svr.Get("/categories", instrumented("GET /categories", [this](const httplib::Request&, httplib::Response& res) {
         std::cout << "[HTTP] GET /categories" << std::endl;
         std::string response = handleGetCategories();
         res.set_content(response, "application/json");
-    });
+    }));
     
     // GET /items/:id/stats - Get item statistics
-    svr.Get("/items/(\\d+)/stats", [this](const httplib::Request& req, httplib::Response& res) {
+    svr.Get("/items/(\\d+)/stats", instrumented("GET /items/:id/stats", [this](const httplib::Request& req, httplib::Response& res) {
         int itemId = std::stoi(req.matches[1]);
         std::cout << "[HTTP] GET /items/" << itemId << "/stats" << std::endl;
         std::string response = handleGetStats(itemId);
         res.set_content(response, "application/json");
-    });
+    }));
     
     // POST /api/llm/query - Natural language query
-    svr.Post("/api/llm/query", [this](const httplib::Request& req, httplib::Response& res) {
+    svr.Post("/api/llm/query", instrumented("POST /api/llm/query", llmRoute("POST /api/llm/query", *llmExecutor, *admission, trustedProxies, llmDeadlineMs, [this](const std::string& body) {
         std::cout << "[HTTP] POST /api/llm/query" << std::endl;
         try {
-            auto json = nlohmann::json::parse(req.body);
+            auto json = nlohmann::json::parse(body);
             std::string query = json["query"];
-            std::string response = handleNaturalLanguageQuery(query);
-            res.set_content(response, "application/json");
+            return handleNaturalLanguageQuery(query, requestedPipeline(json, llmInterface->getDefaultPipeline()));
         } catch (const std::exception& e) {
-            res.set_content(createErrorResponse("Invalid JSON body"), "application/json");
+            return createErrorResponse("Invalid JSON body");
         }
-    });
+    }), "llm"));
+    
+    // POST /api/llm/query/stream - Natural language query with server-sent progress events
+    svr.Post("/api/llm/query/stream", instrumented("POST /api/llm/query/stream", llmStreamRoute("POST /api/llm/query/stream", *llmExecutor, *admission, trustedProxies, llmDeadlineMs, [this](const std::string& body) {
+        std::cout << "[HTTP] POST /api/llm/query/stream" << std::endl;
+        try {
+            auto json = nlohmann::json::parse(body);
+            std::string query = json["query"];
+            return handleNaturalLanguageQuery(query, requestedPipeline(json, llmInterface->getDefaultPipeline()));
+        } catch (const std::exception& e) {
+            return createErrorResponse("Invalid JSON body");
+        }
+    }), "llm", true));
     
     // POST /api/llm/shopping-list - Generate shopping list
-    svr.Post("/api/llm/shopping-list", [this](const httplib::Request& req, httplib::Response& res) {
+    svr.Post("/api/llm/shopping-list", instrumented("POST /api/llm/shopping-list", llmRoute("POST /api/llm/shopping-list", *llmExecutor, *admission, trustedProxies, llmDeadlineMs, [this](const std::string& body) {
         std::cout << "[HTTP] POST /api/llm/shopping-list" << std::endl;
         try {
-            auto json = nlohmann::json::parse(req.body);
+            auto json = nlohmann::json::parse(body);
             std::string prompt = json["prompt"];
-            std::string response = handleGenerateShoppingList(prompt);
-            res.set_content(response, "application/json");
+            return handleGenerateShoppingList(prompt, requestedPipeline(json, llmInterface->getDefaultPipeline()));
         } catch (const std::exception& e) {
-            res.set_content(createErrorResponse("Invalid JSON body"), "application/json");
+            return createErrorResponse("Invalid JSON body");
         }
-    });
+    }), "llm"));
     
     // POST /api/llm/budget-insight - Get budget insight
-    svr.Post("/api/llm/budget-insight", [this](const httplib::Request& req, httplib::Response& res) {
+    svr.Post("/api/llm/budget-insight", instrumented("POST /api/llm/budget-insight", llmRoute("POST /api/llm/budget-insight", *llmExecutor, *admission, trustedProxies, llmDeadlineMs, [this](const std::string& body) {
         std::cout << "[HTTP] POST /api/llm/budget-insight" << std::endl;
         try {
-            auto json = nlohmann::json::parse(req.body);
+            auto json = nlohmann::json::parse(body);
             std::vector<Item> items;
             for (const auto& itemJson : json["items"]) {
                 // Parse items from request (simplified)
                 auto dbItems = database->getItemById(itemJson["item_id"]);
                 items.insert(items.end(), dbItems.begin(), dbItems.end());
             }
-            std::string response = handleBudgetInsight(items);
-            res.set_content(response, "application/json");
+            return handleBudgetInsight(items);
         } catch (const std::exception& e) {
-            res.set_content(createErrorResponse("Invalid JSON body"), "application/json");
+            return createErrorResponse("Invalid JSON body");
         }
-    });
+    }), "llm"));
     
     // GET /api/realtime/search - Real-time search (database fallback)
-    svr.Get("/api/realtime/search", [this](const httplib::Request& req, httplib::Response& res) {
+    svr.Get("/api/realtime/search", instrumented("GET /api/realtime/search", [this](const httplib::Request& req, httplib::Response& res) {
         if (req.has_param("q")) {
             std::string query = req.get_param_value("q");
             std::cout << "[HTTP] GET /api/realtime/search?q=" << query << std::endl;
@@ -625,10 +1320,10 @@ void ApiServer::startHttpServer() {
         } else {
             res.set_content(createErrorResponse("Missing query parameter 'q'"), "application/json");
         }
-    });
+    }));
     
     // GET /api/realtime/compare - Compare prices (database)
-    svr.Get("/api/realtime/compare", [this](const httplib::Request& req, httplib::Response& res) {
+    svr.Get("/api/realtime/compare", instrumented("GET /api/realtime/compare", [this](const httplib::Request& req, httplib::Response& res) {
         if (req.has_param("product")) {
             std::string product = req.get_param_value("product");
             std::cout << "[HTTP] GET /api/realtime/compare?product=" << product << std::endl;
@@ -637,6 +1332,67 @@ void ApiServer::startHttpServer() {
         } else {
             res.set_content(createErrorResponse("Missing query parameter 'product'"), "application/json");
         }
+    }));
+    
+    // POST /api/basket/optimize - Cheapest way to buy a basket from at most max_stores stores
+    svr.Post("/api/basket/optimize", instrumented("POST /api/basket/optimize", [this](const httplib::Request& req, httplib::Response& res) {
+        std::cout << "[HTTP] POST /api/basket/optimize" << std::endl;
+        std::string response;
+        try {
+            auto json = nlohmann::json::parse(req.body);
+            std::vector<std::string> products;
+            for (const auto& product : json.at("products")) {
+                products.push_back(product.is_string() ? product.get<std::string>() : product.dump());
+            }
+            int maxStores = json.value("max_stores", 0);
+            std::map<std::string, Money> tripCosts;
+            if (json.contains("trip_costs")) {
+                for (const auto& [store, cost] : json["trip_costs"].items()) {
+                    tripCosts[store] = Money::fromDollars(cost.get<double>());
+                }
+            }
+            response = products.empty() ? createErrorResponse("'products' must not be empty")
+                                        : handleOptimizeBasket(products, maxStores, tripCosts);
+        } catch (const std::exception& e) {
+            response = createErrorResponse("Invalid JSON body");
+        }
+        res.set_content(response, "application/json");
+    }));
+    
+    // POST /api/basket/compare - Price many baskets at every store at once
+    svr.Post("/api/basket/compare", instrumented("POST /api/basket/compare", [this](const httplib::Request& req, httplib::Response& res) {
+        std::cout << "[HTTP] POST /api/basket/compare" << std::endl;
+        std::string response;
+        try {
+            auto json = nlohmann::json::parse(req.body);
+            std::vector<std::string> names;
+            std::vector<std::vector<std::pair<std::string, int>>> baskets;
+            for (const auto& basket : json.at("baskets")) {
+                // A basket is a list of entries, or {"name": ..., "items": [...]}
+                const auto& entries = basket.is_object() ? basket.at("items") : basket;
+                names.push_back(basket.is_object() ? basket.value("name", "") : "");
+                if (names.back().empty()) names.back() = "basket " + std::to_string(baskets.size() + 1);
+                
+                std::vector<std::pair<std::string, int>> lines;
+                for (const auto& entry : entries) {
+                    // An entry is an item id, an item name, or {"item": id or name, "quantity": n}
+                    const auto& item = entry.is_object() ? entry.at("item") : entry;
+                    int quantity = entry.is_object() ? entry.value("quantity", 1) : 1;
+                    lines.push_back({item.is_string() ? item.get<std::string>() : item.dump(), quantity});
+                }
+                baskets.push_back(std::move(lines));
+            }
+            response = baskets.empty() ? createErrorResponse("'baskets' must not be empty")
+                                       : handleCompareBaskets(names, baskets);
+        } catch (const std::exception& e) {
+            response = createErrorResponse("Invalid JSON body");
+        }
+        res.set_content(response, "application/json");
+    }));
+    
+    // GET /metrics - Prometheus scrape endpoint
+    svr.Get("/metrics", [](const httplib::Request&, httplib::Response& res) {
+        res.set_content(MetricsRegistry::instance().renderPrometheus(), "text/plain; version=0.0.4");
     });
     
     std::cout << "\n✓ HTTP Server configured with endpoints" << std::endl;
@@ -649,7 +1405,11 @@ void ApiServer::startHttpServer() {
     std::cout << "  GET  /stores" << std::endl;
     std::cout << "  GET  /categories" << std::endl;
     std::cout << "  POST /api/llm/query" << std::endl;
+    std::cout << "  POST /api/llm/query/stream" << std::endl;
     std::cout << "  POST /api/llm/shopping-list" << std::endl;
+    std::cout << "  POST /api/basket/optimize" << std::endl;
+    std::cout << "  POST /api/basket/compare" << std::endl;
+    std::cout << "  GET  /metrics" << std::endl;
     std::cout << "\nPress Ctrl+C to stop the server\n" << std::endl;
     
     // Start server
@@ -677,6 +1437,57 @@ void ApiServer::setStoreApiKey(const std::string& key) {
     std::cout << "[Config] Store API keys are not needed (using database only)" << std::endl;
 }
 
+void ApiServer::setLLMEndpoint(const std::string& baseUrl) {
+    llmInterface->setGPTEndpoint(baseUrl);
+}
+
+void ApiServer::configureWorkers(int catalogueWorkers, int llmWorkers, int llmQueue) {
+    catalogueThreads = std::max(1, catalogueWorkers);
+    llmThreads = std::max(1, llmWorkers);
+    llmQueueCapacity = std::max(0, llmQueue);
+}
+
+void ApiServer::configureAdmission(double clientRatePerSecond, double clientBurst, int maxConcurrent, int latencyBudgetMs) {
+    admissionConfig.clientRatePerSecond = std::max(0.001, clientRatePerSecond);
+    admissionConfig.clientBurst = std::max(1.0, clientBurst);
+    admissionConfig.maxConcurrent = std::max(0, maxConcurrent);
+    admissionConfig.latencyBudgetMs = std::max(1, latencyBudgetMs);
+}
+
+void ApiServer::setTrustedProxies(const std::vector<std::string>& addresses) {
+    trustedProxies = addresses;
+}
+
+bool ApiServer::setLLMPipeline(const std::string& name) {
+    auto pipeline = LLMInterface::parsePipeline(name);
+    if (!pipeline) {
+        std::cerr << "[Config] Unknown LLM pipeline '" << name << "' (use sequential or single_pass)" << std::endl;
+        return false;
+    }
+    llmInterface->setDefaultPipeline(*pipeline);
+    return true;
+}
+
+bool ApiServer::setSearchParameters(const std::string& spec) {
+    auto parameters = database->getSearchParameters().with(spec);
+    if (!parameters) {
+        std::cerr << "[Config] Invalid search parameters '" << spec << "' (e.g. k1=1.2,name_weight=3,max_postings=0)" << std::endl;
+        return false;
+    }
+    database->setSearchParameters(*parameters);
+    std::cout << "[Config] Search ranking: " << parameters->toString() << std::endl;
+    return true;
+}
+
+bool ApiServer::setIntentModel(const std::string& path) {
+    return llmInterface->loadIntentModel(path);
+}
+
+void ApiServer::setLLMDeadline(int milliseconds) {
+    llmDeadlineMs = std::max(1000, milliseconds);
+    std::cout << "[Config] LLM request deadline: " << llmDeadlineMs << " ms" << std::endl;
+}
+
 // Getters
 int ApiServer::getPort() const {
     return port;
@@ -685,3 +1496,19 @@ int ApiServer::getPort() const {
 bool ApiServer::isUsingRealTimeApis() const {
     return useRealTimeApis;
 }
+
+int ApiServer::getLLMDeadline() const {
+    return llmDeadlineMs;
+}
+
+int ApiServer::getCatalogueThreads() const {
+    return catalogueThreads;
+}
+
+int ApiServer::getLLMThreads() const {
+    return llmThreads;
+}
+
+int ApiServer::getLLMQueueCapacity() const {
+    return llmQueueCapacity;
+}
@@ -0,0 +1,283 @@
+/**
+ * @file BasketOptimizer.cpp
+ * @brief Implementation of the price matrix and basket search
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "BasketOptimizer.h"
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <utility>
+
+namespace {
+
+// Cents; larger than any sum of real prices
+constexpr long long kNotCarried = std::numeric_limits<long long>::max();
+
+// Fewer missing products wins; then the lower cost
+bool better(size_t missingA, long long costA, size_t missingB, long long costB) {
+    return missingA < missingB || (missingA == missingB && costA < costB);
+}
+
+bool better(size_t missingA, Money costA, size_t missingB, Money costB) {
+    return better(missingA, costA.cents(), missingB, costB.cents());
+}
+
+Money tripCostOf(const BasketOptimizer::Options& options, size_t store) {
+    return store < options.tripCosts.size() ? std::max(Money(), options.tripCosts[store]) : Money();
+}
+
+// Buy every product at the cheapest of the given stores; stores left unused are dropped
+BasketPlan planFor(const PriceMatrix& matrix, const std::vector<size_t>& stores, const BasketOptimizer::Options& options) {
+    BasketPlan plan;
+    plan.storeOf.assign(matrix.productCount(), -1);
+    std::vector<bool> used(matrix.storeCount(), false);
+
+    for (size_t product = 0; product < matrix.productCount(); product++) {
+        int bestStore = -1;
+        for (size_t store : stores) {
+            if (matrix.carries(product, store) &&
+                (bestStore < 0 || matrix.price(product, store) < matrix.price(product, static_cast<size_t>(bestStore)))) {
+                bestStore = static_cast<int>(store);
+            }
+        }
+        plan.storeOf[product] = bestStore;
+        if (bestStore < 0) {
+            plan.missing++;
+        } else {
+            plan.itemCost += matrix.price(product, static_cast<size_t>(bestStore));
+            used[bestStore] = true;
+        }
+    }
+
+    for (size_t store : stores) {
+        if (used[store]) {
+            plan.stores.push_back(store);
+            plan.tripCost += tripCostOf(options, store);
+        }
+    }
+    return plan;
+}
+
+/**
+ * Depth-first enumeration of store subsets (in a fixed store order) with
+ * branch-and-bound. minima holds one row of per-product best prices per
+ * depth; suffix holds, for each position, the per-product minimum over that
+ * store and every later one.
+ */
+struct SubsetSearch {
+    size_t products;
+    size_t stores;
+    size_t maxStores;
+    size_t nodeBudget;
+    const std::vector<long long>& prices;   // Cents, stores x products, in search order
+    const std::vector<long long>& suffix;   // (stores + 1) x products
+    const std::vector<long long>& trips;    // Per search position
+
+    std::vector<long long> minima;
+    std::vector<size_t> chosen;
+    std::vector<size_t> bestChosen;
+    size_t bestMissing = std::numeric_limits<size_t>::max();
+    long long bestCost = kNotCarried;
+    size_t nodes = 0;
+    bool exhausted = false;
+
+    SubsetSearch(size_t products, size_t stores, size_t maxStores, size_t nodeBudget,
+                 const std::vector<long long>& prices, const std::vector<long long>& suffix, const std::vector<long long>& trips)
+        : products(products), stores(stores), maxStores(maxStores), nodeBudget(nodeBudget),
+          prices(prices), suffix(suffix), trips(trips), minima((maxStores + 1) * products, kNotCarried) {}
+
+    // Lower bound when every store from position onwards is added to current
+    std::pair<size_t, long long> bound(const long long* current, size_t position, long long tripTotal) const {
+        const long long* rest = &suffix[position * products];
+        size_t missing = 0;
+        long long cost = tripTotal;
+        for (size_t p = 0; p < products; p++) {
+            long long value = std::min(current[p], rest[p]);
+            if (value == kNotCarried) missing++; else cost += value;
+        }
+        return {missing, cost};
+    }
+
+    void search(size_t from, size_t depth, long long tripTotal) {
+        const long long* current = &minima[depth * products];
+        long long* next = &minima[(depth + 1) * products];
+
+        for (size_t position = from; position < stores; position++) {
+            // Later siblings only see fewer stores, so their bound is no better either
+            auto [boundMissing, boundCost] = bound(current, position, tripTotal);
+            if (!better(boundMissing, boundCost, bestMissing, bestCost)) {
+                return;
+            }
+            if (nodes++ >= nodeBudget) {
+                exhausted = true;
+                return;
+            }
+
+            const long long* row = &prices[position * products];
+            const long long withTrip = tripTotal + trips[position];
+            size_t missing = 0;
+            long long cost = withTrip;
+            for (size_t p = 0; p < products; p++) {
+                next[p] = std::min(current[p], row[p]);
+                if (next[p] == kNotCarried) missing++; else cost += next[p];
+            }
+
+            chosen.push_back(position);
+            if (better(missing, cost, bestMissing, bestCost)) {
+                bestMissing = missing;
+                bestCost = cost;
+                bestChosen = chosen;
+            }
+            if (depth + 1 < maxStores && position + 1 < stores) {
+                search(position + 1, depth + 1, withTrip);
+            }
+            chosen.pop_back();
+            if (exhausted) {
+                return;
+            }
+        }
+    }
+};
+
+} // namespace
+
+// ==================== PriceMatrix ====================
+
+size_t PriceMatrix::addProduct(const std::string& label, const std::vector<Item>& candidates) {
+    // Latest observation of each item name at each store (ISO dates compare as strings)
+    std::map<std::pair<std::string, std::string>, const Item*> latest;
+    for (const auto& candidate : candidates) {
+        auto& slot = latest[{candidate.getStore(), candidate.getItemName()}];
+        if (slot == nullptr || candidate.getPriceDate() > slot->getPriceDate() ||
+            (candidate.getPriceDate() == slot->getPriceDate() && candidate.getCurrentPrice() < slot->getCurrentPrice())) {
+            slot = &candidate;
+        }
+    }
+
+    Product product;
+    product.label = label;
+    for (const auto& [key, item] : latest) {
+        auto [it, inserted] = storeIndexes.try_emplace(key.first, stores.size());
+        if (inserted) {
+            stores.push_back(key.first);
+        }
+        size_t store = it->second;
+        if (product.cells.size() <= store) {
+            product.cells.resize(store + 1, -1);
+        }
+
+        // Cheapest satisfying item name at this store
+        int& cell = product.cells[store];
+        if (cell < 0) {
+            cell = static_cast<int>(items.size());
+            items.push_back(*item);
+        } else if (item->getCurrentPrice() < items[cell].getCurrentPrice()) {
+            items[cell] = *item;
+        }
+    }
+
+    products.push_back(std::move(product));
+    return products.size() - 1;
+}
+
+PriceMatrix PriceMatrix::byItemName(const std::vector<Item>& items) {
+    std::map<std::string, std::vector<Item>> byName;
+    for (const auto& item : items) {
+        byName[item.getItemName()].push_back(item);
+    }
+
+    PriceMatrix matrix;
+    for (const auto& [name, rows] : byName) {
+        matrix.addProduct(name, rows);
+    }
+    return matrix;
+}
+
+int PriceMatrix::storeIndex(const std::string& name) const {
+    auto it = storeIndexes.find(name);
+    return it == storeIndexes.end() ? -1 : static_cast<int>(it->second);
+}
+
+bool PriceMatrix::carries(size_t product, size_t store) const {
+    const auto& cells = products[product].cells;
+    return store < cells.size() && cells[store] >= 0;
+}
+
+Money PriceMatrix::price(size_t product, size_t store) const {
+    return items[products[product].cells[store]].getCurrentPrice();
+}
+
+const Item& PriceMatrix::item(size_t product, size_t store) const {
+    return items[products[product].cells[store]];
+}
+
+// ==================== BasketOptimizer ====================
+
+BasketPlan BasketOptimizer::optimize(const PriceMatrix& matrix, const Options& options) {
+    const size_t productCount = matrix.productCount();
+    const size_t storeCount = matrix.storeCount();
+    if (productCount == 0 || storeCount == 0) {
+        return planFor(matrix, {}, options);
+    }
+    const size_t maxStores = options.maxStores <= 0 ? storeCount
+                                                    : std::min(storeCount, static_cast<size_t>(options.maxStores));
+
+    // Try the best stand-alone stores first so good plans are found early
+    std::vector<BasketPlan> alone;
+    for (size_t store = 0; store < storeCount; store++) {
+        alone.push_back(planFor(matrix, {store}, options));
+    }
+    std::vector<size_t> order(storeCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&alone](size_t a, size_t b) {
+        return better(alone[a].missing, alone[a].totalCost(), alone[b].missing, alone[b].totalCost());
+    });
+
+    // Dense store-major prices in search order, and their suffix minima
+    std::vector<long long> prices(storeCount * productCount, kNotCarried);
+    std::vector<long long> trips(storeCount);
+    for (size_t position = 0; position < storeCount; position++) {
+        size_t store = order[position];
+        trips[position] = tripCostOf(options, store).cents();
+        for (size_t product = 0; product < productCount; product++) {
+            if (matrix.carries(product, store)) {
+                prices[position * productCount + product] = matrix.price(product, store).cents();
+            }
+        }
+    }
+    std::vector<long long> suffix((storeCount + 1) * productCount, kNotCarried);
+    for (size_t position = storeCount; position-- > 0;) {
+        for (size_t product = 0; product < productCount; product++) {
+            suffix[position * productCount + product] = std::min(prices[position * productCount + product],
+                                                                 suffix[(position + 1) * productCount + product]);
+        }
+    }
+
+    SubsetSearch search(productCount, storeCount, maxStores, options.nodeBudget, prices, suffix, trips);
+    search.search(0, 0, 0);
+
+    std::vector<size_t> chosenStores;
+    for (size_t position : search.bestChosen) {
+        chosenStores.push_back(order[position]);
+    }
+    BasketPlan plan = planFor(matrix, chosenStores, options);
+    plan.exact = !search.exhausted;
+    return plan;
+}
+
+std::vector<BasketPlan> BasketOptimizer::singleStorePlans(const PriceMatrix& matrix, const Options& options) {
+    std::vector<BasketPlan> plans;
+    for (size_t store = 0; store < matrix.storeCount(); store++) {
+        plans.push_back(planFor(matrix, {store}, options));
+    }
+    std::stable_sort(plans.begin(), plans.end(), [](const BasketPlan& a, const BasketPlan& b) {
+        return better(a.missing, a.totalCost(), b.missing, b.totalCost());
+    });
+    return plans;
+}
@@ -0,0 +1,333 @@
+/**
+ * @file BudgetSolver.cpp
+ * @brief Implementation of the constraint parser and the budget knapsack
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "BudgetSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <cctype>
+#include <set>
+
+namespace {
+
+// Words before an amount that make it a budget ("under 40", "budget of $40", "up to 40")
+const std::set<std::string> kBudgetCues = {
+    "under", "below", "budget", "max", "maximum", "within", "than", "to", "spend", "spending", "cap"
+};
+// Words allowed between a budget cue and the amount
+const std::set<std::string> kBudgetFillers = {"of", "is", "about", "around", "only", "just", "a", "total"};
+// Words completing a cue: "less than", "no more than", "up to"
+const std::set<std::string> kCuePrefixes = {"less", "more", "no", "up", "not"};
+const std::set<std::string> kCurrencyWords = {"dollars", "dollar", "bucks", "buck", "cad", "usd"};
+// A cued amount without a currency mark is only a budget when it ends a phrase ("under 40 for a party"),
+// not when it counts something ("no more than 3 apples")
+const std::set<std::string> kAfterBudget = {
+    "for", "and", "at", "from", "in", "total", "overall", "please", "with", "on", "or", "including", "if", "per"
+};
+// An amount followed by one of these is a size or headcount, not money or an item count
+const std::set<std::string> kUnitWords = {
+    "lb", "lbs", "kg", "g", "oz", "ml", "l", "litre", "litres", "liter", "liters", "pound", "pounds",
+    "people", "guests", "persons", "kids", "adults", "servings", "days", "weeks", "calories",
+    "percent", "%", "pm", "am", "minutes", "hours"
+};
+// "2 bags of chips": the count belongs to the word after "of"
+const std::set<std::string> kContainerWords = {
+    "bag", "bags", "box", "boxes", "pack", "packs", "packet", "packets", "bottle", "bottles", "can", "cans",
+    "carton", "cartons", "jar", "jars", "loaf", "loaves", "bunch", "bunches", "case", "cases", "tub", "tubs"
+};
+// Sold in packs by count: "12 eggs" asks for a pack of twelve, not twelve packs (singular forms)
+const std::set<std::string> kCountPackaged = {
+    "egg", "bagel", "muffin", "roll", "bun", "tortilla", "croissant", "donut", "doughnut", "cookie",
+    "diaper", "wipe", "battery", "napkin", "plate", "cup", "straw", "candle", "sausage", "wiener"
+};
+const std::set<std::string> kStoreNegations = {"not", "no", "except", "avoid", "without", "skip", "excluding", "exclude"};
+const std::set<std::string> kStorePrepositions = {"at", "from", "in", "only", "but"};
+
+const std::pair<const char*, int> kNumberWords[] = {
+    {"one", 1}, {"two", 2}, {"three", 3}, {"four", 4}, {"five", 5}, {"six", 6},
+    {"seven", 7}, {"eight", 8}, {"nine", 9}, {"ten", 10}, {"eleven", 11}, {"twelve", 12}
+};
+
+std::string toLower(const std::string& text) {
+    std::string lower(text.size(), '\0');
+    std::transform(text.begin(), text.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return lower;
+}
+
+bool isWordChar(unsigned char c) {
+    return std::isalnum(c) || c == '$' || c == '.' || c == '%' || c == '\'' || c == '-';
+}
+
+// Lowercased words; sentence punctuation is dropped but "$40", "2.50" and "2%" stay whole
+std::vector<std::string> splitWords(const std::string& text) {
+    std::vector<std::string> words;
+    std::string lower = toLower(text);
+    size_t pos = 0;
+    while (pos < lower.size()) {
+        if (!isWordChar(static_cast<unsigned char>(lower[pos]))) {
+            pos++;
+            continue;
+        }
+        size_t start = pos;
+        while (pos < lower.size() && isWordChar(static_cast<unsigned char>(lower[pos]))) pos++;
+        std::string word = lower.substr(start, pos - start);
+        while (!word.empty() && (word.back() == '.' || word.back() == '-' || word.back() == '\'')) word.pop_back();
+        if (!word.empty()) words.push_back(word);
+    }
+    return words;
+}
+
+/// Parse "40", "$40", "40$", "$12.50" or a number word; currency is set when a '$' was attached
+bool parseAmount(const std::string& word, Money& value, bool& currency) {
+    std::string digits = word;
+    currency = false;
+    if (!digits.empty() && digits.front() == '$') { digits.erase(0, 1); currency = true; }
+    if (!digits.empty() && digits.back() == '$') { digits.pop_back(); currency = true; }
+    if (digits.empty()) return false;
+
+    if (!currency) {
+        for (const auto& [name, number] : kNumberWords) {
+            if (digits == name) {
+                value = Money::fromCents(number * 100LL);
+                return true;
+            }
+        }
+    }
+    bool seenDot = false;
+    for (char c : digits) {
+        if (c == '.' && !seenDot) seenDot = true;
+        else if (!std::isdigit(static_cast<unsigned char>(c))) return false;
+    }
+    auto parsed = Money::parse(digits);
+    if (!parsed) return false;
+    value = *parsed;
+    return true;
+}
+
+std::string singular(std::string word) {
+    while (!word.empty() && !std::isalpha(static_cast<unsigned char>(word.back()))) word.pop_back();
+    if (word.size() > 4 && word.compare(word.size() - 3, 3, "ies") == 0) return word.substr(0, word.size() - 3) + "y";
+    if (word.size() > 4 && (word.compare(word.size() - 4, 4, "ches") == 0 || word.compare(word.size() - 4, 4, "shes") == 0 ||
+                            word.compare(word.size() - 3, 3, "oes") == 0 || word.compare(word.size() - 3, 3, "xes") == 0)) {
+        return word.substr(0, word.size() - 2);
+    }
+    if (word.size() > 3 && word.back() == 's' && word[word.size() - 2] != 's') word.pop_back();
+    return word;
+}
+
+} // namespace
+
+// ==================== ShoppingConstraints ====================
+
+ShoppingConstraints ShoppingConstraints::parse(const std::string& request, const std::vector<std::string>& knownStores) {
+    ShoppingConstraints constraints;
+    std::vector<std::string> words = splitWords(request);
+    std::vector<bool> consumed(words.size(), false);
+    auto wordAt = [&words](size_t i) -> const std::string& {
+        static const std::string none;
+        return i < words.size() ? words[i] : none;
+    };
+
+    // Budget: an amount with a currency mark, or after a cue word
+    for (size_t i = 0; i < words.size(); i++) {
+        Money amount;
+        bool currency = false;
+        if (!parseAmount(words[i], amount, currency) || amount <= Money()) continue;
+
+        bool currencyWord = kCurrencyWords.count(wordAt(i + 1)) > 0;
+        size_t cue = i;
+        while (cue > 0 && cue + 2 >= i && kBudgetFillers.count(words[cue - 1])) cue--;
+        bool cued = cue > 0 && kBudgetCues.count(words[cue - 1]) > 0;
+        bool endsPhrase = i + 1 == words.size() || kAfterBudget.count(words[i + 1]) > 0;
+        if (!currency && !currencyWord && !(cued && endsPhrase)) {
+            continue;
+        }
+
+        constraints.budget = constraints.budget ? std::min(*constraints.budget, amount) : amount;
+        consumed[i] = true;
+        if (currencyWord) consumed[i + 1] = true;
+        if (cued) {
+            for (size_t j = cue - 1; j < i; j++) consumed[j] = true;
+            if (cue >= 2 && kCuePrefixes.count(words[cue - 2])) {
+                consumed[cue - 2] = true;
+                if (cue >= 3 && kCuePrefixes.count(words[cue - 3])) consumed[cue - 3] = true;
+            }
+        }
+    }
+
+    // Quantities: "3 pizzas", "two dozen eggs", "2 bags of chips"
+    for (size_t i = 0; i < words.size(); i++) {
+        Money amount;
+        bool currency = false;
+        if (consumed[i] || !parseAmount(words[i], amount, currency) || currency) continue;
+        if (amount.cents() < 100 || amount.cents() > 9900 || amount.cents() % 100 != 0) continue;
+
+        int count = static_cast<int>(amount.cents() / 100);
+        size_t item = i + 1;
+        bool packs = false;
+        if (wordAt(item) == "dozen") {
+            item++;   // Products come in packs; "2 dozen eggs" is two packs, not 24 items
+            packs = true;
+        }
+        if (kContainerWords.count(wordAt(item)) && wordAt(item + 1) == "of") {
+            // "a 12 pack of pop" is one pack of twelve; "2 packs of gum" is two packs
+            if (wordAt(item) == "pack" && count > 1) continue;
+            item += 2;
+            packs = true;
+        }
+        const std::string& product = wordAt(item);
+        if (product.empty() || kUnitWords.count(product) || kCurrencyWords.count(product) ||
+            !std::isalpha(static_cast<unsigned char>(product.front()))) {
+            continue;
+        }
+        // A bare count of a pack-sold product is its pack size, left in the search text
+        if (!packs && kCountPackaged.count(singular(product))) {
+            continue;
+        }
+        constraints.quantities.push_back({singular(product), count});
+        consumed[i] = true;
+    }
+
+    // Stores: "at Walmart", "only Loblaws", "not Costco"
+    for (const auto& store : knownStores) {
+        std::string lowerStore = toLower(store);
+        for (size_t i = 0; i < words.size(); i++) {
+            std::string word = words[i];
+            if (word.size() > 2 && word.compare(word.size() - 2, 2, "'s") == 0) word.resize(word.size() - 2);
+            if (word != lowerStore) continue;
+
+            bool negated = false;
+            consumed[i] = true;
+            for (size_t back = 1; back <= 2 && back <= i; back++) {
+                const std::string& before = words[i - back];
+                if (kStoreNegations.count(before)) {
+                    negated = true;
+                    consumed[i - back] = true;
+                } else if (kStorePrepositions.count(before)) {
+                    consumed[i - back] = true;
+                } else {
+                    break;
+                }
+            }
+            auto& list = negated ? constraints.excludedStores : constraints.stores;
+            if (std::find(list.begin(), list.end(), store) == list.end()) {
+                list.push_back(store);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < words.size(); i++) {
+        if (consumed[i]) continue;
+        if (!constraints.remainder.empty()) constraints.remainder += " ";
+        constraints.remainder += words[i];
+    }
+    return constraints;
+}
+
+int ShoppingConstraints::quantityFor(const std::string& term) const {
+    if (quantities.empty()) {
+        return 1;
+    }
+    for (const auto& word : splitWords(term)) {
+        std::string key = singular(word);
+        for (const auto& [product, count] : quantities) {
+            if (product == key) {
+                return count;
+            }
+        }
+    }
+    return 1;
+}
+
+bool ShoppingConstraints::allowsStore(const std::string& store) const {
+    std::string lower = toLower(store);
+    auto listed = [&lower](const std::vector<std::string>& list) {
+        return std::any_of(list.begin(), list.end(), [&lower](const std::string& s) { return toLower(s) == lower; });
+    };
+    return !listed(excludedStores) && (stores.empty() || listed(stores));
+}
+
+// ==================== BudgetSolver ====================
+
+namespace {
+
+/// Lexicographic objective; every part is additive, so the DP stays exact
+struct Score {
+    size_t covered = 0;
+    double relevance = 0.0;
+    long long cents = 0;
+
+    // Relevance only breaks ties between lists of equal cost
+    bool betterThan(const Score& other) const {
+        if (covered != other.covered) return covered > other.covered;
+        if (cents != other.cents) return cents < other.cents;
+        return relevance > other.relevance + 1e-9;
+    }
+};
+
+long long optionCents(const Item& item, int quantity) {
+    return item.getCurrentPrice().cents() * std::max(1, quantity);
+}
+
+} // namespace
+
+BudgetSolver::Selection BudgetSolver::solve(const std::vector<Group>& groups, Money budget) {
+    Selection selection;
+    selection.choice.assign(groups.size(), -1);
+    const long long budgetCents = budget.cents();
+    if (budgetCents <= 0 || groups.empty()) {
+        return selection;
+    }
+
+    // One DP cell per unit; prices are rounded up to whole units so the list never exceeds the budget
+    const long long unit = std::max<long long>(1, (budgetCents + kMaxCells - 1) / static_cast<long long>(kMaxCells));
+    const size_t capacity = static_cast<size_t>(budgetCents / unit);
+    auto weightOf = [unit](long long cents) { return static_cast<size_t>((cents + unit - 1) / unit); };
+
+    // best[w]: best score over the groups so far using at most w units
+    std::vector<Score> best(capacity + 1), next;
+    std::vector<int> choices(groups.size() * (capacity + 1), -1);
+
+    for (size_t g = 0; g < groups.size(); g++) {
+        const Group& group = groups[g];
+        next = best;   // Leaving the group out
+        int* chosen = &choices[g * (capacity + 1)];
+
+        for (size_t o = 0; o < group.options.size(); o++) {
+            const long long cents = optionCents(group.options[o], group.quantity);
+            const size_t weight = weightOf(cents);
+            if (weight > capacity) continue;
+            const double relevance = 1.0 / (1.0 + o);   // Options arrive best match first
+
+            for (size_t w = weight; w <= capacity; w++) {
+                Score candidate = best[w - weight];
+                candidate.covered++;
+                candidate.relevance += relevance;
+                candidate.cents += cents;
+                if (candidate.betterThan(next[w])) {
+                    next[w] = candidate;
+                    chosen[w] = static_cast<int>(o);
+                }
+            }
+        }
+        best.swap(next);
+    }
+
+    size_t w = capacity;
+    for (size_t g = groups.size(); g-- > 0;) {
+        int o = choices[g * (capacity + 1) + w];
+        if (o < 0) continue;
+        const long long cents = optionCents(groups[g].options[o], groups[g].quantity);
+        selection.choice[g] = o;
+        selection.covered++;
+        selection.totalCost += Money::fromCents(cents);
+        w -= weightOf(cents);
+    }
+    return selection;
+}
@@ -1,12 +1,113 @@
 #include "Database.h"
+#include "Metrics.h"
+#include "RequestContext.h"
+#include "ScanPool.h"
+#include "TextSearch.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <algorithm>
-#include <set>
+#include <cctype>
+#include <cstdio>
+#include <limits>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
+
+namespace {
+
+// Latency histogram for one Database query method
+Histogram& queryLatency(const char* method) {
+    return MetricsRegistry::instance().histogram(
+        "budgeteer_db_query_duration_seconds", "Latency of Database query methods",
+        {{"method", method}});
+}
+
+// Days since 1970-01-01 of a proleptic Gregorian date (Howard Hinnant's days_from_civil)
+int32_t daysFromCivil(int year, int month, int day) {
+    year -= month <= 2;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const int yearOfEra = year - era * 400;
+    const int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+// "YYYY-MM-DD" for a day count
+std::string formatIsoDay(int32_t days) {
+    days += 719468;
+    const int era = (days >= 0 ? days : days - 146096) / 146097;
+    const int dayOfEra = days - era * 146097;
+    const int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const int shiftedMonth = (5 * dayOfYear + 2) / 153;
+    const int day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    const int month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+    const int year = yearOfEra + era * 400 + (month <= 2);
+
+    char text[48];
+    std::snprintf(text, sizeof(text), "%04d-%02d-%02d", year, month, day);
+    return text;
+}
+
+// Day count of an ISO date; nullopt for anything that does not format back to the same text
+std::optional<int32_t> parseIsoDay(const std::string& text) {
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-') {
+        return std::nullopt;
+    }
+    int parts[3] = {0, 0, 0};
+    const size_t starts[3] = {0, 5, 8};
+    const size_t lengths[3] = {4, 2, 2};
+    for (int part = 0; part < 3; part++) {
+        for (size_t i = starts[part]; i < starts[part] + lengths[part]; i++) {
+            if (!std::isdigit(static_cast<unsigned char>(text[i]))) return std::nullopt;
+            parts[part] = parts[part] * 10 + (text[i] - '0');
+        }
+    }
+    if (parts[1] < 1 || parts[1] > 12 || parts[2] < 1 || parts[2] > 31) {
+        return std::nullopt;
+    }
+    int32_t days = daysFromCivil(parts[0], parts[1], parts[2]);
+    if (formatIsoDay(days) != text) {
+        return std::nullopt;   // e.g. 2023-02-30
+    }
+    return days;
+}
+
+// Search ranking and scan parameters
+constexpr double kMinScoreThreshold = 15.0;   // Similarity scan: products scoring this or less are not results
+constexpr size_t kMaxResults = 50;            // Rows returned, for token efficiency
+constexpr size_t kScanMorselSize = 1024;      // Products claimed at a time by a scan thread
+constexpr size_t kParallelScanMinProducts = 8192;   // Below this, thread hand-off costs more than it saves
+
+using ScoredProduct = SearchIndex::Hit;
+
+// Highest score first; equal scores keep catalogue order
+bool rankedBefore(const ScoredProduct& a, const ScoredProduct& b) {
+    return a.score > b.score || (a.score == b.score && a.document < b.document);
+}
+
+// Per-thread scan totals, on separate cache lines
+struct alignas(64) ScanShard {
+    size_t size = 0;              // Products in this worker's top-k
+    size_t candidateRows = 0;
+};
+
+// Counts the searches running at once, including this one
+struct InFlight {
+    std::atomic<size_t>& searches;
+    size_t count;
+    explicit InFlight(std::atomic<size_t>& running) : searches(running), count(running.fetch_add(1) + 1) {}
+    ~InFlight() { searches.fetch_sub(1); }
+};
+
+} // namespace
 
 // Constructor
-Database::Database(const std::string& filePath) : csvFilePath(filePath) {}
+Database::Database(const std::string& filePath)
+    : storeDictionary(std::numeric_limits<uint16_t>::max() + size_t{1}),
+      categoryDictionary(std::numeric_limits<uint16_t>::max() + size_t{1}),
+      csvFilePath(filePath) {}
 
 // Helper function to split string by delimiter
 std::vector<std::string> Database::splitString(const std::string& str, char delimiter) const {
@@ -38,6 +139,13 @@ bool Database::loadFromCSV() {
         return false;
     }
     
+    products.clear();
+    observations.clear();
+    storeDictionary.clear();
+    categoryDictionary.clear();
+    productsByItemId.clear();
+    std::unordered_map<std::string, uint32_t> productIndexes;
+    
     std::string line;
     bool isFirstLine = true;
     
@@ -73,19 +181,39 @@ bool Database::loadFromCSV() {
         }
         
         try {
-            // Create Item object
             int itemId = std::stoi(fields[0]);
-            std::string itemName = fields[1];
-            std::string itemDescription = fields[2];
-            double currentPrice = std::stod(fields[3]);
-            std::string store = fields[4];
-            std::vector<std::string> categoryTags = parseCategories(fields[5]);
-            std::string imageUrl = fields[6];
-            std::string priceDate = fields[7];
+            std::optional<Money> currentPrice = Money::parse(fields[3]);
+            if (!currentPrice || currentPrice->cents() < std::numeric_limits<int32_t>::min() ||
+                currentPrice->cents() > std::numeric_limits<int32_t>::max()) {
+                throw std::invalid_argument("invalid price '" + fields[3] + "'");
+            }
+            std::optional<int32_t> day = parseIsoDay(fields[7]);
+            if (!day) {
+                throw std::invalid_argument("invalid price date '" + fields[7] + "'");
+            }
+            uint16_t store = static_cast<uint16_t>(storeDictionary.intern(fields[4]));
             
-            Item item(itemId, itemName, itemDescription, currentPrice, 
-                     store, categoryTags, imageUrl, priceDate);
-            items.push_back(item);
+            // Rows of one product repeat every descriptive field
+            std::string key = fields[0] + '\x1f' + fields[1] + '\x1f' + fields[2] + '\x1f' + fields[5] + '\x1f' + fields[6];
+            auto [product, inserted] = productIndexes.try_emplace(std::move(key), static_cast<uint32_t>(products.size()));
+            if (inserted) {
+                Product entry;
+                entry.itemId = itemId;
+                entry.name = fields[1];
+                entry.description = fields[2];
+                entry.imageUrl = fields[6];
+                for (const auto& tag : parseCategories(fields[5])) {
+                    uint16_t category = static_cast<uint16_t>(categoryDictionary.intern(tag));
+                    entry.tags.push_back(category);
+                    if (category < kMaxCategories) {
+                        entry.tagSet.set(category);
+                    }
+                }
+                productsByItemId[itemId].push_back(product->second);
+                products.push_back(std::move(entry));
+            }
+            
+            observations.push_back({product->second, *day, static_cast<int32_t>(currentPrice->cents()), store});
             
         } catch (const std::exception& e) {
             std::cerr << "Warning: Error parsing line: " << e.what() << std::endl;
@@ -93,94 +221,239 @@ bool Database::loadFromCSV() {
     }
     
     file.close();
-    std::cout << "Successfully loaded " << items.size() << " items from database." << std::endl;
+    
+    // Group observations by product, keeping file order within each product
+    std::stable_sort(observations.begin(), observations.end(), [](const Observation& a, const Observation& b) {
+        return a.product < b.product;
+    });
+    for (size_t i = 0; i < observations.size(); i++) {
+        Product& product = products[observations[i].product];
+        if (product.observationCount++ == 0) {
+            product.firstObservation = static_cast<uint32_t>(i);
+        }
+    }
+    observations.shrink_to_fit();
+    sortedStores = storeDictionary.sortedNames();
+    sortedCategories = categoryDictionary.sortedNames();
+    
+    std::vector<Item> items;
+    items.reserve(observations.size());
+    for (const auto& product : products) {
+        appendObservations(product, items);
+    }
+    priceTable.build(items);
+    
+    std::vector<std::string> foldedNames, foldedDescriptions;
+    foldedNames.reserve(products.size());
+    foldedDescriptions.reserve(products.size());
+    for (const auto& product : products) {
+        foldedNames.push_back(TextSearch::fold(product.name));
+        foldedDescriptions.push_back(TextSearch::fold(product.description));
+    }
+    searchIndex.build(std::move(foldedNames), std::move(foldedDescriptions));
+    
+    std::cout << "Successfully loaded " << observations.size() << " items (" << products.size()
+              << " products) from database." << std::endl;
     return true;
 }
 
+// Materialize one price observation with its product's fields
+Item Database::itemAt(const Observation& observation) const {
+    const Product& product = products[observation.product];
+    std::vector<std::string> tags;
+    tags.reserve(product.tags.size());
+    for (uint16_t tag : product.tags) {
+        tags.push_back(categoryDictionary.name(tag));
+    }
+    return Item(product.itemId, product.name, product.description, Money::fromCents(observation.cents),
+                storeDictionary.name(observation.store), tags, product.imageUrl, formatIsoDay(observation.day));
+}
+
+void Database::appendObservations(const Product& product, std::vector<Item>& result) const {
+    for (uint32_t i = 0; i < product.observationCount; i++) {
+        result.push_back(itemAt(observations[product.firstObservation + i]));
+    }
+}
+
 // Get total item count
 int Database::getItemCount() const {
-    return static_cast<int>(items.size());
+    return static_cast<int>(observations.size());
 }
 
 // Query methods
 std::vector<Item> Database::getAllItems() const {
-    return items;
+    static Histogram& latency = queryLatency("getAllItems");
+    ScopedTimer timer(latency);
+    
+    std::vector<Item> result;
+    result.reserve(observations.size());
+    for (const auto& observation : observations) {
+        result.push_back(itemAt(observation));
+    }
+    return result;
 }
 
 std::vector<Item> Database::getItemById(int itemId) const {
+    static Histogram& latency = queryLatency("getItemById");
+    ScopedTimer timer(latency);
+    
     std::vector<Item> result;
-    for (const auto& item : items) {
-        if (item.getItemId() == itemId) {
-            result.push_back(item);
+    auto it = productsByItemId.find(itemId);
+    if (it != productsByItemId.end()) {
+        for (uint32_t product : it->second) {
+            appendObservations(products[product], result);
         }
     }
     return result;
 }
 
 std::vector<Item> Database::getItemsByName(const std::string& name) const {
+    static Histogram& latency = queryLatency("getItemsByName");
+    ScopedTimer timer(latency);
+    
     std::vector<Item> result;
-    for (const auto& item : items) {
-        if (item.getItemName().find(name) != std::string::npos) {
-            result.push_back(item);
+    for (const auto& product : products) {
+        if (product.name.find(name) != std::string::npos) {
+            appendObservations(product, result);
+        }
+    }
+    return result;
+}
+
+std::vector<Item> Database::getItemsByExactName(const std::string& name) const {
+    static Histogram& latency = queryLatency("getItemsByExactName");
+    ScopedTimer timer(latency);
+    
+    // The search index already holds every product name folded
+    const std::string folded = TextSearch::fold(name);
+    std::vector<Item> result;
+    for (uint32_t i = 0; i < products.size(); i++) {
+        if (searchIndex.name(i) == folded) {
+            appendObservations(products[i], result);
         }
     }
     return result;
 }
 
 std::vector<Item> Database::getItemsByStore(const std::string& store) const {
+    static Histogram& latency = queryLatency("getItemsByStore");
+    ScopedTimer timer(latency);
+    
     std::vector<Item> result;
-    for (const auto& item : items) {
-        if (item.getStore() == store) {
-            result.push_back(item);
+    const int storeId = storeDictionary.find(store);
+    if (storeId < 0) {
+        return result;
+    }
+    const uint16_t storeIndex = static_cast<uint16_t>(storeId);
+    for (const auto& observation : observations) {
+        if (observation.store == storeIndex) {
+            result.push_back(itemAt(observation));
         }
     }
     return result;
 }
 
 std::vector<Item> Database::getItemsByCategory(const std::string& category) const {
+    static Histogram& latency = queryLatency("getItemsByCategory");
+    ScopedTimer timer(latency);
+    
+    const int tag = categoryDictionary.find(category);
+    if (tag < 0) {
+        return {};
+    }
+    CategorySet mask;
+    std::vector<uint16_t> unmasked;
+    if (static_cast<size_t>(tag) < kMaxCategories) {
+        mask.set(static_cast<size_t>(tag));
+    } else {
+        unmasked.push_back(static_cast<uint16_t>(tag));
+    }
+    return itemsWithCategories(mask, unmasked, true);
+}
+
+std::vector<Item> Database::getItemsByCategories(const std::vector<std::string>& categories, bool matchAll) const {
+    static Histogram& latency = queryLatency("getItemsByCategories");
+    ScopedTimer timer(latency);
+    
+    // Unknown categories match nothing: no product has all of them, and they add nothing to "any"
+    CategorySet mask;
+    std::vector<uint16_t> unmasked;
+    for (const auto& category : categories) {
+        const int tag = categoryDictionary.find(category);
+        if (tag < 0) {
+            if (matchAll) {
+                return {};
+            }
+        } else if (static_cast<size_t>(tag) < kMaxCategories) {
+            mask.set(static_cast<size_t>(tag));
+        } else {
+            unmasked.push_back(static_cast<uint16_t>(tag));
+        }
+    }
+    if (mask.none() && unmasked.empty()) {
+        return {};
+    }
+    return itemsWithCategories(mask, unmasked, matchAll);
+}
+
+// Products whose tags contain every bit of mask and every unmasked id (matchAll), or any of them
+std::vector<Item> Database::itemsWithCategories(const CategorySet& mask, const std::vector<uint16_t>& unmasked,
+                                                bool matchAll) const {
     std::vector<Item> result;
-    for (const auto& item : items) {
-        if (item.hasCategory(category)) {
-            result.push_back(item);
+    for (const auto& product : products) {
+        const CategorySet common = product.tagSet & mask;
+        auto hasTag = [&product](uint16_t tag) {
+            return std::find(product.tags.begin(), product.tags.end(), tag) != product.tags.end();
+        };
+        const bool matches = matchAll
+            ? common == mask && std::all_of(unmasked.begin(), unmasked.end(), hasTag)
+            : common.any() || std::any_of(unmasked.begin(), unmasked.end(), hasTag);
+        if (matches) {
+            appendObservations(product, result);
         }
     }
     return result;
 }
 
-std::vector<Item> Database::getItemsByPriceRange(double minPrice, double maxPrice) const {
+std::vector<Item> Database::getItemsByPriceRange(Money minPrice, Money maxPrice) const {
+    static Histogram& latency = queryLatency("getItemsByPriceRange");
+    ScopedTimer timer(latency);
+    
     std::vector<Item> result;
-    for (const auto& item : items) {
-        double price = item.getCurrentPrice();
-        if (price >= minPrice && price <= maxPrice) {
-            result.push_back(item);
+    for (const auto& observation : observations) {
+        if (observation.cents >= minPrice.cents() && observation.cents <= maxPrice.cents()) {
+            result.push_back(itemAt(observation));
         }
     }
     return result;
 }
 
 // Calculate Levenshtein distance for string similarity
-int Database::calculateLevenshteinDistance(const std::string& s1, const std::string& s2) const {
+int Database::calculateLevenshteinDistance(std::string_view s1, std::string_view s2) const {
     const size_t len1 = s1.size(), len2 = s2.size();
-    std::vector<std::vector<int>> d(len1 + 1, std::vector<int>(len2 + 1));
-
-    d[0][0] = 0;
-    for(size_t i = 1; i <= len1; ++i) d[i][0] = i;
-    for(size_t i = 1; i <= len2; ++i) d[0][i] = i;
+    // One row of the DP table, reused across calls so scoring never allocates
+    thread_local std::vector<int> row;
+    row.resize(len2 + 1);
+    for(size_t j = 0; j <= len2; ++j) row[j] = static_cast<int>(j);
 
     for(size_t i = 1; i <= len1; ++i) {
+        int diagonal = row[0];
+        row[0] = static_cast<int>(i);
         for(size_t j = 1; j <= len2; ++j) {
-            d[i][j] = std::min({
-                d[i - 1][j] + 1,
-                d[i][j - 1] + 1,
-                d[i - 1][j - 1] + (s1[i - 1] == s2[j - 1] ? 0 : 1)
+            const int above = row[j];
+            row[j] = std::min({
+                above + 1,
+                row[j - 1] + 1,
+                diagonal + (s1[i - 1] == s2[j - 1] ? 0 : 1)
             });
+            diagonal = above;
         }
     }
-    return d[len1][len2];
+    return row[len2];
 }
 
 // Calculate similarity score (0.0 to 1.0, higher is more similar)
-double Database::calculateSimilarity(const std::string& s1, const std::string& s2) const {
+double Database::calculateSimilarity(std::string_view s1, std::string_view s2) const {
     if (s1.empty() || s2.empty()) return 0.0;
     
     int distance = calculateLevenshteinDistance(s1, s2);
@@ -189,95 +462,43 @@ double Database::calculateSimilarity(const std::string& s1, const std::string& s
     return 1.0 - (static_cast<double>(distance) / static_cast<double>(maxLen));
 }
 
-// Check if text contains word (case-insensitive)
-bool Database::containsWord(const std::string& text, const std::string& word) const {
-    std::string lowerText = text;
-    std::string lowerWord = word;
-    std::transform(lowerText.begin(), lowerText.end(), lowerText.begin(), ::tolower);
-    std::transform(lowerWord.begin(), lowerWord.end(), lowerWord.begin(), ::tolower);
-    
-    // Check for whole word match or partial match
-    return lowerText.find(lowerWord) != std::string::npos;
-}
-
 std::vector<Item> Database::searchItems(const std::string& searchTerm) const {
-    if (searchTerm.empty()) return {};
-    
-    std::vector<std::pair<Item, double>> scoredItems;
-    std::string lowerSearchTerm = searchTerm;
-    std::transform(lowerSearchTerm.begin(), lowerSearchTerm.end(), 
-                   lowerSearchTerm.begin(), ::tolower);
-    
-    // Split search term into words
-    std::vector<std::string> searchWords = splitString(searchTerm, ' ');
-    
-    // OPTIMIZATION: Use a score threshold to filter early
-    const double MIN_SCORE_THRESHOLD = 15.0;
-    const int MAX_RESULTS = 50;  // Limit results for token efficiency
-    
-    for (const auto& item : items) {
-        double score = 0.0;
-        std::string itemName = item.getItemName();
-        std::string itemDesc = item.getItemDescription();
-        std::string lowerName = itemName;
-        std::string lowerDesc = itemDesc;
-        
-        std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
-        std::transform(lowerDesc.begin(), lowerDesc.end(), lowerDesc.begin(), ::tolower);
-        
-        // OPTIMIZATION 1: Exact/prefix match gets massive boost (helps with "flour", "sugar", etc.)
-        if (lowerName == lowerSearchTerm) {
-            score += 200.0;  // Perfect match
-        } else if (lowerName.find(lowerSearchTerm + " ") == 0 || 
-                   lowerName.find(lowerSearchTerm + " (") == 0) {
-            score += 150.0;  // Starts with search term (e.g., "Flour (5kg)")
-        } else if (lowerName.find(lowerSearchTerm) != std::string::npos) {
-            score += 100.0;  // Contains search term
-        }
-        
-        // Exact match in description (lower priority)
-        if (lowerDesc.find(lowerSearchTerm) != std::string::npos) {
-            score += 40.0;
-        }
-        
-        // OPTIMIZATION 2: Only calculate expensive similarity if we don't have a good match yet
-        if (score < 100.0) {
-            // Calculate similarity score for the full name
-            double nameSimilarity = calculateSimilarity(lowerSearchTerm, lowerName);
-            score += nameSimilarity * 60.0;
-        }
-        
-        // Check individual words for partial matches
-        for (const auto& word : searchWords) {
-            if (word.length() >= 3) {  // Only check words with 3+ characters
-                if (containsWord(itemName, word)) {
-                    score += 25.0;
-                }
-                if (containsWord(itemDesc, word)) {
-                    score += 10.0;
-                }
-            }
-        }
-        
-        // OPTIMIZATION 3: Early filtering - only keep items above threshold
-        if (score > MIN_SCORE_THRESHOLD) {
-            scoredItems.push_back({item, score});
-        }
-    }
+    static Histogram& latency = queryLatency("searchItems");
+    ScopedTimer timer(latency);
+    
+    // Temporaries come from the request's arena when one is active
+    std::pmr::memory_resource* memory = RequestContext::memory();
+    
+    // The query is folded once; product names were folded at load time
+    const std::pmr::string foldedQuery = TextSearch::fold(searchTerm, memory);
+    const std::string_view query = foldedQuery;
+    if (query.empty()) return {};
     
-    // Sort by score (highest first)
-    std::sort(scoredItems.begin(), scoredItems.end(),
-              [](const auto& a, const auto& b) {
-                  return a.second > b.second;
-              });
+    // Ranked by the BM25F index, which stops once the top products are settled
+    SearchIndex::Stats stats;
+    std::pmr::vector<ScoredProduct> ranked = searchIndex.topK(query, kMaxResults, memory, &stats);
+    static Histogram& postingsVisited = MetricsRegistry::instance().histogram(
+        "budgeteer_search_postings_visited", "Index postings read per query",
+        {}, 1.0, Histogram::sizeBounds());
+    static Histogram& productsScored = MetricsRegistry::instance().histogram(
+        "budgeteer_search_products_scored", "Products scored by the index per query",
+        {}, 1.0, Histogram::sizeBounds());
+    postingsVisited.record(stats.postingsVisited);
+    productsScored.record(stats.documentsScored);
+    
+    // No indexed term resembles the query: fall back to name similarity over every product
+    if (ranked.empty()) {
+        ranked = scanProducts(query, memory);
+    }
     
     // OPTIMIZATION 4: Limit results to top MAX_RESULTS for token efficiency
     std::vector<Item> result;
-    int count = 0;
-    for (const auto& pair : scoredItems) {
-        result.push_back(pair.first);
-        count++;
-        if (count >= MAX_RESULTS) {
+    for (const auto& scored : ranked) {
+        const Product& product = products[scored.document];
+        for (uint32_t i = 0; i < product.observationCount && result.size() < kMaxResults; i++) {
+            result.push_back(itemAt(observations[product.firstObservation + i]));
+        }
+        if (result.size() >= kMaxResults) {
             break;
         }
     }
@@ -285,57 +506,188 @@ std::vector<Item> Database::searchItems(const std::string& searchTerm) const {
     return result;
 }
 
-// Statistics methods
-double Database::getAveragePrice(int itemId) const {
-    auto itemList = getItemById(itemId);
-    if (itemList.empty()) return 0.0;
+std::pmr::vector<SearchIndex::Hit> Database::scanProducts(std::string_view query, std::pmr::memory_resource* memory) const {
+    // Split search term into words (only words with 3+ characters are checked)
+    std::pmr::vector<std::string_view> searchWords(memory);
+    for (size_t start = 0; start < query.size();) {
+        size_t end = std::min(query.find(' ', start), query.size());
+        if (end - start >= 3) {
+            searchWords.push_back(query.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+    
+    // Small catalogues, and busy periods when other searches already hold
+    // the cores, are scanned on this thread alone
+    InFlight inFlight(searchesInFlight);
+    ScanPool& pool = scanPool ? *scanPool : ScanPool::shared();
+    size_t maxWorkers = 1;
+    if (products.size() >= kParallelScanMinProducts) {
+        maxWorkers = std::max<size_t>(1, (pool.getHelperCount() + 1) / inFlight.count);
+    }
+    
+    // Each worker keeps its own top MAX_RESULTS products in a slice of one
+    // buffer; every product has at least one row, so that covers the result
+    std::pmr::vector<ScoredProduct> best(maxWorkers * kMaxResults, memory);
+    std::pmr::vector<ScanShard> shards(maxWorkers, memory);
+    
+    // Every row of a product scores the same, so products are scored once
+    size_t threads = pool.parallelFor(products.size(), kScanMorselSize, maxWorkers,
+                                      [&](size_t worker, size_t begin, size_t end) {
+        ScoredProduct* heap = best.data() + worker * kMaxResults;
+        ScanShard& shard = shards[worker];
+        for (size_t index = begin; index < end; index++) {
+            double score = scoreProduct(static_cast<uint32_t>(index), query, searchWords);
+            
+            // OPTIMIZATION 3: Early filtering - only keep items above threshold
+            if (score <= kMinScoreThreshold) {
+                continue;
+            }
+            shard.candidateRows += products[index].observationCount;
+            ScoredProduct scored{static_cast<uint32_t>(index), score};
+            if (shard.size < kMaxResults) {
+                heap[shard.size++] = scored;
+                std::push_heap(heap, heap + shard.size, rankedBefore);
+            } else if (rankedBefore(scored, heap[0])) {
+                // Replace the worst of this worker's products
+                std::pop_heap(heap, heap + shard.size, rankedBefore);
+                heap[shard.size - 1] = scored;
+                std::push_heap(heap, heap + shard.size, rankedBefore);
+            }
+        }
+    });
     
-    double sum = 0.0;
-    for (const auto& item : itemList) {
-        sum += item.getCurrentPrice();
+    // Merge the workers' products, highest score first (ties in catalogue order)
+    std::pmr::vector<ScoredProduct> scoredProducts(memory);
+    size_t candidateRows = 0;
+    for (size_t worker = 0; worker < maxWorkers; worker++) {
+        const ScoredProduct* heap = best.data() + worker * kMaxResults;
+        scoredProducts.insert(scoredProducts.end(), heap, heap + shards[worker].size);
+        candidateRows += shards[worker].candidateRows;
     }
-    return sum / itemList.size();
+    std::sort(scoredProducts.begin(), scoredProducts.end(), rankedBefore);
+    
+    static Histogram& candidates = MetricsRegistry::instance().histogram(
+        "budgeteer_search_candidates", "Rows scoring above the similarity threshold per scanned query",
+        {}, 1.0, Histogram::sizeBounds());
+    candidates.record(candidateRows);
+    static Histogram& scanThreads = MetricsRegistry::instance().histogram(
+        "budgeteer_search_scan_threads", "Threads that scanned the catalogue per query",
+        {}, 1.0, Histogram::sizeBounds());
+    scanThreads.record(threads);
+    return scoredProducts;
 }
 
-double Database::getMinPrice(int itemId) const {
-    auto itemList = getItemById(itemId);
-    if (itemList.empty()) return 0.0;
+double Database::scoreProduct(uint32_t index, std::string_view query,
+                              const std::pmr::vector<std::string_view>& searchWords) const {
+    double score = 0.0;
+    const std::string& name = searchIndex.name(index);
+    const std::string& description = searchIndex.description(index);
+    
+    // OPTIMIZATION 1: Exact/prefix match gets massive boost (helps with "flour", "sugar", etc.)
+    if (name == query) {
+        score += 200.0;  // Perfect match
+    } else if (name.size() > query.size() && name[query.size()] == ' ' && name.compare(0, query.size(), query) == 0) {
+        score += 150.0;  // Starts with search term (e.g., "Flour (5kg)")
+    } else if (TextSearch::contains(name, query)) {
+        score += 100.0;  // Contains search term
+    }
+    
+    // Exact match in description (lower priority)
+    if (TextSearch::contains(description, query)) {
+        score += 40.0;
+    }
     
-    double minPrice = itemList[0].getCurrentPrice();
-    for (const auto& item : itemList) {
-        if (item.getCurrentPrice() < minPrice) {
-            minPrice = item.getCurrentPrice();
+    // OPTIMIZATION 2: Only calculate expensive similarity if we don't have a good match yet
+    if (score < 100.0) {
+        // Calculate similarity score for the full name
+        double nameSimilarity = calculateSimilarity(query, name);
+        score += nameSimilarity * 60.0;
+    }
+    
+    // Check individual words for partial matches
+    for (const auto& word : searchWords) {
+        if (TextSearch::contains(name, word)) {
+            score += 25.0;
+        }
+        if (TextSearch::contains(description, word)) {
+            score += 10.0;
         }
     }
-    return minPrice;
+    return score;
 }
 
-double Database::getMaxPrice(int itemId) const {
-    auto itemList = getItemById(itemId);
-    if (itemList.empty()) return 0.0;
-    
-    double maxPrice = itemList[0].getCurrentPrice();
-    for (const auto& item : itemList) {
-        if (item.getCurrentPrice() > maxPrice) {
-            maxPrice = item.getCurrentPrice();
+// Statistics methods
+std::vector<int32_t> Database::pricesOf(int itemId) const {
+    std::vector<int32_t> cents;
+    auto it = productsByItemId.find(itemId);
+    if (it != productsByItemId.end()) {
+        for (uint32_t index : it->second) {
+            const Product& product = products[index];
+            for (uint32_t i = 0; i < product.observationCount; i++) {
+                cents.push_back(observations[product.firstObservation + i].cents);
+            }
         }
     }
-    return maxPrice;
+    return cents;
 }
 
-std::vector<std::string> Database::getAllStores() const {
-    std::set<std::string> uniqueStores;
-    for (const auto& item : items) {
-        uniqueStores.insert(item.getStore());
+Money Database::getAveragePrice(int itemId) const {
+    static Histogram& latency = queryLatency("getAveragePrice");
+    ScopedTimer timer(latency);
+    
+    auto prices = pricesOf(itemId);
+    if (prices.empty()) return Money();
+    
+    long long sum = 0;
+    for (int32_t cents : prices) {
+        sum += cents;
     }
-    return std::vector<std::string>(uniqueStores.begin(), uniqueStores.end());
+    return Money::fromCents(sum).dividedBy(static_cast<long long>(prices.size()));
+}
+
+Money Database::getMinPrice(int itemId) const {
+    static Histogram& latency = queryLatency("getMinPrice");
+    ScopedTimer timer(latency);
+    
+    auto prices = pricesOf(itemId);
+    if (prices.empty()) return Money();
+    
+    return Money::fromCents(*std::min_element(prices.begin(), prices.end()));
+}
+
+Money Database::getMaxPrice(int itemId) const {
+    static Histogram& latency = queryLatency("getMaxPrice");
+    ScopedTimer timer(latency);
+    
+    auto prices = pricesOf(itemId);
+    if (prices.empty()) return Money();
+    
+    return Money::fromCents(*std::max_element(prices.begin(), prices.end()));
+}
+
+std::vector<std::string> Database::getAllStores() const {
+    static Histogram& latency = queryLatency("getAllStores");
+    ScopedTimer timer(latency);
+    
+    return sortedStores;
 }
 
 std::vector<std::string> Database::getAllCategories() const {
-    std::set<std::string> uniqueCategories;
-    for (const auto& item : items) {
-        auto tags = item.getCategoryTags();
-        uniqueCategories.insert(tags.begin(), tags.end());
-    }
-    return std::vector<std::string>(uniqueCategories.begin(), uniqueCategories.end());
+    static Histogram& latency = queryLatency("getAllCategories");
+    ScopedTimer timer(latency);
+    
+    return sortedCategories;
+}
+
+const PriceTable& Database::getPriceTable() const {
+    return priceTable;
+}
+
+void Database::setSearchParameters(const SearchIndex::Parameters& parameters) {
+    searchIndex.setParameters(parameters);
+}
+
+const SearchIndex::Parameters& Database::getSearchParameters() const {
+    return searchIndex.getParameters();
 }
@@ -0,0 +1,103 @@
+/**
+ * @file Executor.cpp
+ * @brief Implementation of the fixed-size request executor
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "Executor.h"
+#include <algorithm>
+#include <iostream>
+
+Executor::Executor(std::string name, size_t threadCount, size_t maxQueue)
+    : name(std::move(name)),
+      maxQueue(maxQueue),
+      busyThreads(0),
+      stopping(false),
+      queueDepthGauge(MetricsRegistry::instance().gauge(
+          "budgeteer_executor_queue_depth", "Tasks waiting for an executor thread", {{"executor", this->name}})),
+      busyThreadsGauge(MetricsRegistry::instance().gauge(
+          "budgeteer_executor_busy_threads", "Executor threads running a task", {{"executor", this->name}})),
+      queueWait(MetricsRegistry::instance().histogram(
+          "budgeteer_executor_queue_wait_seconds", "Time tasks spend queued before running", {{"executor", this->name}})),
+      rejected(MetricsRegistry::instance().counter(
+          "budgeteer_executor_rejected_total", "Tasks refused because the executor queue was full", {{"executor", this->name}})) {
+    threadCount = std::max<size_t>(1, threadCount);
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++) {
+        workers.emplace_back([this]() { workerLoop(); });
+    }
+    std::cout << "[Executor] '" << this->name << "' started with " << threadCount << " threads";
+    if (maxQueue != kUnbounded) {
+        std::cout << " (queue limit " << maxQueue << ")";
+    }
+    std::cout << std::endl;
+}
+
+Executor::~Executor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+bool Executor::enqueue(std::function<void()> task, bool bounded) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Idle threads pick work up immediately, so only count tasks that would actually wait
+        size_t occupied = tasks.size() + busyThreads + 1;
+        size_t waiting = occupied > workers.size() ? occupied - workers.size() : 0;
+        if (bounded && waiting > maxQueue) {
+            rejected.increment();
+            return false;
+        }
+        tasks.push({std::move(task), std::chrono::steady_clock::now()});
+        queueDepthGauge.set(static_cast<double>(tasks.size()));
+    }
+    available.notify_one();
+    return true;
+}
+
+void Executor::workerLoop() {
+    while (true) {
+        QueuedTask task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;   // Stopping and drained
+            }
+            task = std::move(tasks.front());
+            tasks.pop();
+            busyThreads++;
+            queueDepthGauge.set(static_cast<double>(tasks.size()));
+            busyThreadsGauge.set(static_cast<double>(busyThreads));
+        }
+        
+        queueWait.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - task.enqueuedAt).count()));
+        task.run();
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        busyThreads--;
+        busyThreadsGauge.set(static_cast<double>(busyThreads));
+    }
+}
+
+size_t Executor::getQueueDepth() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return tasks.size();
+}
+
+size_t Executor::getBusyThreads() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return busyThreads;
+}
@@ -0,0 +1,284 @@
+/**
+ * @file IntentClassifier.cpp
+ * @brief Implementation of the hashed n-gram route and mode classifier
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "IntentClassifier.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+namespace {
+
+constexpr uint32_t kFnvOffset = 2166136261u;
+constexpr uint32_t kFnvPrime = 16777619u;
+constexpr const char* kModelHeader = "budgeteer-intent-model";
+constexpr int kModelVersion = 1;
+constexpr size_t kMaxBuckets = 1 << 22;
+constexpr float kSaveThreshold = 1e-4f;   // Smaller weights are dropped from the model file
+
+uint32_t mixByte(uint32_t hash, unsigned char byte) {
+    return (hash ^ byte) * kFnvPrime;
+}
+
+uint32_t mixBytes(uint32_t hash, const char* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        hash = mixByte(hash, static_cast<unsigned char>(data[i]));
+    }
+    return hash;
+}
+
+double sigmoid(double z) {
+    return 1.0 / (1.0 + std::exp(-z));
+}
+
+} // namespace
+
+IntentClassifier::IntentClassifier(size_t buckets)
+    : buckets(std::max<size_t>(1, std::min(buckets, kMaxBuckets))), trained(false) {}
+
+void IntentClassifier::extractFeatures(const std::string& query, size_t buckets, std::vector<uint32_t>& features) {
+    features.clear();
+    auto bucketOf = [buckets](uint32_t hash) { return static_cast<uint32_t>(hash % buckets); };
+
+    std::string lower(query.size(), '\0');
+    std::transform(query.begin(), query.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    features.push_back(bucketOf(mixBytes(kFnvOffset, "#bias", 5)));
+
+    size_t words = 0;
+    bool hasDigit = false;
+    size_t previousStart = 0, previousLength = 0;
+    size_t pos = 0;
+    while (pos < lower.size()) {
+        if (!std::isalnum(static_cast<unsigned char>(lower[pos]))) {
+            pos++;
+            continue;
+        }
+        size_t start = pos;
+        while (pos < lower.size() && std::isalnum(static_cast<unsigned char>(lower[pos]))) {
+            hasDigit = hasDigit || std::isdigit(static_cast<unsigned char>(lower[pos]));
+            pos++;
+        }
+        const char* word = lower.data() + start;
+        size_t length = pos - start;
+
+        // Word unigram and bigram
+        features.push_back(bucketOf(mixBytes(mixByte(kFnvOffset, 'w'), word, length)));
+        if (words > 0) {
+            uint32_t bigram = mixBytes(mixByte(kFnvOffset, 'b'), lower.data() + previousStart, previousLength);
+            features.push_back(bucketOf(mixBytes(mixByte(bigram, ' '), word, length)));
+        }
+
+        // Character trigrams of "^word$"
+        auto padded = [word, length](size_t i) -> unsigned char {
+            return i == 0 ? '^' : i == length + 1 ? '$' : static_cast<unsigned char>(word[i - 1]);
+        };
+        for (size_t i = 0; i < length; i++) {
+            uint32_t hash = mixByte(kFnvOffset, 'c');
+            hash = mixByte(mixByte(mixByte(hash, padded(i)), padded(i + 1)), padded(i + 2));
+            features.push_back(bucketOf(hash));
+        }
+
+        previousStart = start;
+        previousLength = length;
+        words++;
+    }
+
+    char lengthBucket = static_cast<char>('0' + std::min<size_t>(words, 6));
+    features.push_back(bucketOf(mixByte(mixByte(kFnvOffset, 'n'), static_cast<unsigned char>(lengthBucket))));
+    if (hasDigit) {
+        features.push_back(bucketOf(mixBytes(kFnvOffset, "#digit", 6)));
+    }
+}
+
+double IntentClassifier::routeLogit(const std::vector<uint32_t>& features) const {
+    double z = 0.0;
+    for (uint32_t feature : features) {
+        z += routeWeights[feature];
+    }
+    return z;
+}
+
+void IntentClassifier::modeProbabilities(const std::vector<uint32_t>& features, std::vector<double>& probabilities) const {
+    probabilities.assign(modeLabels.size(), 0.0);
+    if (probabilities.empty()) {
+        return;
+    }
+    for (size_t mode = 0; mode < modeLabels.size(); mode++) {
+        const float* row = modeWeights.data() + mode * buckets;
+        for (uint32_t feature : features) {
+            probabilities[mode] += row[feature];
+        }
+    }
+    double maxLogit = *std::max_element(probabilities.begin(), probabilities.end());
+    double total = 0.0;
+    for (double& p : probabilities) {
+        p = std::exp(p - maxLogit);
+        total += p;
+    }
+    for (double& p : probabilities) {
+        p /= total;
+    }
+}
+
+void IntentClassifier::train(const std::vector<Example>& examples, const std::vector<std::string>& labels,
+                             const TrainingOptions& options) {
+    modeLabels = labels;
+    routeWeights.assign(buckets, 0.0f);
+    modeWeights.assign(modeLabels.size() * buckets, 0.0f);
+
+    std::vector<std::vector<uint32_t>> featureSets(examples.size());
+    for (size_t i = 0; i < examples.size(); i++) {
+        extractFeatures(examples[i].query, buckets, featureSets[i]);
+    }
+
+    std::vector<size_t> order(examples.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::mt19937_64 rng(options.seed);
+    std::vector<double> probabilities;
+
+    for (int epoch = 0; epoch < options.epochs; epoch++) {
+        // Fisher-Yates by hand so the order does not depend on the standard library
+        for (size_t i = order.size(); i > 1; i--) {
+            std::swap(order[i - 1], order[rng() % i]);
+        }
+        const double rate = options.learningRate / std::sqrt(1.0 + epoch);
+
+        for (size_t index : order) {
+            const Example& example = examples[index];
+            const auto& features = featureSets[index];
+
+            double routeGradient = sigmoid(routeLogit(features)) - (example.local ? 1.0 : 0.0);
+            for (uint32_t feature : features) {
+                float& weight = routeWeights[feature];
+                weight -= static_cast<float>(rate * (routeGradient + options.l2 * weight));
+            }
+
+            if (example.mode < 0 || static_cast<size_t>(example.mode) >= modeLabels.size()) {
+                continue;
+            }
+            modeProbabilities(features, probabilities);
+            for (size_t mode = 0; mode < modeLabels.size(); mode++) {
+                double gradient = probabilities[mode] - (static_cast<int>(mode) == example.mode ? 1.0 : 0.0);
+                float* row = modeWeights.data() + mode * buckets;
+                for (uint32_t feature : features) {
+                    row[feature] -= static_cast<float>(rate * (gradient + options.l2 * row[feature]));
+                }
+            }
+        }
+    }
+    trained = true;
+}
+
+IntentClassifier::Prediction IntentClassifier::predict(const std::string& query) const {
+    Prediction prediction;
+    if (!trained) {
+        return prediction;
+    }
+
+    std::vector<uint32_t> features;
+    extractFeatures(query, buckets, features);
+    prediction.localProbability = sigmoid(routeLogit(features));
+
+    std::vector<double> probabilities;
+    modeProbabilities(features, probabilities);
+    if (!probabilities.empty()) {
+        auto best = std::max_element(probabilities.begin(), probabilities.end());
+        prediction.mode = static_cast<int>(best - probabilities.begin());
+        prediction.modeProbability = *best;
+    }
+    return prediction;
+}
+
+bool IntentClassifier::save(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "[Intent] Cannot write model file " << path << std::endl;
+        return false;
+    }
+
+    out << kModelHeader << " " << kModelVersion << "\n";
+    out << "buckets " << buckets << "\n";
+    out << "modes " << modeLabels.size();
+    for (const auto& label : modeLabels) out << " " << label;
+    out << "\n";
+    out << std::setprecision(7);
+    for (size_t bucket = 0; bucket < buckets; bucket++) {
+        if (std::fabs(routeWeights[bucket]) >= kSaveThreshold) {
+            out << "r " << bucket << " " << routeWeights[bucket] << "\n";
+        }
+    }
+    for (size_t mode = 0; mode < modeLabels.size(); mode++) {
+        for (size_t bucket = 0; bucket < buckets; bucket++) {
+            float weight = modeWeights[mode * buckets + bucket];
+            if (std::fabs(weight) >= kSaveThreshold) {
+                out << "m " << mode << " " << bucket << " " << weight << "\n";
+            }
+        }
+    }
+    return static_cast<bool>(out);
+}
+
+bool IntentClassifier::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "[Intent] Cannot open model file " << path << std::endl;
+        return false;
+    }
+
+    auto fail = [&path](const std::string& reason) {
+        std::cerr << "[Intent] Invalid model file " << path << ": " << reason << std::endl;
+        return false;
+    };
+
+    std::string header, key;
+    int version = 0;
+    size_t fileBuckets = 0, modeCount = 0;
+    if (!(in >> header >> version) || header != kModelHeader || version != kModelVersion) {
+        return fail("unrecognised header");
+    }
+    if (!(in >> key >> fileBuckets) || key != "buckets" || fileBuckets == 0 || fileBuckets > kMaxBuckets) {
+        return fail("bad bucket count");
+    }
+    if (!(in >> key >> modeCount) || key != "modes" || modeCount > 64) {
+        return fail("bad mode list");
+    }
+    std::vector<std::string> labels(modeCount);
+    for (auto& label : labels) {
+        if (!(in >> label)) return fail("truncated mode list");
+    }
+
+    std::vector<float> route(fileBuckets, 0.0f);
+    std::vector<float> modes(modeCount * fileBuckets, 0.0f);
+    std::string kind;
+    while (in >> kind) {
+        size_t mode = 0, bucket = 0;
+        float weight = 0.0f;
+        if (kind == "r" && in >> bucket >> weight && bucket < fileBuckets) {
+            route[bucket] = weight;
+        } else if (kind == "m" && in >> mode >> bucket >> weight && mode < modeCount && bucket < fileBuckets) {
+            modes[mode * fileBuckets + bucket] = weight;
+        } else {
+            return fail("bad weight line");
+        }
+    }
+
+    buckets = fileBuckets;
+    modeLabels = std::move(labels);
+    routeWeights = std::move(route);
+    modeWeights = std::move(modes);
+    trained = true;
+    std::cout << "[Intent] Loaded model " << path << " (" << buckets << " buckets, "
+              << modeLabels.size() << " modes)" << std::endl;
+    return true;
+}
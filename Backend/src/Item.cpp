@@ -20,11 +20,11 @@
  * 
  * Initializes an Item with default values:
  * - itemId: 0
- * - currentPrice: 0.0
+ * - currentPrice: $0.00
  * - All string fields: empty strings
  * - categoryTags: empty vector
  */
-Item::Item() : itemId(0), currentPrice(0.0) {}
+Item::Item() : itemId(0) {}
 
 /**
  * @brief Parameterized constructor - creates an Item with specified values
@@ -32,7 +32,7 @@ Item::Item() : itemId(0), currentPrice(0.0) {}
  * @param id Unique identifier for the item
  * @param name Product name (e.g., "Samsung 55-inch 4K Smart TV")
  * @param description Detailed product description
- * @param price Current price in dollars
+ * @param price Current price
  * @param store Store name (Walmart, Loblaws, or Costco)
  * @param tags Vector of category tags (e.g., ["electronics", "entertainment"])
  * @param imgUrl URL to product image (may be placeholder)
@@ -43,7 +43,7 @@ Item::Item() : itemId(0), currentPrice(0.0) {}
  * the same product at different locations or times.
  */
 Item::Item(int id, const std::string& name, const std::string& description,
-           double price, const std::string& store, const std::vector<std::string>& tags,
+           Money price, const std::string& store, const std::vector<std::string>& tags,
            const std::string& imgUrl, const std::string& date)
     : itemId(id), itemName(name), itemDescription(description),
       currentPrice(price), store(store), categoryTags(tags),
@@ -53,7 +53,7 @@ Item::Item(int id, const std::string& name, const std::string& description,
 int Item::getItemId() const { return itemId; }
 std::string Item::getItemName() const { return itemName; }
 std::string Item::getItemDescription() const { return itemDescription; }
-double Item::getCurrentPrice() const { return currentPrice; }
+Money Item::getCurrentPrice() const { return currentPrice; }
 std::string Item::getStore() const { return store; }
 std::vector<std::string> Item::getCategoryTags() const { return categoryTags; }
 std::string Item::getImageUrl() const { return imageUrl; }
@@ -63,7 +63,7 @@ std::string Item::getPriceDate() const { return priceDate; }
 void Item::setItemId(int id) { itemId = id; }
 void Item::setItemName(const std::string& name) { itemName = name; }
 void Item::setItemDescription(const std::string& description) { itemDescription = description; }
-void Item::setCurrentPrice(double price) { currentPrice = price; }
+void Item::setCurrentPrice(Money price) { currentPrice = price; }
 void Item::setStore(const std::string& store) { this->store = store; }
 void Item::setCategoryTags(const std::vector<std::string>& tags) { categoryTags = tags; }
 void Item::setImageUrl(const std::string& imgUrl) { imageUrl = imgUrl; }
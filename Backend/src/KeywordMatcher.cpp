@@ -0,0 +1,125 @@
+/**
+ * @file KeywordMatcher.cpp
+ * @brief Implementation of the Aho-Corasick keyword matcher
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "KeywordMatcher.h"
+#include <algorithm>
+#include <cctype>
+#include <queue>
+
+namespace {
+
+uint8_t foldByte(unsigned char c) {
+    return static_cast<uint8_t>(std::tolower(c));
+}
+
+} // namespace
+
+KeywordMatcher::KeywordMatcher() : alphabetSize(1) {
+    symbolOf.fill(0);
+    build();
+}
+
+int KeywordMatcher::add(const std::string& text, int group, int value) {
+    std::string lower(text.size(), '\0');
+    std::transform(text.begin(), text.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(foldByte(c)); });
+    keywords.push_back({lower, group, value});
+    return static_cast<int>(keywords.size() - 1);
+}
+
+void KeywordMatcher::clear() {
+    keywords.clear();
+    build();
+}
+
+void KeywordMatcher::build() {
+    // Alphabet: every byte used by some keyword; everything else shares symbol 0
+    symbolOf.fill(0);
+    alphabetSize = 1;
+    for (const auto& keyword : keywords) {
+        for (unsigned char c : keyword.text) {
+            if (symbolOf[c] == 0) {
+                symbolOf[c] = static_cast<uint8_t>(alphabetSize++);
+            }
+        }
+    }
+    // Upper-case input bytes map to the same symbols as their lower-case forms
+    for (int c = 0; c < 256; c++) {
+        uint8_t folded = foldByte(static_cast<unsigned char>(c));
+        if (folded != c) {
+            symbolOf[c] = symbolOf[folded];
+        }
+    }
+
+    // Trie; -1 marks a missing edge until the failure pass fills it in
+    transitions.assign(alphabetSize, -1);
+    outputs.assign(1, {});
+    for (size_t id = 0; id < keywords.size(); id++) {
+        int32_t state = 0;
+        for (unsigned char c : keywords[id].text) {
+            size_t slot = static_cast<size_t>(state) * alphabetSize + symbolOf[c];
+            if (transitions[slot] < 0) {
+                transitions[slot] = static_cast<int32_t>(outputs.size());
+                outputs.emplace_back();
+                transitions.resize(transitions.size() + alphabetSize, -1);
+            }
+            state = transitions[slot];
+        }
+        outputs[state].push_back(static_cast<int>(id));
+    }
+
+    // Breadth-first: complete every state's transitions through its failure link
+    // and inherit the failure state's outputs
+    std::vector<int32_t> failure(outputs.size(), 0);
+    std::queue<int32_t> pending;
+    for (size_t symbol = 0; symbol < alphabetSize; symbol++) {
+        int32_t& next = transitions[symbol];
+        if (next < 0) {
+            next = 0;
+        } else {
+            pending.push(next);
+        }
+    }
+    while (!pending.empty()) {
+        int32_t state = pending.front();
+        pending.pop();
+        const auto& inherited = outputs[failure[state]];
+        outputs[state].insert(outputs[state].end(), inherited.begin(), inherited.end());
+
+        for (size_t symbol = 0; symbol < alphabetSize; symbol++) {
+            int32_t& next = transitions[static_cast<size_t>(state) * alphabetSize + symbol];
+            int32_t fallback = transitions[static_cast<size_t>(failure[state]) * alphabetSize + symbol];
+            if (next < 0) {
+                next = fallback;
+            } else {
+                failure[next] = fallback;
+                pending.push(next);
+            }
+        }
+    }
+}
+
+std::vector<int> KeywordMatcher::scan(const std::string& text) const {
+    std::vector<bool> found(keywords.size(), false);
+    int32_t state = 0;
+    for (unsigned char c : text) {
+        state = transitions[static_cast<size_t>(state) * alphabetSize + symbolOf[c]];
+        for (int id : outputs[state]) {
+            found[id] = true;
+        }
+    }
+
+    std::vector<int> ids;
+    for (size_t id = 0; id < found.size(); id++) {
+        if (found[id]) {
+            ids.push_back(static_cast<int>(id));
+        }
+    }
+    return ids;
+}
@@ -1,11 +1,24 @@
 #include "LLMInterface.h"
+#include "BasketOptimizer.h"
+#include "Metrics.h"
+#include "PromptCatalog.h"
+#include "RequestContext.h"
+#include "Tracing.h"
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <chrono>
 #include <iomanip>
 #include <cctype>
 #include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
 #include <set>
+#include <string_view>
+#include <utility>
 
 // Enable SSL support for HTTPS connections to GitHub API
 #define CPPHTTPLIB_OPENSSL_SUPPORT
@@ -15,14 +28,387 @@
 
 using json = nlohmann::json;
 
+namespace {
+
+// Count one upstream call outcome ("200", "429", "connection_failed", ...)
+void recordGPTStatus(const std::string& status) {
+    MetricsRegistry::instance().counter(
+        "budgeteer_llm_requests_total", "GitHub Models API calls by outcome",
+        {{"status", status}}).increment();
+}
+
+const char* const kDefaultGPTEndpoint = "https://models.github.ai/inference";
+
+// Split a base URL into "scheme://host[:port]" and the path prefix for
+// chat completions ("https://models.github.ai/inference" ->
+// "https://models.github.ai" + "/inference/chat/completions")
+std::pair<std::string, std::string> splitEndpoint(const std::string& baseUrl) {
+    size_t schemeEnd = baseUrl.find("://");
+    size_t pathStart = baseUrl.find('/', schemeEnd == std::string::npos ? 0 : schemeEnd + 3);
+    std::string origin = pathStart == std::string::npos ? baseUrl : baseUrl.substr(0, pathStart);
+    std::string basePath = pathStart == std::string::npos ? "" : baseUrl.substr(pathStart);
+    while (!basePath.empty() && basePath.back() == '/') {
+        basePath.pop_back();
+    }
+    return {origin, basePath + "/chat/completions"};
+}
+
+// Upstream timeouts when no request deadline is active
+constexpr std::chrono::milliseconds kConnectTimeout(10000);
+constexpr std::chrono::milliseconds kReadTimeout(30000);
+
+// Below this budget a GPT round trip cannot complete, so it is not attempted
+constexpr std::chrono::milliseconds kMinGPTBudget(250);
+
+// True (and logged) when the active request has been cancelled or run out of time
+bool stopRequested(const char* stage) {
+    if (!RequestContext::shouldStop()) {
+        return false;
+    }
+    std::cout << "[LLM] Stopping at " << stage << ": request "
+              << RequestContext::current()->getCancelReason() << std::endl;
+    return true;
+}
+
+// Orders arena strings and std::strings alike, so lookups need no conversion
+struct NameLess {
+    using is_transparent = void;
+    bool operator()(std::string_view a, std::string_view b) const { return a < b; }
+};
+
+// Product names collected while a request runs, allocated from its arena
+using NameSet = std::pmr::set<std::pmr::string, NameLess>;
+
+// Everyday shopping scenarios and the products they usually need
+const std::map<std::string, std::vector<std::string>>& shoppingScenarios() {
+    static const std::map<std::string, std::vector<std::string>> scenarios = {
+        {"snack", {"chips", "cookies", "soda", "candy"}},
+        {"party", {"chips", "soda", "cookies", "pizza"}},
+        {"breakfast", {"eggs", "milk", "bread", "butter", "cereal"}},
+        {"lunch", {"bread", "cheese", "meat", "lettuce"}},
+        {"dinner", {"chicken", "rice", "pasta", "sauce"}},
+        {"cake", {"flour", "sugar", "eggs", "butter", "milk"}},
+        {"pasta", {"pasta", "sauce", "cheese", "garlic"}},
+        {"groceries", {"milk", "bread", "eggs", "butter"}}
+    };
+    return scenarios;
+}
+
+// Keyword groups in LLMInterface::queryKeywords
+enum KeywordGroup {
+    kIntentKeyword,
+    kSimpleKeyword,
+    kSpecificKeyword,
+    kScenarioKeyword,
+    kCategoryKeyword
+};
+
+// Local intents and their keywords, in precedence order: the first intent with a match wins
+struct IntentKeywords {
+    const char* intent;
+    std::vector<std::string> keywords;
+};
+
+const std::vector<IntentKeywords>& intentKeywords() {
+    static const std::vector<IntentKeywords> table = {
+        {"SEARCH", {"find", "search", "look for"}},
+        {"COMPARE", {"compare", "cheapest", "best price"}},
+        {"SHOPPING_LIST", {"list", "buy", "need", "get me"}},
+        {"BUDGET", {"budget", "spend", "cost", "under"}}
+    };
+    return table;
+}
+
+// Simple queries are direct product searches
+const std::vector<std::string>& simpleIndicators() {
+    static const std::vector<std::string> indicators = {
+        "find", "search", "price of", "how much"
+    };
+    return indicators;
+}
+
+// Specific brand names and detailed product descriptions
+const std::vector<std::string>& specificIndicators() {
+    static const std::vector<std::string> indicators = {
+        "samsung", "apple", "lg", "sony", "coca-cola", "coke", "pepsi",
+        "tide", "dawn", "pampers", "huggies", "2l", "500ml", "oz", "inch"
+    };
+    return indicators;
+}
+
+// Minimum intent-model confidence for overriding the caller's processing mode
+constexpr double kModeConfidence = 0.6;
+
+/**
+ * Append a labelled query for budgeteer_train_intent when BUDGETEER_QUERY_LOG
+ * names a file. Lines are "route<TAB>mode<TAB>query" and can be corrected by
+ * hand before training.
+ */
+void logQueryLabel(const std::string& route, const std::string& mode, const std::string& query) {
+    static const char* path = std::getenv("BUDGETEER_QUERY_LOG");
+    if (path == nullptr || *path == '\0') {
+        return;
+    }
+    static std::mutex mutex;
+    static std::ofstream log(path, std::ios::app);
+    
+    std::string flattened = query;
+    std::replace_if(flattened.begin(), flattened.end(), [](char c) { return c == '\t' || c == '\n' || c == '\r'; }, ' ');
+    std::lock_guard<std::mutex> lock(mutex);
+    log << route << '\t' << mode << '\t' << flattened << '\n';
+    log.flush();
+}
+
+// Candidate products offered to the single-pass planning prompt
+constexpr size_t kPlanCandidates = 60;
+
+// Products the planner may ask for beyond the candidates
+constexpr size_t kPlanMissingLimit = 10;
+
+// Search results kept per product for the budget solver
+constexpr size_t kListOptionsPerProduct = 8;
+
+// Stores named in prompts and recognised in shopping constraints
+const std::vector<std::string>& knownStores() {
+    static const std::vector<std::string> stores = {"Walmart", "Loblaws", "Costco"};
+    return stores;
+}
+
+// Strip ```json fences and surrounding whitespace from a GPT reply
+std::string stripCodeFence(const std::string& response) {
+    std::string cleaned = response;
+    size_t startPos = cleaned.find("```json");
+    if (startPos != std::string::npos) {
+        cleaned = cleaned.substr(startPos + 7);
+    } else if ((startPos = cleaned.find("```")) != std::string::npos) {
+        cleaned = cleaned.substr(startPos + 3);
+    }
+    size_t endPos = cleaned.rfind("```");
+    if (endPos != std::string::npos) {
+        cleaned = cleaned.substr(0, endPos);
+    }
+    size_t first = cleaned.find_first_not_of(" \n\r\t");
+    if (first == std::string::npos) {
+        return "";
+    }
+    size_t last = cleaned.find_last_not_of(" \n\r\t");
+    return cleaned.substr(first, last - first + 1);
+}
+
+// Count how a pipeline run ended ("planned", "fallback", ...)
+void recordPipelineRun(const std::string& pipeline, const std::string& outcome) {
+    MetricsRegistry::instance().counter(
+        "budgeteer_llm_pipeline_runs_total", "GPT-backed requests by pipeline and outcome",
+        {{"pipeline", pipeline}, {"outcome", outcome}}).increment();
+}
+
+// Publish a progress event to a streaming request; data is only built when someone listens
+template <typename Build>
+void emitProgress(const char* event, Build build) {
+    if (RequestContext::isStreaming()) {
+        RequestContext::emitEvent(event, build().dump());
+    }
+}
+
+// Compact item list for progress events
+json itemsSummary(const std::vector<Item>& items, size_t limit = 20) {
+    json list = json::array();
+    for (size_t i = 0; i < items.size() && i < limit; i++) {
+        list.push_back({
+            {"item_id", items[i].getItemId()},
+            {"name", items[i].getItemName()},
+            {"price", items[i].getCurrentPrice().dollars()},
+            {"store", items[i].getStore()}
+        });
+    }
+    return {{"count", items.size()}, {"items", list}};
+}
+
+/**
+ * Incremental parser for an OpenAI-style chat completions event stream
+ * ("data: {...}" lines ending with "data: [DONE]"). Content deltas are
+ * accumulated and handed to onToken as they arrive.
+ */
+class ChatStreamParser {
+private:
+    std::string pending;
+    std::string content;
+    json usage;
+    bool sawEvents = false;
+
+public:
+    template <typename OnToken>
+    void feed(const char* data, size_t length, OnToken onToken) {
+        pending.append(data, length);
+        size_t lineEnd;
+        while ((lineEnd = pending.find('\n')) != std::string::npos) {
+            std::string line = pending.substr(0, lineEnd);
+            pending.erase(0, lineEnd + 1);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.compare(0, 5, "data:") != 0) continue;
+            
+            size_t start = line.find_first_not_of(' ', 5);
+            std::string payload = start == std::string::npos ? std::string() : line.substr(start);
+            if (payload.empty() || payload == "[DONE]") continue;
+            json chunk = json::parse(payload, nullptr, false);
+            if (!chunk.is_object()) continue;
+            sawEvents = true;
+            
+            if (chunk.contains("usage") && chunk["usage"].is_object()) {
+                usage = chunk["usage"];
+            }
+            if (chunk.contains("choices") && chunk["choices"].is_array() && !chunk["choices"].empty()) {
+                const json& delta = chunk["choices"][0].value("delta", json::object());
+                if (delta.contains("content") && delta["content"].is_string()) {
+                    const std::string& text = delta["content"].get_ref<const std::string&>();
+                    content += text;
+                    onToken(text);
+                }
+            }
+        }
+    }
+    
+    bool streamed() const { return sawEvents; }
+    const std::string& getContent() const { return content; }
+    const json& getUsage() const { return usage; }
+};
+
+// Count an optional stage skipped because upstream is degraded or time is short
+void recordDowngrade(const char* stage, const char* reason) {
+    MetricsRegistry::instance().counter(
+        "budgeteer_llm_stage_downgrades_total", "Optional LLM stages skipped by the adaptive router",
+        {{"stage", stage}, {"reason", reason}}).increment();
+}
+
+// Requests that differ only in case or spacing share one computation
+std::string coalescingKey(const std::string& kind, const std::string& text) {
+    std::string key = kind + "|";
+    bool pendingSpace = false;
+    for (char c : text) {
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            pendingSpace = key.back() != '|';
+            continue;
+        }
+        if (pendingSpace) {
+            key += ' ';
+            pendingSpace = false;
+        }
+        key += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return key;
+}
+
+/**
+ * Run compute through a SingleFlight group, recording leader/follower counts,
+ * the number of requests each computation served, and the overall fan-in
+ * ratio (requests per upstream computation) for the operation.
+ *
+ * The leader computes under a context of its own with the leader's deadline,
+ * so its client going away does not cut the shared result short while
+ * followers still wait for it. Followers wait only until their own deadline
+ * or cancellation. Streaming requests, which need their own progress events,
+ * and already cancelled requests are never coalesced.
+ */
+template <typename T, typename Compute>
+T coalesce(SingleFlight<T>& flights, const std::string& operation, const std::string& key, Compute compute) {
+    auto& registry = MetricsRegistry::instance();
+    Counter& leaders = registry.counter("budgeteer_llm_coalesced_requests_total",
+        "LLM requests by single-flight role", {{"operation", operation}, {"role", "leader"}});
+    Counter& followers = registry.counter("budgeteer_llm_coalesced_requests_total",
+        "LLM requests by single-flight role", {{"operation", operation}, {"role", "follower"}});
+    Counter& abandoned = registry.counter("budgeteer_llm_coalesced_requests_total",
+        "LLM requests by single-flight role", {{"operation", operation}, {"role", "abandoned"}});
+    Histogram& fanIn = registry.histogram("budgeteer_llm_coalescing_fan_in",
+        "Requests served by each coalesced LLM computation", {{"operation", operation}},
+        1.0, Histogram::sizeBounds());
+    Gauge& ratio = registry.gauge("budgeteer_llm_coalescing_fan_in_ratio",
+        "Requests per LLM computation since startup", {{"operation", operation}});
+    
+    RequestContext* caller = RequestContext::current();
+    if (caller && (RequestContext::isStreaming() || caller->isCancelled())) {
+        return compute();
+    }
+    
+    std::function<T()> shared = [&]() -> T {
+        if (!caller) {
+            return compute();
+        }
+        RequestContext context(caller->remaining());
+        context.setDisconnectProbe([caller, &flights, &key]() {
+            return caller->isCancelled() && flights.waitingFollowers(key) == 0;
+        });
+        RequestContext::Scope scope(context);
+        T value = compute();
+        caller->noteUpstreamCall(context.getUpstreamCalls());
+        return value;
+    };
+    
+    TraceSpan span("coalesce");
+    auto outcome = caller
+        ? flights.run(key, shared, caller->getDeadline(), []() { return RequestContext::shouldStop(); })
+        : flights.run(key, shared);
+    span.setAttribute("role", outcome.leader ? "leader" : outcome.abandoned ? "abandoned" : "follower");
+    
+    if (outcome.leader) {
+        leaders.increment();
+        fanIn.record(outcome.fanIn);
+        span.setAttribute("fan_in", outcome.fanIn);
+        if (outcome.fanIn > 1) {
+            std::cout << "[LLM] Coalesced " << outcome.fanIn << " identical " << operation << " requests" << std::endl;
+        }
+    } else if (outcome.abandoned) {
+        abandoned.increment();
+    } else {
+        followers.increment();
+    }
+    
+    uint64_t computations = leaders.get() + abandoned.get();
+    if (computations > 0) {
+        ratio.set(static_cast<double>(computations + followers.get()) / static_cast<double>(computations));
+    }
+    return std::move(outcome.value);
+}
+
+// Days since the epoch (UTC), used to reset the daily GPT quota
+long long currentDay() {
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::hours>(now).count() / 24;
+}
+
+/// Returns a reserved GPT query to the quota unless the call succeeded
+class QuotaReservation {
+private:
+    std::function<void()> release;
+    bool committed;
+
+public:
+    explicit QuotaReservation(std::function<void()> onRelease)
+        : release(std::move(onRelease)), committed(false) {}
+    ~QuotaReservation() {
+        if (!committed) release();
+    }
+    void commit() { committed = true; }
+};
+
+Gauge& quotaRemainingGauge() {
+    static Gauge& gauge = MetricsRegistry::instance().gauge(
+        "budgeteer_llm_quota_remaining", "GPT queries left before the daily limit");
+    return gauge;
+}
+
+} // namespace
+
 LLMInterface::LLMInterface(std::shared_ptr<StoreApiClient> client) 
     : storeClient(client),
+      gptEndpoint(kDefaultGPTEndpoint),
       useGPT(true),  // Enable GPT by default
       gptModel("openai/gpt-4o-mini"),  // Use GPT-4o-mini via GitHub
       maxTokens(500),
       temperature(0.7),
       dailyQueryCount(0),
-      dailyQueryLimit(1000) {
+      dailyQueryLimit(1000),
+      quotaDay(currentDay()),
+      defaultPipeline(Pipeline::SEQUENTIAL) {
     
     // Try to get API key from environment variable (GitHub token)
     const char* envKey = std::getenv("GITHUB_TOKEN");
@@ -36,6 +422,18 @@ LLMInterface::LLMInterface(std::shared_ptr<StoreApiClient> client)
         useGPT = false;  // Disable GPT if no key
     }
     
+    // Optional alternative endpoint (e.g. budgeteer_mock_llm for offline benchmarking)
+    const char* envEndpoint = std::getenv("BUDGETEER_LLM_ENDPOINT");
+    if (envEndpoint != nullptr && strlen(envEndpoint) > 0) {
+        setGPTEndpoint(envEndpoint);
+    }
+    
+    // Optional learned router trained by budgeteer_train_intent
+    const char* envIntentModel = std::getenv("BUDGETEER_INTENT_MODEL");
+    if (envIntentModel != nullptr && strlen(envIntentModel) > 0) {
+        loadIntentModel(envIntentModel);
+    }
+    
     // Initialize category expansions based on LLM-instructions.txt
     categoryExpansions["snacks"] = {"chips", "cookies", "granola bars", "crackers", "pretzels"};
     categoryExpansions["dairy"] = {"milk", "cheese", "yogurt", "butter", "cream"};
@@ -43,10 +441,72 @@ LLMInterface::LLMInterface(std::shared_ptr<StoreApiClient> client)
     categoryExpansions["cleaning"] = {"dish soap", "laundry detergent", "bleach", "wipes", "cleaner"};
     categoryExpansions["personal care"] = {"shampoo", "soap", "toothpaste", "deodorant", "lotion"};
     categoryExpansions["baby"] = {"diapers", "wipes", "formula", "baby food", "shampoo"};
+    rebuildQueryKeywords();
+    
+    quotaRemainingGauge().set(dailyQueryLimit.load() - dailyQueryCount.load());
 }
 
 void LLMInterface::addCategoryExpansion(const std::string& category, const std::vector<std::string>& products) {
-    categoryExpansions[category] = products;
+    // Keys are lowercase so expandCategory() and keyword matching can find them
+    std::string lowerCategory = category;
+    std::transform(lowerCategory.begin(), lowerCategory.end(), lowerCategory.begin(), ::tolower);
+    categoryExpansions[lowerCategory] = products;
+    rebuildQueryKeywords();
+}
+
+void LLMInterface::rebuildQueryKeywords() {
+    queryKeywords.clear();
+    const auto& intents = intentKeywords();
+    for (size_t i = 0; i < intents.size(); i++) {
+        for (const auto& keyword : intents[i].keywords) {
+            queryKeywords.add(keyword, kIntentKeyword, static_cast<int>(i));
+        }
+    }
+    for (const auto& keyword : simpleIndicators()) {
+        queryKeywords.add(keyword, kSimpleKeyword);
+    }
+    for (const auto& keyword : specificIndicators()) {
+        queryKeywords.add(keyword, kSpecificKeyword);
+    }
+    // Map order, so the first scenario or category match is the one the old loops picked
+    for (const auto& scenario : shoppingScenarios()) {
+        queryKeywords.add(scenario.first, kScenarioKeyword);
+    }
+    for (const auto& category : categoryExpansions) {
+        queryKeywords.add(category.first, kCategoryKeyword);
+    }
+    queryKeywords.build();
+}
+
+LLMInterface::QueryKeywords LLMInterface::classifyQuery(const std::string& query) const {
+    QueryKeywords result;
+    int intentRank = -1;
+    for (int id : queryKeywords.scan(query)) {
+        const KeywordMatcher::Keyword& keyword = queryKeywords.keyword(id);
+        switch (keyword.group) {
+            case kIntentKeyword:
+                if (intentRank < 0 || keyword.value < intentRank) {
+                    intentRank = keyword.value;
+                    result.intent = intentKeywords()[keyword.value].intent;
+                }
+                break;
+            case kSimpleKeyword:
+                result.hasSimpleIndicator = true;
+                break;
+            case kSpecificKeyword:
+                result.hasSpecificIndicator = true;
+                break;
+            case kScenarioKeyword:
+                if (result.scenario.empty()) {
+                    result.scenario = keyword.text;
+                }
+                break;
+            case kCategoryKeyword:
+                result.categories.push_back(keyword.text);
+                break;
+        }
+    }
+    return result;
 }
 
 // Configuration methods
@@ -64,7 +524,8 @@ void LLMInterface::enableGPTMode(bool enable) {
 }
 
 void LLMInterface::setDailyQueryLimit(int limit) {
-    dailyQueryLimit = limit;
+    dailyQueryLimit.store(limit);
+    quotaRemainingGauge().set(limit - dailyQueryCount.load());
 }
 
 void LLMInterface::setGPTModel(const std::string& model) {
@@ -75,27 +536,193 @@ std::string LLMInterface::getGPTModel() const {
     return gptModel;
 }
 
+void LLMInterface::setGPTEndpoint(const std::string& baseUrl) {
+    gptEndpoint = baseUrl.empty() ? kDefaultGPTEndpoint : baseUrl;
+    std::cout << "[LLM] Chat completions endpoint: " << gptEndpoint << std::endl;
+}
+
+std::string LLMInterface::getGPTEndpoint() const {
+    return gptEndpoint;
+}
+
+AdaptiveRouter::State LLMInterface::getGPTCircuitState() const {
+    return gptRouter.getState();
+}
+
+void LLMInterface::setDefaultPipeline(Pipeline pipeline) {
+    defaultPipeline = pipeline;
+    std::cout << "[LLM] Default pipeline: " << pipelineName(pipeline) << std::endl;
+}
+
+LLMInterface::Pipeline LLMInterface::getDefaultPipeline() const {
+    return defaultPipeline;
+}
+
+std::string LLMInterface::pipelineName(Pipeline pipeline) {
+    return pipeline == Pipeline::SINGLE_PASS ? "single_pass" : "sequential";
+}
+
+std::optional<LLMInterface::Pipeline> LLMInterface::parsePipeline(const std::string& name) {
+    if (name == "single_pass" || name == "single-pass") {
+        return Pipeline::SINGLE_PASS;
+    }
+    if (name == "sequential") {
+        return Pipeline::SEQUENTIAL;
+    }
+    return std::nullopt;
+}
+
+std::string LLMInterface::modeName(Mode mode) {
+    switch (mode) {
+        case Mode::CHEAPEST_MIX: return "cheapest_mix";
+        case Mode::SINGLE_STORE: return "single_store";
+        case Mode::BUDGET_INSIGHT: return "budget_insight";
+    }
+    return "cheapest_mix";
+}
+
+std::optional<LLMInterface::Mode> LLMInterface::parseMode(const std::string& name) {
+    if (name == "cheapest_mix") {
+        return Mode::CHEAPEST_MIX;
+    }
+    if (name == "single_store") {
+        return Mode::SINGLE_STORE;
+    }
+    if (name == "budget_insight") {
+        return Mode::BUDGET_INSIGHT;
+    }
+    return std::nullopt;
+}
+
+bool LLMInterface::loadIntentModel(const std::string& path) {
+    auto model = std::make_shared<IntentClassifier>();
+    if (!model->load(path)) {
+        return false;
+    }
+    intentModel = std::move(model);
+    return true;
+}
+
+LLMInterface::Mode LLMInterface::chooseMode(const std::string& query, Mode fallback) const {
+    if (!intentModel) {
+        return fallback;
+    }
+    auto prediction = intentModel->predict(query);
+    if (prediction.mode < 0 || prediction.modeProbability < kModeConfidence) {
+        return fallback;
+    }
+    return parseMode(intentModel->getModeLabels()[prediction.mode]).value_or(fallback);
+}
+
 bool LLMInterface::canMakeGPTRequest() {
-    if (dailyQueryCount >= dailyQueryLimit) {
-        std::cout << "[LLM] Daily query limit reached (" << dailyQueryLimit << ")" << std::endl;
+    // Start a fresh count on the first check of a new day
+    long long today = currentDay();
+    long long day = quotaDay.load();
+    if (day != today && quotaDay.compare_exchange_strong(day, today)) {
+        dailyQueryCount.store(0);
+        quotaRemainingGauge().set(dailyQueryLimit.load());
+        std::cout << "[LLM] Daily query count reset" << std::endl;
+    }
+    
+    if (dailyQueryCount.load() >= dailyQueryLimit.load()) {
+        std::cout << "[LLM] Daily query limit reached (" << dailyQueryLimit.load() << ")" << std::endl;
         return false;
     }
     return true;
 }
 
-// GPT API Integration
-std::string LLMInterface::callGPTAPI(const std::string& prompt) {
+bool LLMInterface::tryReserveGPTQuery() {
     if (!canMakeGPTRequest()) {
+        return false;
+    }
+    
+    // Claim a slot atomically so concurrent calls can never overshoot the limit
+    int count = dailyQueryCount.load();
+    do {
+        if (count >= dailyQueryLimit.load()) {
+            return false;
+        }
+    } while (!dailyQueryCount.compare_exchange_weak(count, count + 1));
+    
+    quotaRemainingGauge().set(dailyQueryLimit.load() - (count + 1));
+    return true;
+}
+
+void LLMInterface::releaseGPTQuery() {
+    int remaining = dailyQueryLimit.load() - (dailyQueryCount.fetch_sub(1) - 1);
+    quotaRemainingGauge().set(remaining);
+}
+
+bool LLMInterface::canAffordGPTStage(const char* stage, int gptCalls) {
+    if (!gptRouter.isAcceptingCalls()) {
+        std::cout << "[LLM] Skipping " << stage << ": GPT circuit is open" << std::endl;
+        recordDowngrade(stage, "circuit_open");
+        return false;
+    }
+    
+    // Without a request deadline every stage is affordable
+    if (!RequestContext::current()) {
+        return true;
+    }
+    auto remaining = RequestContext::current()->remaining();
+    auto needed = gptRouter.typicalLatency() * gptCalls;
+    if (remaining < needed) {
+        std::cout << "[LLM] Skipping " << stage << ": " << remaining.count() << " ms left, needs ~"
+                  << needed.count() << " ms" << std::endl;
+        recordDowngrade(stage, "budget");
+        return false;
+    }
+    return true;
+}
+
+// GPT API Integration
+std::string LLMInterface::callGPTAPI(const std::string& prompt, const char* streamStage) {
+    static Histogram& latency = MetricsRegistry::instance().histogram(
+        "budgeteer_llm_request_duration_seconds", "Latency of GitHub Models API round trips");
+    static Counter& promptTokens = MetricsRegistry::instance().counter(
+        "budgeteer_llm_tokens_total", "Tokens reported by the GitHub Models API", {{"type", "prompt"}});
+    static Counter& completionTokens = MetricsRegistry::instance().counter(
+        "budgeteer_llm_tokens_total", "Tokens reported by the GitHub Models API", {{"type", "completion"}});
+    
+    // Bound the round trip by what is left of the request's deadline
+    auto readBudget = RequestContext::remainingOr(kReadTimeout);
+    if (stopRequested("gpt_call") || readBudget < kMinGPTBudget) {
+        recordGPTStatus("cancelled");
         return "";
     }
     
+    // Only successful calls count against the daily quota
+    if (!tryReserveGPTQuery()) {
+        recordGPTStatus("quota_exhausted");
+        return "";
+    }
+    QuotaReservation reservation([this]() { releaseGPTQuery(); });
+    
+    // Short-circuit while upstream is degraded; callers fall back to local processing
+    AdaptiveRouter::Permit permit = gptRouter.acquire();
+    if (permit == AdaptiveRouter::Permit::REJECTED) {
+        recordGPTStatus("circuit_open");
+        return "";
+    }
+    if (RequestContext* context = RequestContext::current()) {
+        context->noteUpstreamCall();
+    }
+    auto callStart = std::chrono::steady_clock::now();
+    auto connectBudget = std::min(readBudget, kConnectTimeout);
+    
+    ScopedTimer timer(latency);
+    TraceSpan span("gpt_call");
+    span.setAttribute("prompt_chars", prompt.size());
+    span.setAttribute("budget_ms", static_cast<long long>(readBudget.count()));
+    
     try {
         std::cout << "[LLM] Calling GPT-4o-mini via GitHub Models API..." << std::endl;
         
-        // Create HTTPS client for GitHub Models API with SSL support
-        httplib::SSLClient cli("models.github.ai");
-        cli.set_connection_timeout(10, 0);  // 10 seconds
-        cli.set_read_timeout(30, 0);        // 30 seconds
+        // Client for the configured endpoint (HTTPS for GitHub Models, plain HTTP for a local mock)
+        auto [origin, completionsPath] = splitEndpoint(gptEndpoint);
+        httplib::Client cli(origin);
+        cli.set_connection_timeout(connectBudget.count() / 1000, (connectBudget.count() % 1000) * 1000);
+        cli.set_read_timeout(readBudget.count() / 1000, (readBudget.count() % 1000) * 1000);
         cli.enable_server_certificate_verification(true);
         
         // Build request body
@@ -125,32 +752,90 @@ std::string LLMInterface::callGPTAPI(const std::string& prompt) {
             {"temperature", temperature}
         };
         
-        std::string body = requestBody.dump();
+        // Ask upstream for an event stream when a client is watching this stage
+        bool streaming = streamStage != nullptr && RequestContext::isStreaming();
+        if (streaming) {
+            requestBody["stream"] = true;
+            requestBody["stream_options"] = {{"include_usage", true}};
+        }
         
         // Set headers for GitHub API
-        httplib::Headers headers = {
-            {"Authorization", "Bearer " + openaiApiKey}
+        httplib::Request req;
+        req.method = "POST";
+        req.path = completionsPath;
+        req.headers = {
+            {"Authorization", "Bearer " + openaiApiKey},
+            {"Content-Type", "application/json"}
+        };
+        req.body = requestBody.dump();
+        
+        // Read the body incrementally so streamed tokens reach the client as they arrive
+        std::string rawBody;
+        ChatStreamParser parser;
+        req.content_receiver = [&](const char* data, size_t length, uint64_t, uint64_t) {
+            rawBody.append(data, length);
+            if (streaming) {
+                parser.feed(data, length, [streamStage](const std::string& text) {
+                    RequestContext::emitEvent("token", json{{"stage", streamStage}, {"text", text}}.dump());
+                });
+            }
+            return !RequestContext::shouldStop();
         };
         
         // Make POST request to GitHub Models API
-        // Let the library set Content-Type via the 4th parameter
-        auto res = cli.Post("/inference/chat/completions", headers, body, "application/json");
+        auto res = cli.send(req);
         
         if (res && res->status == 200) {
-            json response = json::parse(res->body);
+            // Upstreams without streaming support answer with a plain completion
+            json response;
+            if (parser.streamed()) {
+                response = {{"choices", json::array({{{"message", {{"content", parser.getContent()}}}}})}};
+                if (!parser.getUsage().is_null()) {
+                    response["usage"] = parser.getUsage();
+                }
+            } else {
+                response = json::parse(rawBody);
+            }
             std::string content = response["choices"][0]["message"]["content"];
             
-            dailyQueryCount++;
-            std::cout << "[LLM] GPT response received (query " << dailyQueryCount 
-                     << "/" << dailyQueryLimit << ")" << std::endl;
+            if (response.contains("usage") && response["usage"].is_object()) {
+                int usedPromptTokens = response["usage"].value("prompt_tokens", 0);
+                int usedCompletionTokens = response["usage"].value("completion_tokens", 0);
+                promptTokens.increment(usedPromptTokens);
+                completionTokens.increment(usedCompletionTokens);
+                span.setAttribute("prompt_tokens", usedPromptTokens);
+                span.setAttribute("completion_tokens", usedCompletionTokens);
+            }
+            
+            reservation.commit();
+            gptRouter.record(permit, true, std::chrono::steady_clock::now() - callStart);
+            recordGPTStatus("200");
+            span.setAttribute("status", 200);
+            std::cout << "[LLM] GPT response received (query " << dailyQueryCount.load() 
+                     << "/" << dailyQueryLimit.load() << ")" << std::endl;
             
             return content;
         } else if (res) {
-            std::cerr << "[LLM] GitHub API Error: " << res->status << " - " << res->body << std::endl;
+            gptRouter.record(permit, false, std::chrono::steady_clock::now() - callStart);
+            recordGPTStatus(std::to_string(res->status));
+            span.setAttribute("status", res->status);
+            std::cerr << "[LLM] GitHub API Error: " << res->status << " - " << rawBody << std::endl;
         } else {
+            // A timeout caused by the request deadline is a cancellation, not an outage
+            std::string status = RequestContext::shouldStop() ? "cancelled" : "connection_failed";
+            if (status == "cancelled") {
+                gptRouter.abandon(permit);
+            } else {
+                gptRouter.record(permit, false, std::chrono::steady_clock::now() - callStart);
+            }
+            recordGPTStatus(status);
+            span.setAttribute("status", status);
             std::cerr << "[LLM] Connection failed to GitHub Models API" << std::endl;
         }
     } catch (const std::exception& e) {
+        gptRouter.record(permit, false, std::chrono::steady_clock::now() - callStart);
+        recordGPTStatus("exception");
+        span.setAttribute("status", "exception");
         std::cerr << "[LLM] Exception calling GitHub API: " << e.what() << std::endl;
     }
     
@@ -158,49 +843,43 @@ std::string LLMInterface::callGPTAPI(const std::string& prompt) {
 }
 
 std::vector<Item> LLMInterface::cherryPickRelevantItems(const std::string& query, const std::vector<Item>& items) {
+    TraceSpan span("cherry_pick");
+    span.setAttribute("candidates", items.size());
+    
     // OPTIMIZATION: If we already have a manageable number of items, skip GPT cherry-picking
     if (items.size() <= 20) {
         std::cout << "[LLM] Only " << items.size() << " items, skipping cherry-pick" << std::endl;
         return items;
     }
     
-    if (!canMakeGPTRequest()) {
-        std::cout << "[LLM] Query limit reached, skipping cherry-pick filtering" << std::endl;
+    if (!canMakeGPTRequest() || stopRequested("cherry_pick")) {
+        std::cout << "[LLM] Query limit reached or request cancelled, skipping cherry-pick filtering" << std::endl;
         // Return top 20 items as fallback
         std::vector<Item> fallback(items.begin(), items.begin() + std::min(20, (int)items.size()));
         return fallback;
     }
     
     try {
-        // Build a list of unique product names from the search results
-        std::set<std::string> uniqueNames;
-        for (const auto& item : items) {
-            uniqueNames.insert(item.getItemName());
-        }
-        
-        // OPTIMIZATION: Reduced from 100 to 50 for token efficiency
-        // Create a compact list of products for GPT to review
-        std::ostringstream productList;
-        int count = 0;
-        for (const auto& name : uniqueNames) {
-            if (count >= 50) break;  // Reduced limit for token efficiency
-            productList << (count + 1) << ". " << name << "\n";
-            count++;
+        // Number the distinct product names; GPT answers with the numbers
+        PromptCatalog catalog;
+        for (size_t i = 0; i < items.size(); i++) {
+            catalog.add(items[i].getItemName(), i);
         }
+        const size_t listed = std::min<size_t>(catalog.size(), 50);   // Token budget
         
         // Build cherry-picking prompt
         std::ostringstream cherryPickPrompt;
         cherryPickPrompt << "User's original query: \"" << query << "\"\n\n";
-        cherryPickPrompt << "I found " << std::min((int)uniqueNames.size(), 50) << " unique products. ";
+        cherryPickPrompt << "I found " << listed << " unique products. ";
         cherryPickPrompt << "Please select ONLY the products that are DIRECTLY relevant to the user's query.\n\n";
         cherryPickPrompt << "Rules:\n";
         cherryPickPrompt << "1. Only include products that match the user's intent\n";
         cherryPickPrompt << "2. Exclude unrelated products (e.g., exclude 'Apple Watch' when user wants 'apples')\n";
         cherryPickPrompt << "3. For shopping lists, select 8-15 diverse items that fulfill the request\n";
         cherryPickPrompt << "4. Prioritize variety and common grocery items\n\n";
-        cherryPickPrompt << "Available products:\n" << productList.str() << "\n";
-        cherryPickPrompt << "IMPORTANT: Return ONLY a raw JSON array of product names. Do NOT wrap it in markdown code blocks.\n";
-        cherryPickPrompt << "Format: [\"Product Name 1\", \"Product Name 2\", ...]\n";
+        cherryPickPrompt << "Available products:\n" << catalog.listing(listed) << "\n";
+        cherryPickPrompt << "IMPORTANT: Return ONLY a raw JSON array of the selected product numbers. Do NOT wrap it in markdown code blocks.\n";
+        cherryPickPrompt << "Format: [3, 7, 12]\n";
         cherryPickPrompt << "Your response must start with [ and end with ].";
         
         std::cout << "[LLM] Asking GPT to cherry-pick relevant items..." << std::endl;
@@ -212,76 +891,34 @@ std::vector<Item> LLMInterface::cherryPickRelevantItems(const std::string& query
             return fallback;
         }
         
-        // Clean response
-        std::string cleanedResponse = gptResponse;
-        
-        // Remove markdown code blocks
-        size_t startPos = cleanedResponse.find("```json");
-        if (startPos != std::string::npos) {
-            cleanedResponse = cleanedResponse.substr(startPos + 7);
-        } else {
-            startPos = cleanedResponse.find("```");
-            if (startPos != std::string::npos) {
-                cleanedResponse = cleanedResponse.substr(startPos + 3);
-            }
-        }
-        
-        size_t endPos = cleanedResponse.rfind("```");
-        if (endPos != std::string::npos) {
-            cleanedResponse = cleanedResponse.substr(0, endPos);
-        }
-        
-        // Trim whitespace
-        size_t first = cleanedResponse.find_first_not_of(" \n\r\t");
-        if (first == std::string::npos) {
-            cleanedResponse = "";
-        } else {
-            size_t last = cleanedResponse.find_last_not_of(" \n\r\t");
-            cleanedResponse = cleanedResponse.substr(first, last - first + 1);
-        }
-        
+        std::string cleanedResponse = stripCodeFence(gptResponse);
         std::cout << "[LLM] Cherry-pick response: " << cleanedResponse.substr(0, 100) << "..." << std::endl;
         
-        // Parse the JSON array
-        json selectedNames = json::parse(cleanedResponse);
+        // Parse the JSON array of product numbers
+        json selectedIds = json::parse(cleanedResponse);
         
-        if (!selectedNames.is_array()) {
+        if (!selectedIds.is_array()) {
             std::cerr << "[LLM] Cherry-pick response is not an array" << std::endl;
             std::vector<Item> fallback(items.begin(), items.begin() + std::min(20, (int)items.size()));
             return fallback;
         }
         
-        // Convert to list for partial matching
-        std::vector<std::string> selectedList;
-        for (const auto& name : selectedNames) {
-            if (name.is_string()) {
-                selectedList.push_back(name.get<std::string>());
-            }
+        // Every row carrying a selected name, in the original result order
+        std::vector<size_t> selectedRows;
+        for (int id : catalog.resolve(selectedIds, listed)) {
+            const auto& rows = catalog.rowsOf(id);
+            selectedRows.insert(selectedRows.end(), rows.begin(), rows.end());
         }
+        std::sort(selectedRows.begin(), selectedRows.end());
         
-        // Filter items based on selected names (use partial matching)
         std::vector<Item> filteredItems;
-        for (const auto& item : items) {
-            std::string itemName = item.getItemName();
-            std::string lowerItemName = itemName;
-            std::transform(lowerItemName.begin(), lowerItemName.end(), lowerItemName.begin(), ::tolower);
-            
-            // Check if any selected name is contained in this item's name
-            for (const auto& selectedName : selectedList) {
-                std::string lowerSelectedName = selectedName;
-                std::transform(lowerSelectedName.begin(), lowerSelectedName.end(), lowerSelectedName.begin(), ::tolower);
-                
-                // Check if the selected name is a substring of the item name
-                // or if the item name starts with the selected name
-                if (lowerItemName.find(lowerSelectedName) != std::string::npos ||
-                    lowerSelectedName.find(lowerItemName) != std::string::npos) {
-                    filteredItems.push_back(item);
-                    break;  // Found a match, no need to check other selected names
-                }
-            }
+        filteredItems.reserve(selectedRows.size());
+        for (size_t row : selectedRows) {
+            filteredItems.push_back(items[row]);
         }
         
         std::cout << "[LLM] Filtered " << items.size() << " items down to " << filteredItems.size() << std::endl;
+        span.setAttribute("selected", filteredItems.size());
         
         return filteredItems;
         
@@ -310,10 +947,12 @@ LLMInterface::ReasoningResult LLMInterface::reasonAboutShoppingList(const std::s
         reasoningPrompt << "User's original request: \"" << originalQuery << "\"\n\n";
         reasoningPrompt << "Current shopping list:\n";
         // OPTIMIZATION: Limit list size in prompt to save tokens
-        int maxItemsToShow = std::min(30, (int)currentItems.size());
-        for (int i = 0; i < maxItemsToShow; i++) {
-            reasoningPrompt << (i + 1) << ". " << currentItems[i] << "\n";
+        PromptCatalog catalog;
+        for (const auto& name : currentItems) {
+            catalog.add(name);
         }
+        size_t maxItemsToShow = std::min<size_t>(30, currentItems.size());
+        reasoningPrompt << catalog.listing(maxItemsToShow);
         if (currentItems.size() > maxItemsToShow) {
             reasoningPrompt << "... and " << (currentItems.size() - maxItemsToShow) << " more items\n";
         }
@@ -322,7 +961,7 @@ LLMInterface::ReasoningResult LLMInterface::reasonAboutShoppingList(const std::s
         reasoningPrompt << "Consider:\n";
         reasoningPrompt << "1. Does the user's request imply a specific recipe or purpose? (e.g., 'cake ingredients' implies baking)\n";
         reasoningPrompt << "2. Are there essential items missing that would typically be needed? (e.g., eggs, flour, sugar for a cake)\n";
-        reasoningPrompt << "3. Are there any items that don't belong or seem unnecessary?\n";
+        reasoningPrompt << "3. Are there any items that don't belong or seem unnecessary? Refer to them by number.\n";
         reasoningPrompt << "4. Is there reasonable variety and completeness?\n";
         reasoningPrompt << "5. Suggest max 3-4 missing items if needed\n\n";
         reasoningPrompt << "IMPORTANT: Return ONLY a raw JSON object. Do NOT wrap it in markdown code blocks.\n";
@@ -331,7 +970,7 @@ LLMInterface::ReasoningResult LLMInterface::reasonAboutShoppingList(const std::s
         reasoningPrompt << "  \"is_complete\": true/false,\n";
         reasoningPrompt << "  \"reasoning\": \"brief explanation of your analysis\",\n";
         reasoningPrompt << "  \"missing_items\": [\"item1\", \"item2\", ...],\n";
-        reasoningPrompt << "  \"unnecessary_items\": [\"item3\", \"item4\", ...]\n";
+        reasoningPrompt << "  \"unnecessary_ids\": [3, 4, ...]\n";
         reasoningPrompt << "}\n\n";
         reasoningPrompt << "Your response must start with { and end with }.";
         
@@ -345,33 +984,7 @@ LLMInterface::ReasoningResult LLMInterface::reasonAboutShoppingList(const std::s
             return result;
         }
         
-        // Clean response
-        std::string cleanedResponse = gptResponse;
-        
-        // Remove markdown code blocks
-        size_t startPos = cleanedResponse.find("```json");
-        if (startPos != std::string::npos) {
-            cleanedResponse = cleanedResponse.substr(startPos + 7);
-        } else {
-            startPos = cleanedResponse.find("```");
-            if (startPos != std::string::npos) {
-                cleanedResponse = cleanedResponse.substr(startPos + 3);
-            }
-        }
-        
-        size_t endPos = cleanedResponse.rfind("```");
-        if (endPos != std::string::npos) {
-            cleanedResponse = cleanedResponse.substr(0, endPos);
-        }
-        
-        // Trim whitespace
-        size_t first = cleanedResponse.find_first_not_of(" \n\r\t");
-        if (first == std::string::npos) {
-            cleanedResponse = "";
-        } else {
-            size_t last = cleanedResponse.find_last_not_of(" \n\r\t");
-            cleanedResponse = cleanedResponse.substr(first, last - first + 1);
-        }
+        std::string cleanedResponse = stripCodeFence(gptResponse);
         
         std::cout << "[LLM] Reasoning response: " << cleanedResponse.substr(0, 150) << "..." << std::endl;
         
@@ -389,11 +1002,9 @@ LLMInterface::ReasoningResult LLMInterface::reasonAboutShoppingList(const std::s
             }
         }
         
-        if (parsed.contains("unnecessary_items") && parsed["unnecessary_items"].is_array()) {
-            for (const auto& item : parsed["unnecessary_items"]) {
-                if (item.is_string()) {
-                    result.unnecessaryItems.push_back(item.get<std::string>());
-                }
+        if (parsed.contains("unnecessary_ids")) {
+            for (int id : catalog.resolve(parsed["unnecessary_ids"], maxItemsToShow)) {
+                result.unnecessaryItems.push_back(catalog.nameOf(id));
             }
         }
         
@@ -411,28 +1022,47 @@ LLMInterface::ReasoningResult LLMInterface::reasonAboutShoppingList(const std::s
 }
 
 std::vector<Item> LLMInterface::refineShoppingListWithReasoning(const std::string& query, std::vector<Item> initialItems, int maxIterations) {
+    TraceSpan span("reasoning");
+    span.setAttribute("initial_items", initialItems.size());
+    
     std::cout << "[LLM] Starting reasoning-based refinement (max " << maxIterations << " iterations)..." << std::endl;
     
+    std::pmr::memory_resource* memory = RequestContext::memory();
     std::vector<Item> currentItems = initialItems;
-    std::set<std::string> currentItemNames;
+    NameSet currentItemNames(memory);
     
     for (const auto& item : currentItems) {
-        currentItemNames.insert(item.getItemName());
+        currentItemNames.emplace(item.getItemName());
     }
     
     for (int iteration = 0; iteration < maxIterations; iteration++) {
+        // Keep the list refined so far when the budget runs out
+        if (stopRequested("reasoning")) {
+            break;
+        }
+        
+        // One call for this iteration, one kept back for the final validation
+        if (!canAffordGPTStage("reasoning", 2)) {
+            span.setAttribute("downgraded", true);
+            break;
+        }
+        
         std::cout << "[LLM] Reasoning iteration " << (iteration + 1) << "/" << maxIterations << std::endl;
+        TraceSpan iterationSpan("reasoning_iteration");
+        iterationSpan.setAttribute("iteration", iteration + 1);
         
         // Convert current items to name list
         std::vector<std::string> nameList;
         for (const auto& name : currentItemNames) {
-            nameList.push_back(name);
+            nameList.emplace_back(name);
         }
         
         // Reason about the current list
         ReasoningResult reasoning = reasonAboutShoppingList(query, nameList);
         
         std::cout << "[LLM] Reasoning: " << reasoning.reasoning << std::endl;
+        iterationSpan.setAttribute("missing", reasoning.missingItems.size());
+        iterationSpan.setAttribute("unnecessary", reasoning.unnecessaryItems.size());
         
         if (reasoning.isComplete && reasoning.missingItems.empty() && reasoning.unnecessaryItems.empty()) {
             std::cout << "[LLM] List is complete after " << (iteration + 1) << " iteration(s)" << std::endl;
@@ -445,7 +1075,9 @@ std::vector<Item> LLMInterface::refineShoppingListWithReasoning(const std::strin
         if (!reasoning.unnecessaryItems.empty()) {
             std::cout << "[LLM] Removing " << reasoning.unnecessaryItems.size() << " unnecessary items..." << std::endl;
             for (const auto& unnecessaryItem : reasoning.unnecessaryItems) {
-                if (currentItemNames.erase(unnecessaryItem) > 0) {
+                auto named = currentItemNames.find(unnecessaryItem);
+                if (named != currentItemNames.end()) {
+                    currentItemNames.erase(named);
                     std::cout << "[LLM]   - Removed: " << unnecessaryItem << std::endl;
                     listModified = true;
                 }
@@ -456,6 +1088,10 @@ std::vector<Item> LLMInterface::refineShoppingListWithReasoning(const std::strin
         if (!reasoning.missingItems.empty()) {
             std::cout << "[LLM] Searching for " << reasoning.missingItems.size() << " missing items..." << std::endl;
             for (const auto& missingItem : reasoning.missingItems) {
+                if (stopRequested("reasoning_search")) {
+                    break;
+                }
+                
                 // Check if already in the list
                 if (currentItemNames.count(missingItem) > 0) {
                     std::cout << "[LLM]   - Already have: " << missingItem << std::endl;
@@ -463,18 +1099,21 @@ std::vector<Item> LLMInterface::refineShoppingListWithReasoning(const std::strin
                 }
                 
                 // Search for the missing item
+                TraceSpan searchSpan("search");
+                searchSpan.setAttribute("term", missingItem);
                 auto searchResults = storeClient->searchAllStores(missingItem);
+                searchSpan.setAttribute("results", searchResults.size());
                 if (!searchResults.empty()) {
                     // Find the best match by checking if the item name contains the search term
                     // This prevents "flour" from matching "Enfamil Formula" or "sugar" from matching "iPad Air"
                     Item* bestMatch = nullptr;
-                    std::string lowerMissingItem = missingItem;
+                    std::pmr::string lowerMissingItem(missingItem, memory);
                     std::transform(lowerMissingItem.begin(), lowerMissingItem.end(), 
                                  lowerMissingItem.begin(), ::tolower);
                     
                     // Look for exact or close match in item name
                     for (auto& result : searchResults) {
-                        std::string lowerItemName = result.getItemName();
+                        std::pmr::string lowerItemName(result.getItemName(), memory);
                         std::transform(lowerItemName.begin(), lowerItemName.end(), 
                                      lowerItemName.begin(), ::tolower);
                         
@@ -513,7 +1152,7 @@ std::vector<Item> LLMInterface::refineShoppingListWithReasoning(const std::strin
                     // If we found a good match, use it; otherwise skip this item
                     if (bestMatch != nullptr) {
                         currentItems.push_back(*bestMatch);
-                        currentItemNames.insert(bestMatch->getItemName());
+                        currentItemNames.emplace(bestMatch->getItemName());
                         std::cout << "[LLM]   + Added: " << bestMatch->getItemName() << std::endl;
                         listModified = true;
                     } else {
@@ -539,6 +1178,7 @@ std::vector<Item> LLMInterface::refineShoppingListWithReasoning(const std::strin
     }
     
     std::cout << "[LLM] Refinement complete. Final list has " << currentItemNames.size() << " unique items" << std::endl;
+    span.setAttribute("final_items", currentItemNames.size());
     
     // Perform final validation to catch any items that shouldn't be on the list
     finalItems = validateFinalList(query, finalItems);
@@ -548,6 +1188,8 @@ std::vector<Item> LLMInterface::refineShoppingListWithReasoning(const std::strin
 
 std::vector<Item> LLMInterface::validateFinalList(const std::string& query, const std::vector<Item>& items) {
     std::cout << "[LLM] Performing final validation check on the list..." << std::endl;
+    TraceSpan span("validation");
+    span.setAttribute("items", items.size());
     
     if (items.empty()) {
         std::cout << "[LLM] List is empty, skipping validation" << std::endl;
@@ -559,23 +1201,23 @@ std::vector<Item> LLMInterface::validateFinalList(const std::string& query, cons
         return items;
     }
     
+    if (stopRequested("validation") || !canAffordGPTStage("validation", 1)) {
+        span.setAttribute("skipped", true);
+        return items;
+    }
+    
     try {
-        // Extract unique item names
-        std::vector<std::string> itemNames;
-        std::set<std::string> seenNames;
-        for (const auto& item : items) {
-            if (seenNames.insert(item.getItemName()).second) {
-                itemNames.push_back(item.getItemName());
-            }
+        // Number the unique item names; GPT answers with the numbers
+        PromptCatalog catalog;
+        for (size_t i = 0; i < items.size(); i++) {
+            catalog.add(items[i].getItemName(), i);
         }
         
         // Build validation prompt
         std::ostringstream validationPrompt;
         validationPrompt << "User's original request: \"" << query << "\"\n\n";
         validationPrompt << "Final shopping list to validate:\n";
-        for (size_t i = 0; i < itemNames.size(); i++) {
-            validationPrompt << (i + 1) << ". " << itemNames[i] << "\n";
-        }
+        validationPrompt << catalog.listing();
         validationPrompt << "\n";
         validationPrompt << "Task: Perform a final validation check. Are there ANY items on this list that are OBVIOUSLY wrong or completely unrelated to the user's request?\n\n";
         validationPrompt << "Rules:\n";
@@ -586,10 +1228,10 @@ std::vector<Item> LLMInterface::validateFinalList(const std::string& query, cons
         validationPrompt << "IMPORTANT: Return ONLY a raw JSON object. Do NOT wrap it in markdown code blocks.\n";
         validationPrompt << "Format:\n";
         validationPrompt << "{\n";
-        validationPrompt << "  \"items_to_remove\": [\"Item Name 1\", \"Item Name 2\", ...],\n";
+        validationPrompt << "  \"remove_ids\": [2, 5, ...],\n";
         validationPrompt << "  \"reason\": \"brief explanation of why these items were removed\"\n";
         validationPrompt << "}\n\n";
-        validationPrompt << "If all items are valid, return: {\"items_to_remove\": [], \"reason\": \"All items are valid\"}\n";
+        validationPrompt << "If all items are valid, return: {\"remove_ids\": [], \"reason\": \"All items are valid\"}\n";
         validationPrompt << "Your response must start with { and end with }.";
         
         std::cout << "[LLM] Asking GPT to validate final list..." << std::endl;
@@ -600,70 +1242,45 @@ std::vector<Item> LLMInterface::validateFinalList(const std::string& query, cons
             return items;
         }
         
-        // Clean response
-        std::string cleanedResponse = gptResponse;
-        
-        // Remove markdown code blocks
-        size_t startPos = cleanedResponse.find("```json");
-        if (startPos != std::string::npos) {
-            cleanedResponse = cleanedResponse.substr(startPos + 7);
-        } else {
-            startPos = cleanedResponse.find("```");
-            if (startPos != std::string::npos) {
-                cleanedResponse = cleanedResponse.substr(startPos + 3);
-            }
-        }
-        
-        size_t endPos = cleanedResponse.rfind("```");
-        if (endPos != std::string::npos) {
-            cleanedResponse = cleanedResponse.substr(0, endPos);
-        }
-        
-        // Trim whitespace
-        size_t first = cleanedResponse.find_first_not_of(" \n\r\t");
-        if (first == std::string::npos) {
-            cleanedResponse = "";
-        } else {
-            size_t last = cleanedResponse.find_last_not_of(" \n\r\t");
-            cleanedResponse = cleanedResponse.substr(first, last - first + 1);
-        }
+        std::string cleanedResponse = stripCodeFence(gptResponse);
         
         std::cout << "[LLM] Validation response: " << cleanedResponse.substr(0, 150) << "..." << std::endl;
         
         // Parse JSON response
         json parsed = json::parse(cleanedResponse);
         
-        std::vector<std::string> itemsToRemove;
-        if (parsed.contains("items_to_remove") && parsed["items_to_remove"].is_array()) {
-            for (const auto& item : parsed["items_to_remove"]) {
-                if (item.is_string()) {
-                    itemsToRemove.push_back(item.get<std::string>());
-                }
-            }
+        std::vector<int> idsToRemove;
+        if (parsed.contains("remove_ids")) {
+            idsToRemove = catalog.resolve(parsed["remove_ids"]);
         }
         
         std::string reason = parsed.value("reason", "No reason provided");
         std::cout << "[LLM] Validation reason: " << reason << std::endl;
         
-        if (itemsToRemove.empty()) {
+        if (idsToRemove.empty()) {
             std::cout << "[LLM] All items passed validation!" << std::endl;
             return items;
         }
         
         // Remove invalid items
-        std::cout << "[LLM] Removing " << itemsToRemove.size() << " invalid items..." << std::endl;
-        std::set<std::string> removeSet(itemsToRemove.begin(), itemsToRemove.end());
+        std::cout << "[LLM] Removing " << idsToRemove.size() << " invalid items..." << std::endl;
+        std::vector<bool> removed(items.size(), false);
+        for (int id : idsToRemove) {
+            std::cout << "[LLM]   - Removed: " << catalog.nameOf(id) << std::endl;
+            for (size_t row : catalog.rowsOf(id)) {
+                removed[row] = true;
+            }
+        }
         
         std::vector<Item> validatedItems;
-        for (const auto& item : items) {
-            if (removeSet.find(item.getItemName()) == removeSet.end()) {
-                validatedItems.push_back(item);
-            } else {
-                std::cout << "[LLM]   - Removed: " << item.getItemName() << std::endl;
+        for (size_t i = 0; i < items.size(); i++) {
+            if (!removed[i]) {
+                validatedItems.push_back(items[i]);
             }
         }
         
         std::cout << "[LLM] Final validation complete. " << validatedItems.size() << " items remaining." << std::endl;
+        span.setAttribute("removed", items.size() - validatedItems.size());
         return validatedItems;
         
     } catch (const std::exception& e) {
@@ -699,86 +1316,43 @@ std::string LLMInterface::buildPrompt(const std::string& query, const std::strin
     return prompt.str();
 }
 
-bool LLMInterface::isSimpleQuery(const std::string& query) {
-    std::string lowerQuery = query;
-    std::transform(lowerQuery.begin(), lowerQuery.end(), lowerQuery.begin(), ::tolower);
-    
-    // Simple queries are direct product searches
-    std::vector<std::string> simpleIndicators = {
-        "find", "search", "price of", "how much"
-    };
-    
-    // Check if it's a short, direct query
-    if (query.length() < 30) {
-        for (const auto& indicator : simpleIndicators) {
-            if (lowerQuery.find(indicator) != std::string::npos) {
-                return true;
-            }
-        }
-    }
-    
-    // Check for specific product names (likely simple)
-    if (isSpecificQuery(query) && query.length() < 50) {
-        return true;
+bool LLMInterface::prefersLocalProcessing(const std::string& query, const char*& decidedBy) {
+    static Counter& modelLocal = MetricsRegistry::instance().counter(
+        "budgeteer_llm_route_decisions_total", "Local-vs-GPT routing decisions", {{"by", "model"}, {"path", "local"}});
+    static Counter& modelGPT = MetricsRegistry::instance().counter(
+        "budgeteer_llm_route_decisions_total", "Local-vs-GPT routing decisions", {{"by", "model"}, {"path", "gpt"}});
+    static Counter& rulesLocal = MetricsRegistry::instance().counter(
+        "budgeteer_llm_route_decisions_total", "Local-vs-GPT routing decisions", {{"by", "rules"}, {"path", "local"}});
+    static Counter& rulesGPT = MetricsRegistry::instance().counter(
+        "budgeteer_llm_route_decisions_total", "Local-vs-GPT routing decisions", {{"by", "rules"}, {"path", "gpt"}});
+    
+    if (intentModel) {
+        decidedBy = "model";
+        bool local = intentModel->predict(query).localProbability >= 0.5;
+        (local ? modelLocal : modelGPT).increment();
+        return local;
     }
+    decidedBy = "rules";
+    bool local = isSimpleQuery(query);
+    (local ? rulesLocal : rulesGPT).increment();
+    return local;
+}
+
+bool LLMInterface::isSimpleQuery(const std::string& query) {
+    QueryKeywords keywords = classifyQuery(query);
     
-    return false;
+    // Short, direct queries ("find", "price of", ...) and specific product names are simple
+    return (query.length() < 30 && keywords.hasSimpleIndicator) ||
+           (keywords.hasSpecificIndicator && query.length() < 50);
 }
 
 std::string LLMInterface::detectIntentLocal(const std::string& query) {
-    std::string lowerQuery = query;
-    std::transform(lowerQuery.begin(), lowerQuery.end(), lowerQuery.begin(), ::tolower);
-    
-    // Detect specific product queries
-    if (lowerQuery.find("find") != std::string::npos || 
-        lowerQuery.find("search") != std::string::npos ||
-        lowerQuery.find("look for") != std::string::npos) {
-        return "SEARCH";
-    }
-    
-    // Detect comparison queries
-    if (lowerQuery.find("compare") != std::string::npos || 
-        lowerQuery.find("cheapest") != std::string::npos ||
-        lowerQuery.find("best price") != std::string::npos) {
-        return "COMPARE";
-    }
-    
-    // Detect shopping list queries
-    if (lowerQuery.find("list") != std::string::npos || 
-        lowerQuery.find("buy") != std::string::npos ||
-        lowerQuery.find("need") != std::string::npos ||
-        lowerQuery.find("get me") != std::string::npos) {
-        return "SHOPPING_LIST";
-    }
-    
-    // Detect budget queries
-    if (lowerQuery.find("budget") != std::string::npos || 
-        lowerQuery.find("spend") != std::string::npos ||
-        lowerQuery.find("cost") != std::string::npos ||
-        lowerQuery.find("under") != std::string::npos) {
-        return "BUDGET";
-    }
-    
-    return "GENERIC";
+    return classifyQuery(query).intent;
 }
 
 bool LLMInterface::isSpecificQuery(const std::string& query) {
     // Check if query contains specific brand names or detailed product descriptions
-    std::string lowerQuery = query;
-    std::transform(lowerQuery.begin(), lowerQuery.end(), lowerQuery.begin(), ::tolower);
-    
-    std::vector<std::string> specificIndicators = {
-        "samsung", "apple", "lg", "sony", "coca-cola", "coke", "pepsi",
-        "tide", "dawn", "pampers", "huggies", "2l", "500ml", "oz", "inch"
-    };
-    
-    for (const auto& indicator : specificIndicators) {
-        if (lowerQuery.find(indicator) != std::string::npos) {
-            return true;
-        }
-    }
-    
-    return false;
+    return classifyQuery(query).hasSpecificIndicator;
 }
 
 bool LLMInterface::isGenericQuery(const std::string& query) {
@@ -821,71 +1395,46 @@ std::string LLMInterface::normalizeProductName(const std::string& productName) {
     return normalized;
 }
 
-std::vector<LLMInterface::RankedResult> LLMInterface::rankByCheapestMix(const std::vector<Item>& items) {
-    std::vector<RankedResult> results;
-    
-    // Group items by product name
-    std::map<std::string, std::vector<Item>> productGroups;
-    for (const auto& item : items) {
-        productGroups[item.getItemName()].push_back(item);
-    }
-    
-    // For each product, find the cheapest option
-    std::vector<Item> cheapestItems;
-    double totalCost = 0.0;
-    
-    for (auto& [productName, productItems] : productGroups) {
-        auto cheapest = std::min_element(productItems.begin(), productItems.end(),
-            [](const Item& a, const Item& b) {
-                return a.getCurrentPrice() < b.getCurrentPrice();
-            });
-        
-        if (cheapest != productItems.end()) {
-            cheapestItems.push_back(*cheapest);
-            totalCost += cheapest->getCurrentPrice();
+namespace {
+
+// Items bought under a plan, in product order
+LLMInterface::RankedResult rankedFromPlan(const PriceMatrix& matrix, const BasketPlan& plan, const std::string& store) {
+    LLMInterface::RankedResult result;
+    for (size_t product = 0; product < matrix.productCount(); product++) {
+        if (plan.storeOf[product] >= 0) {
+            result.items.push_back(matrix.item(product, static_cast<size_t>(plan.storeOf[product])));
         }
     }
+    result.totalCost = plan.totalCost();
+    result.store = store;
+    result.score = result.totalCost.dollars();
+    return result;
+}
+
+} // namespace
+
+std::vector<LLMInterface::RankedResult> LLMInterface::rankByCheapestMix(const std::vector<Item>& items) {
+    // One product per item name, latest price per store; no limit on stores visited
+    PriceMatrix matrix = PriceMatrix::byItemName(items);
+    BasketPlan plan = BasketOptimizer::optimize(matrix, BasketOptimizer::Options());
     
-    RankedResult result;
-    result.items = cheapestItems;
-    result.totalCost = totalCost;
-    result.store = "Mixed";
-    result.score = totalCost;
-    
-    results.push_back(result);
+    std::vector<RankedResult> results;
+    results.push_back(rankedFromPlan(matrix, plan, "Mixed"));
     return results;
 }
 
 std::vector<LLMInterface::RankedResult> LLMInterface::rankBySingleStore(const std::vector<Item>& items) {
     std::vector<RankedResult> results;
+    PriceMatrix matrix = PriceMatrix::byItemName(items);
     
-    // Group items by store
-    std::map<std::string, std::vector<Item>> storeGroups;
-    for (const auto& item : items) {
-        storeGroups[item.getStore()].push_back(item);
-    }
-    
-    // For each store, calculate total cost
-    for (const auto& [store, storeItems] : storeGroups) {
-        RankedResult result;
-        result.store = store;
-        result.items = storeItems;
-        result.totalCost = 0.0;
-        
-        for (const auto& item : storeItems) {
-            result.totalCost += item.getCurrentPrice();
+    // Stores carrying more of the products come first, then the cheaper ones
+    for (const auto& plan : BasketOptimizer::singleStorePlans(matrix, BasketOptimizer::Options())) {
+        if (plan.stores.empty()) {
+            continue;
         }
-        
-        result.score = result.totalCost;
-        results.push_back(result);
+        results.push_back(rankedFromPlan(matrix, plan, matrix.storeName(plan.stores.front())));
     }
     
-    // Sort by total cost (lowest first)
-    std::sort(results.begin(), results.end(), 
-        [](const RankedResult& a, const RankedResult& b) {
-            return a.totalCost < b.totalCost;
-        });
-    
     return results;
 }
 
@@ -896,7 +1445,12 @@ std::string LLMInterface::processQueryWithGPT(const std::string& query, Mode mod
     std::string prompt = buildPrompt(query, "Available stores: Walmart, Loblaws, Costco");
     
     // Call GPT API
-    std::string gptResponse = callGPTAPI(prompt);
+    std::string gptResponse;
+    {
+        TraceSpan span("term_extraction");
+        gptResponse = callGPTAPI(prompt, "term_extraction");
+        span.setAttribute("success", !gptResponse.empty());
+    }
     
     if (gptResponse.empty()) {
         std::cout << "[LLM] GPT failed, falling back to local processing" << std::endl;
@@ -904,36 +1458,7 @@ std::string LLMInterface::processQueryWithGPT(const std::string& query, Mode mod
     }
     
     try {
-        // Strip markdown code blocks if present (```json ... ``` or ``` ... ```)
-        std::string cleanedResponse = gptResponse;
-        
-        // Remove opening code block
-        size_t startPos = cleanedResponse.find("```json");
-        if (startPos != std::string::npos) {
-            // Found ```json, skip it and the following newline
-            cleanedResponse = cleanedResponse.substr(startPos + 7);
-        } else {
-            startPos = cleanedResponse.find("```");
-            if (startPos != std::string::npos) {
-                // Found ```, skip it and the following newline
-                cleanedResponse = cleanedResponse.substr(startPos + 3);
-            }
-        }
-        
-        // Remove closing code block
-        size_t endPos = cleanedResponse.rfind("```");
-        if (endPos != std::string::npos) {
-            cleanedResponse = cleanedResponse.substr(0, endPos);
-        }
-        
-        // Trim all whitespace (including newlines, tabs, spaces)
-        size_t first = cleanedResponse.find_first_not_of(" \n\r\t");
-        if (first == std::string::npos) {
-            cleanedResponse = "";
-        } else {
-            size_t last = cleanedResponse.find_last_not_of(" \n\r\t");
-            cleanedResponse = cleanedResponse.substr(first, last - first + 1);
-        }
+        std::string cleanedResponse = stripCodeFence(gptResponse);
         
         std::cout << "[LLM] Cleaned JSON: " << cleanedResponse.substr(0, 100) << "..." << std::endl;
         
@@ -954,11 +1479,30 @@ std::string LLMInterface::processQueryWithGPT(const std::string& query, Mode mod
             // Fallback: use original query
             searchTerms.push_back(query);
         }
+        emitProgress("intent", [&]() {
+            return json{{"intent", parsed.contains("intent") && parsed["intent"].is_string() ? parsed["intent"] : json("search")},
+                        {"source", "gpt"}};
+        });
+        emitProgress("search_terms", [&]() { return json{{"terms", searchTerms}, {"source", "gpt"}}; });
+        
+        // GPT only echoing the query back as one search term means local processing would have done
+        std::string lowerQuery = query;
+        std::transform(lowerQuery.begin(), lowerQuery.end(), lowerQuery.begin(), ::tolower);
+        std::string firstTerm = searchTerms.empty() ? std::string() : searchTerms.front();
+        std::transform(firstTerm.begin(), firstTerm.end(), firstTerm.begin(), ::tolower);
+        bool echoed = searchTerms.size() == 1 && lowerQuery.find(firstTerm) != std::string::npos;
+        logQueryLabel(echoed ? "local" : "gpt", modeName(mode), query);
         
         // Search for products
         std::vector<Item> allItems;
         for (const auto& term : searchTerms) {
+            if (stopRequested("search")) {
+                break;   // Answer with the terms searched so far
+            }
+            TraceSpan span("search");
+            span.setAttribute("term", term);
             auto items = storeClient->searchAllStores(term);
+            span.setAttribute("results", items.size());
             allItems.insert(allItems.end(), items.begin(), items.end());
         }
         
@@ -966,6 +1510,8 @@ std::string LLMInterface::processQueryWithGPT(const std::string& query, Mode mod
             return "I couldn't find any products matching your query. Try being more specific or use different keywords.";
         }
         
+        emitProgress("candidates", [&]() { return itemsSummary(allItems); });
+        
         // Cherry-pick relevant items using GPT
         std::cout << "[LLM] Found " << allItems.size() << " items, cherry-picking relevant ones..." << std::endl;
         std::vector<Item> filteredItems = cherryPickRelevantItems(query, allItems);
@@ -975,12 +1521,14 @@ std::string LLMInterface::processQueryWithGPT(const std::string& query, Mode mod
         }
         
         std::cout << "[LLM] Cherry-picked " << filteredItems.size() << " relevant items" << std::endl;
+        emitProgress("refined", [&]() {
+            json data = itemsSummary(filteredItems);
+            data["stage"] = "cherry_pick";
+            return data;
+        });
         
         // Apply reasoning-based refinement for complex queries that might need logical completion
         // (e.g., "cake ingredients" should include flour, eggs, sugar, etc.)
-        std::string lowerQuery = query;
-        std::transform(lowerQuery.begin(), lowerQuery.end(), lowerQuery.begin(), ::tolower);
-        
         bool needsReasoning = (lowerQuery.find("ingredients") != std::string::npos ||
                               lowerQuery.find("recipe") != std::string::npos ||
                               lowerQuery.find("make a") != std::string::npos ||
@@ -988,12 +1536,18 @@ std::string LLMInterface::processQueryWithGPT(const std::string& query, Mode mod
                               lowerQuery.find("cook") != std::string::npos ||
                               lowerQuery.find("prepare") != std::string::npos);
         
-        if (needsReasoning) {
+        if (needsReasoning && !stopRequested("reasoning")) {
             std::cout << "[LLM] Query requires logical reasoning - refining list..." << std::endl;
             filteredItems = refineShoppingListWithReasoning(query, filteredItems, 3);
+            emitProgress("refined", [&]() {
+                json data = itemsSummary(filteredItems);
+                data["stage"] = "reasoning";
+                return data;
+            });
         }
         
         // Format response
+        TraceSpan formatSpan("format");
         return formatResponse(filteredItems, mode);
         
     } catch (const json::exception& e) {
@@ -1004,26 +1558,201 @@ std::string LLMInterface::processQueryWithGPT(const std::string& query, Mode mod
     }
 }
 
+std::string LLMInterface::processQueryWithPlan(const std::string& query, Mode mode) {
+    std::cout << "[LLM] Processing with a single GPT planning call..." << std::endl;
+    
+    auto planned = planShoppingList(query);
+    if (!planned) {
+        std::cout << "[LLM] Planning failed, falling back to the sequential pipeline" << std::endl;
+        return processQueryWithGPT(query, mode);
+    }
+    
+    TraceSpan formatSpan("format");
+    return formatResponse(*planned, mode);
+}
+
+std::vector<std::string> LLMInterface::planningSearchTerms(const std::string& request) {
+    QueryKeywords keywords = classifyQuery(request);
+    
+    std::vector<std::string> terms;
+    auto addTerm = [&terms](const std::string& term) {
+        if (std::find(terms.begin(), terms.end(), term) == terms.end()) {
+            terms.push_back(term);
+        }
+    };
+    
+    if (!keywords.scenario.empty()) {
+        for (const auto& product : shoppingScenarios().at(keywords.scenario)) addTerm(product);
+    }
+    for (const auto& category : keywords.categories) {
+        for (const auto& product : categoryExpansions.at(category)) addTerm(product);
+    }
+    if (terms.empty()) {
+        addTerm(normalizeProductName(request));
+    }
+    return terms;
+}
+
+std::optional<std::vector<Item>> LLMInterface::planShoppingList(const std::string& request) {
+    TraceSpan span("plan");
+    
+    if (!canMakeGPTRequest() || !canAffordGPTStage("plan", 1)) {
+        recordPipelineRun("single_pass", "skipped");
+        return std::nullopt;
+    }
+    
+    // Local pre-search: the cheapest few products for every term, so the
+    // planner sees a spread of options instead of one term's results
+    std::vector<std::string> terms = planningSearchTerms(request);
+    const size_t perTerm = std::max<size_t>(3, kPlanCandidates / terms.size());
+    std::vector<Item> candidates;
+    PromptCatalog catalog;
+    {
+        TraceSpan searchSpan("pre_search");
+        for (const auto& term : terms) {
+            auto results = storeClient->searchAllStores(term);
+            std::sort(results.begin(), results.end(), [](const Item& a, const Item& b) {
+                return a.getCurrentPrice() < b.getCurrentPrice();
+            });
+            size_t taken = 0;
+            for (const auto& item : results) {
+                if (taken >= perTerm || candidates.size() >= kPlanCandidates) break;
+                if (catalog.idOf(item.getItemName()) == 0) {
+                    catalog.add(item.getItemName(), candidates.size());
+                    candidates.push_back(item);
+                    taken++;
+                }
+            }
+        }
+        searchSpan.setAttribute("terms", terms.size());
+        searchSpan.setAttribute("candidates", candidates.size());
+    }
+    emitProgress("search_terms", [&]() { return json{{"terms", terms}, {"source", "pre_search"}}; });
+    emitProgress("candidates", [&]() { return itemsSummary(candidates); });
+    
+    std::ostringstream prompt;
+    prompt << std::fixed << std::setprecision(2);
+    prompt << "User's shopping request: \"" << request << "\"\n\n";
+    prompt << "Candidate products from a local search (id. name - price at store):\n";
+    for (size_t i = 0; i < candidates.size(); i++) {
+        prompt << (i + 1) << ". " << candidates[i].getItemName() << " - $" << candidates[i].getCurrentPrice()
+               << " at " << candidates[i].getStore() << "\n";
+    }
+    prompt << "\n";
+    prompt << "Plan the complete shopping list in one step:\n";
+    prompt << "1. Select the ids of candidates that belong on the list (one per needed product, prefer cheaper ones)\n";
+    prompt << "2. Name any needed products missing from the candidates as short generic search terms\n";
+    prompt << "3. List the ids of candidates that are clearly unrelated to the request\n";
+    prompt << "4. Judge whether the selected and missing products fully cover the request\n\n";
+    prompt << "IMPORTANT: Return ONLY a raw JSON object. Do NOT wrap it in markdown code blocks.\n";
+    prompt << "Format:\n";
+    prompt << "{\n";
+    prompt << "  \"selected_ids\": [1, 4, 7],\n";
+    prompt << "  \"missing_products\": [\"product 1\", \"product 2\"],\n";
+    prompt << "  \"excluded_ids\": [2, 3],\n";
+    prompt << "  \"complete\": true,\n";
+    prompt << "  \"reasoning\": \"brief explanation\"\n";
+    prompt << "}\n\n";
+    prompt << "Your response must start with { and end with }.";
+    
+    std::cout << "[LLM] Planning with " << candidates.size() << " candidates from " << terms.size() << " terms" << std::endl;
+    std::string gptResponse = callGPTAPI(prompt.str(), "plan");
+    if (gptResponse.empty()) {
+        recordPipelineRun("single_pass", "fallback");
+        return std::nullopt;
+    }
+    
+    json plan = json::parse(stripCodeFence(gptResponse), nullptr, false);
+    if (!plan.is_object()) {
+        std::cerr << "[LLM] Planning response is not a JSON object" << std::endl;
+        recordPipelineRun("single_pass", "fallback");
+        return std::nullopt;
+    }
+    
+    // Ids are 1-based positions in the candidate list
+    std::vector<int> selected = plan.contains("selected_ids") ? catalog.resolve(plan["selected_ids"]) : std::vector<int>{};
+    std::vector<int> excludedIds = plan.contains("excluded_ids") ? catalog.resolve(plan["excluded_ids"]) : std::vector<int>{};
+    std::pmr::memory_resource* memory = RequestContext::memory();
+    std::pmr::set<int> excluded(excludedIds.begin(), excludedIds.end(), std::less<int>(), memory);
+    
+    // The planner's picks are fixed; the budget may still leave some of them out
+    ShoppingConstraints constraints = ShoppingConstraints::parse(request, knownStores());
+    std::vector<BudgetSolver::Group> groups;
+    NameSet listedNames(memory);
+    for (int id : selected) {
+        const Item& candidate = candidates[catalog.rowsOf(id).front()];
+        if (excluded.count(id) == 0 && listedNames.emplace(candidate.getItemName()).second) {
+            groups.push_back({candidate.getItemName(), {candidate}, constraints.quantityFor(candidate.getItemName())});
+        }
+    }
+    
+    // Missing products are filled in locally; the plan already judged completeness
+    size_t missingSearched = 0;
+    if (plan.contains("missing_products") && plan["missing_products"].is_array()) {
+        for (const auto& product : plan["missing_products"]) {
+            if (!product.is_string() || missingSearched >= kPlanMissingLimit) continue;
+            if (stopRequested("plan_search")) break;
+            missingSearched++;
+            TraceSpan searchSpan("search");
+            searchSpan.setAttribute("term", product.get<std::string>());
+            auto results = storeClient->searchAllStores(product.get<std::string>());
+            searchSpan.setAttribute("results", results.size());
+            results.erase(std::remove_if(results.begin(), results.end(), [&listedNames](const Item& item) {
+                return listedNames.count(item.getItemName()) > 0;
+            }), results.end());
+            if (!results.empty()) {
+                groups.push_back({product.get<std::string>(), std::move(results),
+                                  constraints.quantityFor(product.get<std::string>())});
+            }
+        }
+    }
+    std::vector<Item> shoppingList = assembleShoppingList(constraints, std::move(groups));
+    
+    if (shoppingList.empty()) {
+        std::cout << "[LLM] Plan selected no products" << std::endl;
+        recordPipelineRun("single_pass", "fallback");
+        return std::nullopt;
+    }
+    
+    bool complete = plan.value("complete", true);
+    span.setAttribute("selected", selected.size());
+    span.setAttribute("excluded", excluded.size());
+    span.setAttribute("missing", missingSearched);
+    span.setAttribute("complete", complete);
+    std::cout << "[LLM] Plan: " << selected.size() << " selected, " << excluded.size() << " excluded, "
+              << missingSearched << " missing, " << (complete ? "complete" : "incomplete") << std::endl;
+    recordPipelineRun("single_pass", "planned");
+    emitProgress("refined", [&]() {
+        json data = itemsSummary(shoppingList);
+        data["stage"] = "plan";
+        return data;
+    });
+    return shoppingList;
+}
+
 std::string LLMInterface::processQueryLocally(const std::string& query, Mode mode) {
     std::cout << "[LLM] Processing locally (fallback mode)..." << std::endl;
     
-    // Detect intent
-    std::string intent = detectIntentLocal(query);
+    // Detect intent, indicators and categories in one pass
+    QueryKeywords keywords;
+    {
+        TraceSpan span("intent");
+        keywords = classifyQuery(query);
+        span.setAttribute("intent", keywords.intent);
+    }
+    const std::string& intent = keywords.intent;
     std::cout << "[LLM] Intent detected: " << intent << std::endl;
+    emitProgress("intent", [&]() { return json{{"intent", intent}, {"source", "local"}}; });
     
     // Extract products from query
     std::vector<std::string> products;
     
-    if (isGenericQuery(query)) {
+    if (!keywords.hasSpecificIndicator) {
         // Expand generic categories
         std::cout << "[LLM] Generic query detected, expanding categories..." << std::endl;
         
-        // Simple keyword extraction
-        for (const auto& [category, expansion] : categoryExpansions) {
-            if (query.find(category) != std::string::npos) {
-                products = expansion;
-                break;
-            }
+        if (!keywords.categories.empty()) {
+            products = categoryExpansions.at(keywords.categories.front());
         }
     } else {
         // Specific query - normalize and search
@@ -1034,48 +1763,179 @@ std::string LLMInterface::processQueryLocally(const std::string& query, Mode mod
     if (products.empty()) {
         products.push_back(query);
     }
+    emitProgress("search_terms", [&]() { return json{{"terms", products}, {"source", "local"}}; });
     
     // Search for products
     std::vector<Item> allItems;
     for (const auto& product : products) {
+        TraceSpan span("search");
+        span.setAttribute("term", product);
         auto items = storeClient->searchAllStores(product);
+        span.setAttribute("results", items.size());
         allItems.insert(allItems.end(), items.begin(), items.end());
     }
     
     if (allItems.empty()) {
         return "No products found matching your query.";
     }
+    emitProgress("candidates", [&]() { return itemsSummary(allItems); });
     
     // Format response based on mode
+    TraceSpan formatSpan("format");
     return formatResponse(allItems, mode);
 }
 
 std::string LLMInterface::processNaturalLanguageQuery(const std::string& query, Mode mode) {
+    return processNaturalLanguageQuery(query, mode, defaultPipeline);
+}
+
+std::string LLMInterface::processNaturalLanguageQuery(const std::string& query, Mode mode, Pipeline pipeline) {
+    std::string key = coalescingKey("query|" + std::to_string(static_cast<int>(mode)) + "|" + pipelineName(pipeline), query);
+    return coalesce(queryFlights, "query", key, [&]() {
+        return processNaturalLanguageQueryUncoalesced(query, mode, pipeline);
+    });
+}
+
+std::string LLMInterface::processNaturalLanguageQueryUncoalesced(const std::string& query, Mode mode, Pipeline pipeline) {
     std::cout << "[LLM] Processing query: " << query << std::endl;
     std::cout << "[LLM] Using model: " << gptModel << " via GitHub" << std::endl;
     
+    TraceSpan span("llm_query");
+    
     // Decide whether to use GPT or local processing
     if (useGPT && !openaiApiKey.empty()) {
         // Use GPT for complex queries, local for simple ones (hybrid approach)
-        if (isSimpleQuery(query)) {
-            std::cout << "[LLM] Simple query detected, using local processing" << std::endl;
+        const char* decidedBy = "rules";
+        bool simple = prefersLocalProcessing(query, decidedBy);
+        span.setAttribute("path", simple ? "local" : "gpt");
+        span.setAttribute("route_by", decidedBy);
+        if (simple) {
+            std::cout << "[LLM] Simple query detected (" << decidedBy << "), using local processing" << std::endl;
+            logQueryLabel("local", modeName(mode), query);
+            return processQueryLocally(query, mode);
+        } else if (!canAffordGPTStage("gpt_route", 1)) {
+            // Upstream degraded or too little time left: answer locally straight away
+            span.setAttribute("path", "local_degraded");
             return processQueryLocally(query, mode);
         } else {
-            std::cout << "[LLM] Complex query detected, using GPT-4o-mini via GitHub" << std::endl;
+            std::cout << "[LLM] Complex query detected, using GPT-4o-mini via GitHub ("
+                      << pipelineName(pipeline) << ")" << std::endl;
+            span.setAttribute("pipeline", pipelineName(pipeline));
+            if (pipeline == Pipeline::SINGLE_PASS) {
+                return processQueryWithPlan(query, mode);
+            }
+            recordPipelineRun("sequential", "run");
             return processQueryWithGPT(query, mode);
         }
     } else {
         std::cout << "[LLM] GPT disabled or no GitHub token, using local processing" << std::endl;
+        span.setAttribute("path", "local");
         return processQueryLocally(query, mode);
     }
 }
 
+std::vector<Item> LLMInterface::assembleShoppingList(const ShoppingConstraints& constraints,
+                                                     std::vector<BudgetSolver::Group> groups) {
+    TraceSpan span("assemble");
+    
+    // Allowed stores only, latest row per product and store, best matches first
+    // (the solver only looks at the top few matches of each product)
+    for (auto& group : groups) {
+        std::vector<Item> options;
+        std::map<std::pair<std::string, std::string>, size_t> seen;
+        for (const auto& item : group.options) {
+            if (!constraints.allowsStore(item.getStore())) continue;
+            auto [it, inserted] = seen.try_emplace({item.getItemName(), item.getStore()}, options.size());
+            if (inserted) {
+                options.push_back(item);
+            } else if (item.getPriceDate() > options[it->second].getPriceDate()) {
+                options[it->second] = item;
+            }
+        }
+        if (constraints.budget && options.size() > kListOptionsPerProduct) {
+            options.resize(kListOptionsPerProduct);
+        }
+        group.options = std::move(options);
+    }
+    
+    std::vector<int> choice(groups.size(), -1);
+    if (constraints.budget) {
+        auto selection = BudgetSolver::solve(groups, *constraints.budget);
+        choice = selection.choice;
+        
+        size_t available = std::count_if(groups.begin(), groups.end(), [](const BudgetSolver::Group& group) {
+            return !group.options.empty();
+        });
+        const char* outcome = selection.covered == available ? "complete" : "trimmed";
+        MetricsRegistry::instance().counter(
+            "budgeteer_shopping_list_budget_solves_total", "Budget-constrained shopping lists by outcome",
+            {{"outcome", outcome}}).increment();
+        span.setAttribute("budget", constraints.budget->dollars());
+        span.setAttribute("covered", selection.covered);
+        span.setAttribute("outcome", outcome);
+        std::cout << "[LLM] Budget $" << *constraints.budget << ": " << selection.covered << " of " << available
+                  << " products for $" << selection.totalCost << std::endl;
+    } else {
+        // No budget: the cheapest option of every product
+        for (size_t g = 0; g < groups.size(); g++) {
+            const auto& options = groups[g].options;
+            auto cheapest = std::min_element(options.begin(), options.end(), [](const Item& a, const Item& b) {
+                return a.getCurrentPrice() < b.getCurrentPrice();
+            });
+            if (cheapest != options.end()) {
+                choice[g] = static_cast<int>(cheapest - options.begin());
+            }
+        }
+    }
+    
+    std::vector<Item> shoppingList;
+    for (size_t g = 0; g < groups.size(); g++) {
+        if (choice[g] < 0) {
+            continue;
+        }
+        const Item& item = groups[g].options[choice[g]];
+        for (int copy = 0; copy < std::max(1, groups[g].quantity); copy++) {
+            shoppingList.push_back(item);
+        }
+        std::cout << "[LLM]   + Added: " << item.getItemName();
+        if (groups[g].quantity > 1) std::cout << " x" << groups[g].quantity;
+        std::cout << " ($" << item.getCurrentPrice() << " at " << item.getStore() << ")" << std::endl;
+    }
+    return shoppingList;
+}
+
 std::vector<Item> LLMInterface::generateShoppingList(const std::string& request) {
+    return generateShoppingList(request, defaultPipeline);
+}
+
+std::vector<Item> LLMInterface::generateShoppingList(const std::string& request, Pipeline pipeline) {
+    std::string key = coalescingKey("list|" + pipelineName(pipeline), request);
+    return coalesce(listFlights, "shopping_list", key, [&]() {
+        return generateShoppingListUncoalesced(request, pipeline);
+    });
+}
+
+std::vector<Item> LLMInterface::generateShoppingListUncoalesced(const std::string& request, Pipeline pipeline) {
     std::cout << "[LLM] Generating shopping list for: " << request << std::endl;
+    TraceSpan span("shopping_list");
     
     // Use the natural language query processing to generate items
+    if (useGPT && !openaiApiKey.empty() && !canAffordGPTStage("gpt_route", 1)) {
+        span.setAttribute("path", "local_degraded");
+        return generateShoppingListLocally(request);
+    }
+    
+    if (useGPT && !openaiApiKey.empty() && pipeline == Pipeline::SINGLE_PASS) {
+        span.setAttribute("pipeline", pipelineName(pipeline));
+        if (auto planned = planShoppingList(request)) {
+            return *planned;
+        }
+        std::cout << "[LLM] Planning failed, falling back to the sequential pipeline" << std::endl;
+    }
+    
     if (useGPT && !openaiApiKey.empty()) {
         std::cout << "[LLM] Using GPT-4o-mini to generate shopping list..." << std::endl;
+        recordPipelineRun("sequential", "run");
         
         try {
             // Build a prompt specifically for shopping list generation
@@ -1095,40 +1955,19 @@ std::vector<Item> LLMInterface::generateShoppingList(const std::string& request)
             prompt << "}\n\n";
             prompt << "Your response must start with { and end with }.";
             
-            std::string gptResponse = callGPTAPI(prompt.str());
+            std::string gptResponse;
+            {
+                TraceSpan generationSpan("list_generation");
+                gptResponse = callGPTAPI(prompt.str());
+                generationSpan.setAttribute("success", !gptResponse.empty());
+            }
             
             if (gptResponse.empty()) {
                 std::cout << "[LLM] GPT call failed, falling back to local processing" << std::endl;
                 return generateShoppingListLocally(request);
             }
             
-            // Clean response
-            std::string cleanedResponse = gptResponse;
-            
-            // Remove markdown code blocks
-            size_t startPos = cleanedResponse.find("```json");
-            if (startPos != std::string::npos) {
-                cleanedResponse = cleanedResponse.substr(startPos + 7);
-            } else {
-                startPos = cleanedResponse.find("```");
-                if (startPos != std::string::npos) {
-                    cleanedResponse = cleanedResponse.substr(startPos + 3);
-                }
-            }
-            
-            size_t endPos = cleanedResponse.rfind("```");
-            if (endPos != std::string::npos) {
-                cleanedResponse = cleanedResponse.substr(0, endPos);
-            }
-            
-            // Trim whitespace
-            size_t first = cleanedResponse.find_first_not_of(" \n\r\t");
-            if (first == std::string::npos) {
-                cleanedResponse = "";
-            } else {
-                size_t last = cleanedResponse.find_last_not_of(" \n\r\t");
-                cleanedResponse = cleanedResponse.substr(first, last - first + 1);
-            }
+            std::string cleanedResponse = stripCodeFence(gptResponse);
             
             std::cout << "[LLM] Shopping list response: " << cleanedResponse.substr(0, 150) << "..." << std::endl;
             
@@ -1151,28 +1990,26 @@ std::vector<Item> LLMInterface::generateShoppingList(const std::string& request)
             std::cout << "[LLM] GPT suggested " << itemNames.size() << " items" << std::endl;
             
             // Search for each item in the database
-            std::vector<Item> shoppingList;
+            ShoppingConstraints constraints = ShoppingConstraints::parse(request, knownStores());
+            std::vector<BudgetSolver::Group> groups;
             for (const auto& itemName : itemNames) {
+                if (stopRequested("search")) {
+                    break;   // Keep the items found so far
+                }
+                TraceSpan searchSpan("search");
+                searchSpan.setAttribute("term", itemName);
                 auto searchResults = storeClient->searchAllStores(itemName);
+                searchSpan.setAttribute("results", searchResults.size());
                 
-                if (!searchResults.empty()) {
-                    // Find the cheapest option for this item
-                    auto cheapest = std::min_element(searchResults.begin(), searchResults.end(),
-                        [](const Item& a, const Item& b) {
-                            return a.getCurrentPrice() < b.getCurrentPrice();
-                        });
-                    
-                    if (cheapest != searchResults.end()) {
-                        shoppingList.push_back(*cheapest);
-                        std::cout << "[LLM]   + Added: " << cheapest->getItemName() 
-                                 << " ($" << cheapest->getCurrentPrice() << " at " 
-                                 << cheapest->getStore() << ")" << std::endl;
-                    }
-                } else {
+                if (searchResults.empty()) {
                     std::cout << "[LLM]   - Not found: " << itemName << std::endl;
+                    continue;
                 }
+                groups.push_back({itemName, std::move(searchResults), constraints.quantityFor(itemName)});
             }
             
+            std::vector<Item> shoppingList = assembleShoppingList(constraints, std::move(groups));
+            
             if (shoppingList.empty()) {
                 std::cout << "[LLM] No items found in database, trying fallback" << std::endl;
                 return generateShoppingListLocally(request);
@@ -1198,57 +2035,39 @@ std::vector<Item> LLMInterface::generateShoppingList(const std::string& request)
 std::vector<Item> LLMInterface::generateShoppingListLocally(const std::string& request) {
     std::cout << "[LLM] Generating shopping list locally..." << std::endl;
     
-    // Extract keywords from request
-    std::string lowerRequest = request;
-    std::transform(lowerRequest.begin(), lowerRequest.end(), lowerRequest.begin(), ::tolower);
-    
     std::vector<Item> shoppingList;
     
-    // Simple keyword-based matching
-    std::map<std::string, std::vector<std::string>> scenarios = {
-        {"snack", {"chips", "cookies", "soda", "candy"}},
-        {"party", {"chips", "soda", "cookies", "pizza"}},
-        {"breakfast", {"eggs", "milk", "bread", "butter", "cereal"}},
-        {"lunch", {"bread", "cheese", "meat", "lettuce"}},
-        {"dinner", {"chicken", "rice", "pasta", "sauce"}},
-        {"cake", {"flour", "sugar", "eggs", "butter", "milk"}},
-        {"pasta", {"pasta", "sauce", "cheese", "garlic"}},
-        {"groceries", {"milk", "bread", "eggs", "butter"}}
-    };
-    
     // Find matching scenario
     std::vector<std::string> searchTerms;
-    for (const auto& [keyword, items] : scenarios) {
-        if (lowerRequest.find(keyword) != std::string::npos) {
-            searchTerms = items;
-            std::cout << "[LLM] Matched scenario: " << keyword << std::endl;
-            break;
+    {
+        TraceSpan span("scenario_match");
+        std::string scenario = classifyQuery(request).scenario;
+        if (!scenario.empty()) {
+            searchTerms = shoppingScenarios().at(scenario);
+            span.setAttribute("scenario", scenario);
+            std::cout << "[LLM] Matched scenario: " << scenario << std::endl;
         }
     }
     
-    // If no scenario matched, try to extract products from the request
+    // If no scenario matched, search for the request without its budget and store phrases
+    ShoppingConstraints constraints = ShoppingConstraints::parse(request, knownStores());
     if (searchTerms.empty()) {
-        // Just use the request as-is
-        searchTerms.push_back(request);
+        searchTerms.push_back(constraints.remainder.empty() ? request : constraints.remainder);
     }
     
     // Search for each term
+    std::vector<BudgetSolver::Group> groups;
     for (const auto& term : searchTerms) {
+        TraceSpan span("search");
+        span.setAttribute("term", term);
         auto results = storeClient->searchAllStores(term);
+        span.setAttribute("results", results.size());
         
         if (!results.empty()) {
-            // Find cheapest option
-            auto cheapest = std::min_element(results.begin(), results.end(),
-                [](const Item& a, const Item& b) {
-                    return a.getCurrentPrice() < b.getCurrentPrice();
-                });
-            
-            if (cheapest != results.end()) {
-                shoppingList.push_back(*cheapest);
-                std::cout << "[LLM]   + Added: " << cheapest->getItemName() << std::endl;
-            }
+            groups.push_back({term, std::move(results), constraints.quantityFor(term)});
         }
     }
+    shoppingList = assembleShoppingList(constraints, std::move(groups));
     
     std::cout << "[LLM] Local generation found " << shoppingList.size() << " items" << std::endl;
     
@@ -1265,32 +2084,40 @@ std::string LLMInterface::getBudgetInsight(const std::vector<Item>& items) {
         return "No items to analyze.";
     }
     
-    double total = 0.0;
-    double cheapestOption = std::numeric_limits<double>::max();
-    std::string cheapestStore;
-    
-    // Calculate totals by store
-    std::map<std::string, double> storeTotals;
+    Money total;
     for (const auto& item : items) {
-        storeTotals[item.getStore()] += item.getCurrentPrice();
         total += item.getCurrentPrice();
     }
     
-    // Find cheapest store option
-    for (const auto& [store, storeTotal] : storeTotals) {
-        if (storeTotal < cheapestOption) {
-            cheapestOption = storeTotal;
-            cheapestStore = store;
-        }
-    }
+    // What the whole basket costs at each store, at current prices
+    const PriceTable& table = storeClient->getPriceTable();
+    PriceTable::StoreTotals storeTotals = table.basketTotals(table.basketOf(items));
+    int cheapest = storeTotals.cheapestStore();
     
     std::ostringstream insight;
-    insight << std::fixed << std::setprecision(2);
     insight << "Budget Insight:\n";
     insight << "- Total items: " << items.size() << "\n";
-    insight << "- Average price per item: $" << (total / items.size()) << "\n";
-    insight << "- Cheapest single-store option: " << cheapestStore << " ($" << cheapestOption << ")\n";
-    insight << "- Potential savings: $" << (total - cheapestOption) << " by shopping at " << cheapestStore;
+    insight << "- Average price per item: $" << total.dividedBy(static_cast<long long>(items.size())) << "\n";
+    if (cheapest < 0) {
+        insight << "- Cheapest single-store option: unavailable";
+        return insight.str();
+    }
+    
+    const std::string& cheapestStore = table.storeName(cheapest);
+    Money cheapestOption = storeTotals.cost[cheapest];
+    size_t missing = storeTotals.missing[cheapest];
+    insight << "- Cheapest single-store option: " << cheapestStore << " ($" << cheapestOption << ")";
+    if (missing > 0) {
+        insight << ", without " << missing << " item" << (missing == 1 ? "" : "s") << " it does not carry";
+    }
+    insight << "\n";
+    if (missing > 0) {
+        insight << "- No single store carries every item; shopping at several stores is required";
+    } else if (total > cheapestOption) {
+        insight << "- Potential savings: $" << (total - cheapestOption) << " by shopping at " << cheapestStore;
+    } else {
+        insight << "- Mixing stores saves $" << (cheapestOption - total) << " over shopping only at " << cheapestStore;
+    }
     
     return insight.str();
 }
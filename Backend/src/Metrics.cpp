@@ -0,0 +1,274 @@
+/**
+ * @file Metrics.cpp
+ * @brief Implementation of the lock-free metrics registry
+ *
+ * Registration of a new series takes the registry mutex; every update after
+ * that is a relaxed atomic operation. Scrapes read the atomics without
+ * stopping writers, so a scrape may observe a histogram whose buckets and
+ * count differ by a few in-flight samples, which Prometheus tolerates.
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "Metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <iomanip>
+
+namespace {
+
+// Index of the highest set bit (v must be non-zero)
+int highestBit(uint64_t v) {
+    int n = 0;
+    if (v >> 32) { v >>= 32; n += 32; }
+    if (v >> 16) { v >>= 16; n += 16; }
+    if (v >> 8)  { v >>= 8;  n += 8; }
+    if (v >> 4)  { v >>= 4;  n += 4; }
+    if (v >> 2)  { v >>= 2;  n += 2; }
+    if (v >> 1)  { n += 1; }
+    return n;
+}
+
+// Largest recorded value whose exported value (value * unitScale) is <= bound.
+// Bounds that are whole multiples of the unit (0.001 s = 1000 us) map exactly
+// despite floating-point rounding in the division.
+uint64_t exportLimit(double bound, double unitScale) {
+    double units = bound / unitScale;
+    if (!(units >= 0.0)) return 0;
+    if (units >= 18446744073709549568.0) return std::numeric_limits<uint64_t>::max();
+    double nearest = std::round(units);
+    if (std::fabs(units - nearest) <= 1e-9 * std::max(1.0, nearest)) {
+        return static_cast<uint64_t>(nearest);
+    }
+    return static_cast<uint64_t>(std::floor(units));
+}
+
+std::string formatNumber(double value) {
+    std::ostringstream out;
+    out << std::setprecision(12) << value;
+    return out.str();
+}
+
+} // namespace
+
+// ==================== Gauge ====================
+
+void Gauge::add(double delta) {
+    double current = value.load(std::memory_order_relaxed);
+    while (!value.compare_exchange_weak(current, current + delta, std::memory_order_relaxed)) {
+        // current is reloaded by compare_exchange_weak on failure
+    }
+}
+
+// ==================== Histogram ====================
+
+Histogram::Histogram(double unitScale, std::vector<double> exportBounds)
+    : unitScale(unitScale),
+      exportBounds(std::move(exportBounds)),
+      buckets(new std::atomic<uint64_t>[BUCKET_COUNT]),
+      exportCounts(new std::atomic<uint64_t>[this->exportBounds.size() + 1]) {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        buckets[i].store(0, std::memory_order_relaxed);
+    }
+    for (size_t b = 0; b <= this->exportBounds.size(); b++) {
+        exportCounts[b].store(0, std::memory_order_relaxed);
+    }
+    exportLimits.reserve(this->exportBounds.size());
+    for (double bound : this->exportBounds) {
+        exportLimits.push_back(exportLimit(bound, unitScale));
+    }
+}
+
+int Histogram::bucketIndex(uint64_t value) {
+    if (value < static_cast<uint64_t>(SUB_BUCKETS)) {
+        return static_cast<int>(value);
+    }
+    int exponent = highestBit(value);
+    int shift = exponent - SUB_BUCKET_BITS;
+    int sub = static_cast<int>((value >> shift) - SUB_BUCKETS);
+    return SUB_BUCKETS + shift * SUB_BUCKETS + sub;
+}
+
+uint64_t Histogram::bucketUpperBound(int index) {
+    if (index < SUB_BUCKETS) {
+        return static_cast<uint64_t>(index);
+    }
+    int shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+    uint64_t sub = static_cast<uint64_t>((index - SUB_BUCKETS) % SUB_BUCKETS);
+    // Unsigned wrap-around makes the topmost bucket end at UINT64_MAX
+    return ((SUB_BUCKETS + sub + 1) << shift) - 1;
+}
+
+void Histogram::record(uint64_t value) {
+    buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    size_t slot = std::lower_bound(exportLimits.begin(), exportLimits.end(), value) - exportLimits.begin();
+    exportCounts[slot].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+double Histogram::getSum() const {
+    return static_cast<double>(sum.load(std::memory_order_relaxed)) * unitScale;
+}
+
+double Histogram::percentile(double q) const {
+    uint64_t total = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        total += buckets[i].load(std::memory_order_relaxed);
+    }
+    if (total == 0) return 0.0;
+
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total - 1)) + 1;
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return static_cast<double>(bucketUpperBound(i)) * unitScale;
+        }
+    }
+    return static_cast<double>(bucketUpperBound(BUCKET_COUNT - 1)) * unitScale;
+}
+
+std::vector<uint64_t> Histogram::cumulativeExportCounts() const {
+    std::vector<uint64_t> counts(exportBounds.size() + 1, 0);
+    uint64_t running = 0;
+    for (size_t b = 0; b < counts.size(); b++) {
+        running += exportCounts[b].load(std::memory_order_relaxed);
+        counts[b] = running;
+    }
+    return counts;
+}
+
+std::vector<double> Histogram::latencyBounds() {
+    return {0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05,
+            0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 30.0, 60.0};
+}
+
+std::vector<double> Histogram::sizeBounds() {
+    return {0, 1, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 100000};
+}
+
+// ==================== ScopedTimer ====================
+
+uint64_t ScopedTimer::elapsedMicros() const {
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+}
+
+ScopedTimer::~ScopedTimer() {
+    histogram.record(elapsedMicros());
+}
+
+// ==================== MetricsRegistry ====================
+
+MetricsRegistry& MetricsRegistry::instance() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+MetricsRegistry::Family& MetricsRegistry::family(const std::string& name, const std::string& help, Type type) {
+    auto it = families.find(name);
+    if (it == families.end()) {
+        it = families.emplace(name, Family{}).first;
+        it->second.help = help;
+        it->second.type = type;
+    }
+    return it->second;
+}
+
+std::string MetricsRegistry::escapeLabelValue(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        switch (c) {
+            case '\\': escaped += "\\\\"; break;
+            case '"':  escaped += "\\\""; break;
+            case '\n': escaped += "\\n"; break;
+            default:   escaped += c; break;
+        }
+    }
+    return escaped;
+}
+
+std::string MetricsRegistry::formatLabels(const MetricLabels& labels) {
+    if (labels.empty()) return "";
+
+    std::string out = "{";
+    for (size_t i = 0; i < labels.size(); i++) {
+        if (i > 0) out += ",";
+        out += labels[i].first + "=\"" + escapeLabelValue(labels[i].second) + "\"";
+    }
+    out += "}";
+    return out;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help, const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& series = family(name, help, Type::COUNTER).counters[formatLabels(labels)];
+    if (!series) series = std::make_unique<Counter>();
+    return *series;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& series = family(name, help, Type::GAUGE).gauges[formatLabels(labels)];
+    if (!series) series = std::make_unique<Gauge>();
+    return *series;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help, const MetricLabels& labels,
+                                      double unitScale, std::vector<double> exportBounds) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& series = family(name, help, Type::HISTOGRAM).histograms[formatLabels(labels)];
+    if (!series) series = std::make_unique<Histogram>(unitScale, std::move(exportBounds));
+    return *series;
+}
+
+std::string MetricsRegistry::renderPrometheus() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::ostringstream out;
+
+    for (const auto& [name, fam] : families) {
+        out << "# HELP " << name << " " << fam.help << "\n";
+
+        switch (fam.type) {
+            case Type::COUNTER:
+                out << "# TYPE " << name << " counter\n";
+                for (const auto& [labels, c] : fam.counters) {
+                    out << name << labels << " " << c->get() << "\n";
+                }
+                break;
+
+            case Type::GAUGE:
+                out << "# TYPE " << name << " gauge\n";
+                for (const auto& [labels, g] : fam.gauges) {
+                    out << name << labels << " " << formatNumber(g->get()) << "\n";
+                }
+                break;
+
+            case Type::HISTOGRAM:
+                out << "# TYPE " << name << " histogram\n";
+                for (const auto& [labels, h] : fam.histograms) {
+                    // Splice the "le" label into the existing label set
+                    std::string prefix = labels.empty() ? "{" : labels.substr(0, labels.size() - 1) + ",";
+                    auto cumulative = h->cumulativeExportCounts();
+                    const auto& bounds = h->getExportBounds();
+
+                    for (size_t b = 0; b < bounds.size(); b++) {
+                        out << name << "_bucket" << prefix << "le=\"" << formatNumber(bounds[b]) << "\"} "
+                            << cumulative[b] << "\n";
+                    }
+                    out << name << "_bucket" << prefix << "le=\"+Inf\"} " << cumulative.back() << "\n";
+                    out << name << "_sum" << labels << " " << formatNumber(h->getSum()) << "\n";
+                    out << name << "_count" << labels << " " << cumulative.back() << "\n";
+                }
+                break;
+        }
+    }
+
+    return out.str();
+}
@@ -0,0 +1,123 @@
+/**
+ * @file Money.cpp
+ * @brief Parsing and formatting of cent amounts
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "Money.h"
+#include <cmath>
+#include <limits>
+#include <ostream>
+
+namespace {
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+} // namespace
+
+Money Money::fromDollars(double dollars) {
+    return Money(std::llround(dollars * 100.0));
+}
+
+std::optional<Money> Money::parse(std::string_view text) {
+    size_t i = 0;
+    auto skipSpaces = [&] {
+        while (i < text.size() && (text[i] == ' ' || text[i] == '\t' || text[i] == '\r')) i++;
+    };
+
+    skipSpaces();
+    bool negative = false;
+    if (i < text.size() && (text[i] == '-' || text[i] == '+')) {
+        negative = text[i] == '-';
+        i++;
+    }
+    if (i < text.size() && text[i] == '$') {
+        i++;
+    }
+
+    // Whole dollars; ',' only between digits
+    constexpr long long kMaxDollars = std::numeric_limits<long long>::max() / 100 - 1;
+    long long dollars = 0;
+    size_t digits = 0;
+    for (; i < text.size(); i++) {
+        if (isDigit(text[i])) {
+            if (dollars > kMaxDollars / 10) return std::nullopt;
+            dollars = dollars * 10 + (text[i] - '0');
+            digits++;
+        } else if (text[i] != ',' || digits == 0 || i + 1 >= text.size() || !isDigit(text[i + 1])) {
+            break;
+        }
+    }
+
+    // Cents, rounding on the third decimal
+    long long cents = 0;
+    if (i < text.size() && text[i] == '.') {
+        i++;
+        size_t decimals = 0;
+        for (; i < text.size() && isDigit(text[i]); i++, decimals++) {
+            int digit = text[i] - '0';
+            if (decimals < 2) {
+                cents = cents * 10 + digit;
+            } else if (decimals == 2 && digit >= 5) {
+                cents++;
+            }
+        }
+        if (decimals == 1) cents *= 10;
+        digits += decimals;
+    }
+
+    skipSpaces();
+    if (digits == 0 || i != text.size()) {
+        return std::nullopt;
+    }
+    long long total = dollars * 100 + cents;
+    return Money(negative ? -total : total);
+}
+
+char* Money::format(char* out) const {
+    // Digits are produced backwards into a scratch buffer, then copied out
+    unsigned long long magnitude = amount < 0 ? 0ULL - static_cast<unsigned long long>(amount)
+                                              : static_cast<unsigned long long>(amount);
+    char scratch[kMaxChars];
+    char* p = scratch + kMaxChars;
+    *--p = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+    *--p = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+    *--p = '.';
+    do {
+        *--p = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (amount < 0) {
+        *--p = '-';
+    }
+
+    while (p != scratch + kMaxChars) {
+        *out++ = *p++;
+    }
+    return out;
+}
+
+std::string Money::toString() const {
+    char buffer[kMaxChars];
+    return std::string(buffer, format(buffer));
+}
+
+Money Money::dividedBy(long long count) const {
+    if (count <= 0) {
+        return Money();
+    }
+    long long half = count / 2;
+    return Money(amount >= 0 ? (amount + half) / count : -((-amount + half) / count));
+}
+
+std::ostream& operator<<(std::ostream& out, Money money) {
+    char buffer[Money::kMaxChars];
+    return out << std::string_view(buffer, static_cast<size_t>(money.format(buffer) - buffer));
+}
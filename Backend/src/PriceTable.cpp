@@ -0,0 +1,206 @@
+/**
+ * @file PriceTable.cpp
+ * @brief Implementation of the dense price table and its basket kernels
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "PriceTable.h"
+#include <algorithm>
+#include <map>
+#include <set>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BUDGETEER_PRICE_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BUDGETEER_PRICE_SSE2 1
+#endif
+
+namespace {
+
+constexpr size_t kLanes = 4;   // Row padding; one AVX2 register or two SSE2 registers
+constexpr uint64_t kCarried = uint64_t{1} << 32;
+constexpr uint64_t kCentsMask = kCarried - 1;
+
+/**
+ * Add quantity * cents for every line into cost, and the carried flags into
+ * carried. Both outputs hold stride counters, stride is a multiple of kLanes
+ * and rows start on 32-byte boundaries. The 32x32 -> 64-bit multiply only
+ * reads the low half of each cell, so the flag never reaches the cost.
+ */
+void accumulateRows(const uint64_t* cells, size_t stride, const std::vector<PriceTable::BasketLine>& lines,
+                    uint64_t* cost, uint64_t* carried) {
+#if defined(BUDGETEER_PRICE_AVX2)
+    for (size_t lane = 0; lane < stride; lane += kLanes) {
+        __m256i sum = _mm256_setzero_si256();
+        __m256i present = _mm256_setzero_si256();
+        for (const auto& line : lines) {
+            __m256i row = _mm256_load_si256(reinterpret_cast<const __m256i*>(cells + static_cast<size_t>(line.row) * stride + lane));
+            __m256i quantity = _mm256_set1_epi64x(line.quantity);
+            sum = _mm256_add_epi64(sum, _mm256_mul_epu32(row, quantity));
+            present = _mm256_add_epi64(present, _mm256_srli_epi64(row, 32));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(cost + lane), sum);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(carried + lane), present);
+    }
+#elif defined(BUDGETEER_PRICE_SSE2)
+    for (size_t lane = 0; lane < stride; lane += 2) {
+        __m128i sum = _mm_setzero_si128();
+        __m128i present = _mm_setzero_si128();
+        for (const auto& line : lines) {
+            __m128i row = _mm_load_si128(reinterpret_cast<const __m128i*>(cells + static_cast<size_t>(line.row) * stride + lane));
+            __m128i quantity = _mm_set1_epi64x(line.quantity);
+            sum = _mm_add_epi64(sum, _mm_mul_epu32(row, quantity));
+            present = _mm_add_epi64(present, _mm_srli_epi64(row, 32));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(cost + lane), sum);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(carried + lane), present);
+    }
+#else
+    std::fill(cost, cost + stride, 0);
+    std::fill(carried, carried + stride, 0);
+    for (const auto& line : lines) {
+        const uint64_t* row = cells + static_cast<size_t>(line.row) * stride;
+        for (size_t lane = 0; lane < stride; lane++) {
+            cost[lane] += (row[lane] & kCentsMask) * static_cast<uint64_t>(line.quantity);
+            carried[lane] += row[lane] >> 32;
+        }
+    }
+#endif
+}
+
+} // namespace
+
+int PriceTable::StoreTotals::cheapestStore() const {
+    int best = -1;
+    for (size_t store = 0; store < cost.size(); store++) {
+        if (best < 0 || missing[store] < missing[best] ||
+            (missing[store] == missing[best] && cost[store] < cost[best])) {
+            best = static_cast<int>(store);
+        }
+    }
+    return best;
+}
+
+void PriceTable::build(const std::vector<Item>& items) {
+    // Newest row per (product, store); sorted maps keep row and column order stable
+    std::map<std::string, std::map<std::string, const Item*>> latest;
+    std::set<std::string> stores;
+    for (const auto& item : items) {
+        const Item*& slot = latest[item.getItemName()][item.getStore()];
+        if (slot == nullptr || item.getPriceDate() > slot->getPriceDate() ||
+            (item.getPriceDate() == slot->getPriceDate() && item.getCurrentPrice() < slot->getCurrentPrice())) {
+            slot = &item;
+        }
+        stores.insert(item.getStore());
+    }
+
+    productNames.clear();
+    storeNames.clear();
+    rowsByName.clear();
+    rowsByItemId.clear();
+    std::map<std::string, size_t> columns;
+    for (const auto& store : stores) {
+        columns[store] = storeNames.size();
+        storeNames.push_back(store);
+    }
+    stride = std::max(kLanes, (storeNames.size() + kLanes - 1) / kLanes * kLanes);
+    cells.assign(latest.size() * stride, 0);
+
+    for (const auto& [name, byStore] : latest) {
+        int row = static_cast<int>(productNames.size());
+        productNames.push_back(name);
+        rowsByName[name] = row;
+        for (const auto& [store, item] : byStore) {
+            long long cents = std::clamp<long long>(item->getCurrentPrice().cents(), 0, static_cast<long long>(kCentsMask));
+            cells[static_cast<size_t>(row) * stride + columns[store]] = kCarried | static_cast<uint64_t>(cents);
+        }
+    }
+    for (const auto& item : items) {
+        rowsByItemId[item.getItemId()] = rowsByName[item.getItemName()];
+    }
+}
+
+int PriceTable::rowOfItemId(int itemId) const {
+    auto it = rowsByItemId.find(itemId);
+    return it == rowsByItemId.end() ? -1 : it->second;
+}
+
+int PriceTable::rowOfName(const std::string& name) const {
+    auto it = rowsByName.find(name);
+    return it == rowsByName.end() ? -1 : it->second;
+}
+
+std::vector<PriceTable::BasketLine> PriceTable::basketOf(const std::vector<Item>& items) const {
+    std::vector<BasketLine> lines;
+    std::unordered_map<int, size_t> lineOfRow;
+    for (const auto& item : items) {
+        int row = rowOfItemId(item.getItemId());
+        if (row < 0) row = rowOfName(item.getItemName());
+        if (row < 0) continue;
+        auto [it, inserted] = lineOfRow.try_emplace(row, lines.size());
+        if (inserted) lines.push_back({row, 1});
+        else lines[it->second].quantity++;
+    }
+    return lines;
+}
+
+PriceTable::StoreTotals PriceTable::basketTotals(const std::vector<BasketLine>& lines) const {
+    std::vector<BasketLine> valid;
+    std::vector<uint64_t> cost, carried;
+    return totalsOf(lines, valid, cost, carried);
+}
+
+std::vector<PriceTable::StoreTotals> PriceTable::compareBaskets(const std::vector<std::vector<BasketLine>>& baskets) const {
+    // The kernel is vectorized across stores; baskets reference unrelated rows, so they run one
+    // after another through it, sharing scratch buffers
+    std::vector<StoreTotals> results;
+    results.reserve(baskets.size());
+    std::vector<BasketLine> valid;
+    std::vector<uint64_t> cost, carried;
+    for (const auto& basket : baskets) {
+        results.push_back(totalsOf(basket, valid, cost, carried));
+    }
+    return results;
+}
+
+PriceTable::StoreTotals PriceTable::totalsOf(const std::vector<BasketLine>& lines, std::vector<BasketLine>& valid,
+                                             std::vector<uint64_t>& cost, std::vector<uint64_t>& carried) const {
+    StoreTotals totals;
+    if (storeNames.empty()) {
+        return totals;
+    }
+
+    // Unknown rows and non-positive quantities contribute nothing
+    valid.clear();
+    for (const auto& line : lines) {
+        if (line.row >= 0 && static_cast<size_t>(line.row) < productNames.size() && line.quantity > 0) {
+            valid.push_back(line);
+        }
+    }
+
+    cost.resize(stride);
+    carried.resize(stride);
+    accumulateRows(cells.data(), stride, valid, cost.data(), carried.data());
+    totals.cost.reserve(storeNames.size());
+    totals.missing.reserve(storeNames.size());
+    for (size_t store = 0; store < storeNames.size(); store++) {
+        totals.cost.push_back(Money::fromCents(static_cast<long long>(cost[store])));
+        totals.missing.push_back(valid.size() - static_cast<size_t>(carried[store]));
+    }
+    return totals;
+}
+
+const char* PriceTable::simdPath() {
+#if defined(BUDGETEER_PRICE_AVX2)
+    return "avx2";
+#elif defined(BUDGETEER_PRICE_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,82 @@
+/**
+ * @file PromptCatalog.cpp
+ * @brief Implementation of the prompt product-ID table
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "PromptCatalog.h"
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include <unordered_set>
+#include <nlohmann/json.hpp>
+
+namespace {
+
+std::string lowercase(const std::string& text) {
+    std::string lower = text;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return lower;
+}
+
+} // namespace
+
+int PromptCatalog::add(const std::string& name, size_t row) {
+    auto [it, inserted] = idsByName.try_emplace(lowercase(name), static_cast<int>(names.size() + 1));
+    if (inserted) {
+        names.push_back(name);
+        rows.emplace_back();
+    }
+    if (row != kNoRow) {
+        rows[it->second - 1].push_back(row);
+    }
+    return it->second;
+}
+
+int PromptCatalog::idOf(const std::string& name) const {
+    auto it = idsByName.find(lowercase(name));
+    return it == idsByName.end() ? 0 : it->second;
+}
+
+std::string PromptCatalog::listing(size_t limit) const {
+    std::ostringstream lines;
+    size_t count = std::min(limit, names.size());
+    for (size_t i = 0; i < count; i++) {
+        lines << (i + 1) << ". " << names[i] << "\n";
+    }
+    return lines.str();
+}
+
+std::vector<int> PromptCatalog::resolve(const nlohmann::json& values, size_t limit) const {
+    std::vector<int> ids;
+    if (!values.is_array()) {
+        return ids;
+    }
+
+    std::unordered_set<int> seen;
+    for (const auto& value : values) {
+        int id = 0;
+        if (value.is_number_integer()) {
+            long long number = value.get<long long>();
+            id = number >= 1 && number <= static_cast<long long>(names.size()) ? static_cast<int>(number) : 0;
+        } else if (value.is_string()) {
+            const std::string& text = value.get_ref<const std::string&>();
+            bool numeric = !text.empty() && text.size() < 10 &&
+                           std::all_of(text.begin(), text.end(), [](unsigned char c) { return std::isdigit(c); });
+            if (numeric) {
+                id = std::stoi(text);
+            } else {
+                id = idOf(text);
+            }
+        }
+        bool listed = contains(id) && static_cast<size_t>(id) <= limit;
+        if (listed && seen.insert(id).second) {
+            ids.push_back(id);
+        }
+    }
+    return ids;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file RequestArena.cpp
+ * @brief Implementation of the per-request bump allocator
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "RequestArena.h"
+
+// ==================== BlockSource ====================
+
+void* RequestArena::BlockSource::do_allocate(size_t size, size_t alignment) {
+    blocks++;
+    return std::pmr::get_default_resource()->allocate(size, alignment);
+}
+
+void RequestArena::BlockSource::do_deallocate(void* p, size_t size, size_t alignment) {
+    std::pmr::get_default_resource()->deallocate(p, size, alignment);
+}
+
+bool RequestArena::BlockSource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+// ==================== RequestArena ====================
+
+RequestArena::RequestArena()
+    : buffer(kInitialBlockSize, &blockSource) {}
+
+uint64_t RequestArena::getAllocations() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return allocations;
+}
+
+uint64_t RequestArena::getBytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return bytes;
+}
+
+uint64_t RequestArena::getBlocks() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return blockSource.blocks;
+}
+
+void* RequestArena::do_allocate(size_t size, size_t alignment) {
+    std::lock_guard<std::mutex> lock(mutex);
+    allocations++;
+    bytes += size;
+    return buffer.allocate(size, alignment);
+}
+
+void RequestArena::do_deallocate(void*, size_t, size_t) {
+    // Memory is reclaimed when the arena is destroyed
+}
+
+bool RequestArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file RequestContext.cpp
+ * @brief Implementation of per-request deadlines and cancellation
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "RequestContext.h"
+#include "Metrics.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+thread_local RequestContext* currentContext = nullptr;
+
+void recordCancellation(const std::string& reason) {
+    MetricsRegistry::instance().counter(
+        "budgeteer_request_cancellations_total", "Requests cancelled before completion by reason",
+        {{"reason", reason}}).increment();
+}
+
+void recordArenaUsage(const RequestArena& arena) {
+    static Histogram& allocations = MetricsRegistry::instance().histogram(
+        "budgeteer_request_arena_allocations", "Temporaries allocated from the request arena per request",
+        {}, 1.0, Histogram::sizeBounds());
+    static Histogram& bytes = MetricsRegistry::instance().histogram(
+        "budgeteer_request_arena_bytes", "Bytes allocated from the request arena per request",
+        {}, 1.0, Histogram::sizeBounds());
+    static Histogram& blocks = MetricsRegistry::instance().histogram(
+        "budgeteer_request_arena_blocks", "Heap blocks backing the request arena per request",
+        {}, 1.0, Histogram::sizeBounds());
+    allocations.record(arena.getAllocations());
+    bytes.record(arena.getBytes());
+    blocks.record(arena.getBlocks());
+}
+
+} // namespace
+
+// ==================== Scope ====================
+
+RequestContext::Scope::Scope(RequestContext& context)
+    : previous(currentContext) {
+    currentContext = &context;
+    if (context.trace) {
+        traceScope = std::make_unique<Trace::Scope>(*context.trace);
+    }
+}
+
+RequestContext::Scope::~Scope() {
+    traceScope.reset();
+    currentContext = previous;
+}
+
+// ==================== RequestContext ====================
+
+RequestContext::RequestContext(std::chrono::milliseconds budget)
+    : deadline(Clock::now() + budget), cancelled(false), upstreamCalls(0) {}
+
+RequestContext::~RequestContext() {
+    recordArenaUsage(arena);
+}
+
+void RequestContext::cancel(const std::string& reason) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (cancelled.load()) return;
+        cancelReason = reason;
+        cancelled.store(true);
+    }
+    recordCancellation(reason);
+    std::cout << "[Request] Cancelled: " << reason << std::endl;
+}
+
+bool RequestContext::isCancelled() {
+    if (cancelled.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    if (Clock::now() >= deadline) {
+        cancel("deadline");
+        return true;
+    }
+
+    std::function<bool()> probe;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        probe = disconnectProbe;
+    }
+    if (probe && probe()) {
+        cancel("client_disconnected");
+        return true;
+    }
+    return false;
+}
+
+std::chrono::milliseconds RequestContext::remaining() const {
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now());
+    return std::max(left, std::chrono::milliseconds(0));
+}
+
+std::string RequestContext::getCancelReason() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return cancelReason;
+}
+
+void RequestContext::setDisconnectProbe(std::function<bool()> probe) {
+    std::lock_guard<std::mutex> lock(mutex);
+    disconnectProbe = std::move(probe);
+}
+
+RequestContext* RequestContext::current() {
+    return currentContext;
+}
+
+std::pmr::memory_resource* RequestContext::memory() {
+    return currentContext ? static_cast<std::pmr::memory_resource*>(&currentContext->arena)
+                          : std::pmr::get_default_resource();
+}
+
+bool RequestContext::shouldStop() {
+    return currentContext != nullptr && currentContext->isCancelled();
+}
+
+std::chrono::milliseconds RequestContext::remainingOr(std::chrono::milliseconds fallback) {
+    return currentContext ? std::min(currentContext->remaining(), fallback) : fallback;
+}
+
+bool RequestContext::isStreaming() {
+    return currentContext && currentContext->eventSink;
+}
+
+void RequestContext::emitEvent(const std::string& event, const std::string& data) {
+    if (isStreaming()) {
+        currentContext->eventSink(event, data);
+    }
+}
@@ -0,0 +1,157 @@
+/**
+ * @file ScanPool.cpp
+ * @brief Implementation of the morsel-driven scan pool
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "ScanPool.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+/// One parallelFor() call, shared by the caller and the helpers it invited
+struct ScanPool::Scan {
+    size_t count = 0;
+    size_t morselSize = 1;
+    const MorselBody* body = nullptr;
+    std::atomic<size_t> nextBegin{0};
+    std::atomic<size_t> nextWorker{1};      // The caller is worker 0
+
+    // Helpers only touch body while the caller waits for active == 0
+    std::mutex mutex;
+    std::condition_variable idle;
+    bool finished = false;
+    size_t active = 0;
+    size_t helpersWorked = 0;
+    std::exception_ptr error;
+};
+
+ScanPool::ScanPool(size_t helperThreads) : stopping(false) {
+    helpers.reserve(helperThreads);
+    for (size_t i = 0; i < helperThreads; i++) {
+        helpers.emplace_back([this]() { helperLoop(); });
+    }
+}
+
+ScanPool::~ScanPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (auto& helper : helpers) {
+        if (helper.joinable()) {
+            helper.join();
+        }
+    }
+}
+
+ScanPool& ScanPool::shared() {
+    static ScanPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return pool;
+}
+
+size_t ScanPool::runMorsels(Scan& scan, size_t worker) {
+    size_t morsels = 0;
+    while (true) {
+        size_t begin = scan.nextBegin.fetch_add(scan.morselSize, std::memory_order_relaxed);
+        if (begin >= scan.count) {
+            return morsels;
+        }
+        (*scan.body)(worker, begin, std::min(scan.count, begin + scan.morselSize));
+        morsels++;
+    }
+}
+
+size_t ScanPool::parallelFor(size_t count, size_t morselSize, size_t maxWorkers, const MorselBody& body) {
+    if (count == 0) {
+        return 0;
+    }
+    morselSize = std::max<size_t>(1, morselSize);
+    size_t morsels = (count + morselSize - 1) / morselSize;
+    size_t workers = std::min({maxWorkers, helpers.size() + 1, morsels});
+    if (workers <= 1) {
+        body(0, 0, count);
+        return 1;
+    }
+
+    auto scan = std::make_shared<Scan>();
+    scan->count = count;
+    scan->morselSize = morselSize;
+    scan->body = &body;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 1; i < workers; i++) {
+            invitations.push(scan);
+        }
+    }
+    available.notify_all();
+
+    // Scan alongside the helpers; busy helpers simply leave more morsels to the caller
+    std::exception_ptr error;
+    size_t participants = 0;
+    try {
+        participants = runMorsels(*scan, 0) > 0 ? 1 : 0;
+    } catch (...) {
+        error = std::current_exception();
+        scan->nextBegin.store(count);   // Helpers stop after their current morsel
+    }
+
+    std::unique_lock<std::mutex> lock(scan->mutex);
+    scan->finished = true;
+    scan->idle.wait(lock, [&scan]() { return scan->active == 0; });
+    if (!error) {
+        error = scan->error;
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return participants + scan->helpersWorked;
+}
+
+void ScanPool::helperLoop() {
+    while (true) {
+        std::shared_ptr<Scan> scan;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this]() { return stopping || !invitations.empty(); });
+            if (invitations.empty()) {
+                return;   // Stopping and drained
+            }
+            scan = std::move(invitations.front());
+            invitations.pop();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(scan->mutex);
+            if (scan->finished) {
+                continue;   // The caller already scanned everything
+            }
+            scan->active++;
+        }
+
+        size_t worker = scan->nextWorker.fetch_add(1, std::memory_order_relaxed);
+        size_t morsels = 0;
+        std::exception_ptr error;
+        try {
+            morsels = runMorsels(*scan, worker);
+        } catch (...) {
+            error = std::current_exception();
+            scan->nextBegin.store(scan->count);
+        }
+
+        std::lock_guard<std::mutex> lock(scan->mutex);
+        if (morsels > 0) {
+            scan->helpersWorked++;
+        }
+        if (error && !scan->error) {
+            scan->error = error;
+        }
+        if (--scan->active == 0) {
+            scan->idle.notify_all();
+        }
+    }
+}
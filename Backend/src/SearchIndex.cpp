@@ -0,0 +1,423 @@
+/**
+ * @file SearchIndex.cpp
+ * @brief Implementation of the BM25F index and its top-k walk
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "SearchIndex.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+// Calls f with every space-separated word of folded text
+template <typename F>
+void forEachWord(std::string_view text, F&& f) {
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = std::min(text.find(' ', start), text.size());
+        if (end > start) {
+            f(text.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+}
+
+uint16_t clampCount(size_t count) {
+    return static_cast<uint16_t>(std::min<size_t>(count, std::numeric_limits<uint16_t>::max()));
+}
+
+// Levenshtein distance, or maxEdits + 1 as soon as it must exceed maxEdits
+size_t boundedEditDistance(std::string_view a, std::string_view b, size_t maxEdits) {
+    thread_local std::vector<size_t> row;
+    row.resize(b.size() + 1);
+    std::iota(row.begin(), row.end(), size_t{0});
+    for (size_t i = 1; i <= a.size(); i++) {
+        size_t diagonal = row[0];
+        row[0] = i;
+        size_t rowMinimum = row[0];
+        for (size_t j = 1; j <= b.size(); j++) {
+            size_t above = row[j];
+            row[j] = std::min({above + 1, row[j - 1] + 1, diagonal + (a[i - 1] == b[j - 1] ? 0 : 1)});
+            diagonal = above;
+            rowMinimum = std::min(rowMinimum, row[j]);
+        }
+        if (rowMinimum > maxEdits) {
+            return maxEdits + 1;
+        }
+    }
+    return row[b.size()];
+}
+
+// Highest score first; equal scores in document order
+bool rankedBefore(const SearchIndex::Hit& a, const SearchIndex::Hit& b) {
+    return a.score > b.score || (a.score == b.score && a.document < b.document);
+}
+
+bool parseNumber(const std::string& text, double& value) {
+    if (text.empty()) return false;
+    char* end = nullptr;
+    errno = 0;
+    double parsed = std::strtod(text.c_str(), &end);
+    if (errno != 0 || *end != '\0' || !std::isfinite(parsed) || parsed < 0) return false;
+    value = parsed;
+    return true;
+}
+
+std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t");
+    if (first == std::string::npos) return "";
+    size_t last = text.find_last_not_of(" \t");
+    return text.substr(first, last - first + 1);
+}
+
+} // namespace
+
+// ==================== Parameters ====================
+
+std::optional<SearchIndex::Parameters> SearchIndex::Parameters::with(const std::string& spec) const {
+    Parameters result = *this;
+    std::istringstream entries(spec);
+    std::string entry;
+    while (std::getline(entries, entry, ',')) {
+        entry = trim(entry);
+        if (entry.empty()) continue;
+        size_t equals = entry.find('=');
+        if (equals == std::string::npos) return std::nullopt;
+        std::string key = trim(entry.substr(0, equals));
+        double value = 0.0;
+        if (!parseNumber(trim(entry.substr(equals + 1)), value)) return std::nullopt;
+
+        if (key == "k1") result.k1 = value;
+        else if (key == "name_weight") result.nameWeight = value;
+        else if (key == "description_weight") result.descriptionWeight = value;
+        else if (key == "name_b" && value <= 1.0) result.nameB = value;
+        else if (key == "description_b" && value <= 1.0) result.descriptionB = value;
+        else if (key == "exact_boost") result.exactBoost = value;
+        else if (key == "prefix_boost") result.prefixBoost = value;
+        else if (key == "prefix_weight") result.prefixWeight = value;
+        else if (key == "typo_weight") result.typoWeight = value;
+        else if (key == "max_expansions" && value == std::floor(value)) result.maxExpansions = static_cast<size_t>(value);
+        else if (key == "max_postings" && value == std::floor(value)) result.maxPostings = static_cast<size_t>(value);
+        else return std::nullopt;
+    }
+    return result;
+}
+
+std::string SearchIndex::Parameters::toString() const {
+    std::ostringstream text;
+    text << "k1=" << k1 << ",name_weight=" << nameWeight << ",description_weight=" << descriptionWeight
+         << ",name_b=" << nameB << ",description_b=" << descriptionB
+         << ",exact_boost=" << exactBoost << ",prefix_boost=" << prefixBoost
+         << ",prefix_weight=" << prefixWeight << ",typo_weight=" << typoWeight
+         << ",max_expansions=" << maxExpansions << ",max_postings=" << maxPostings;
+    return text.str();
+}
+
+// ==================== Building ====================
+
+void SearchIndex::build(std::vector<std::string> foldedNames, std::vector<std::string> foldedDescriptions) {
+    names = std::move(foldedNames);
+    descriptions = std::move(foldedDescriptions);
+    descriptions.resize(names.size());
+    const size_t documentCount = names.size();
+
+    // Vocabulary, sorted so prefix expansion is a range of term ids
+    std::unordered_set<std::string_view> vocabulary;
+    for (size_t document = 0; document < documentCount; document++) {
+        forEachWord(names[document], [&vocabulary](std::string_view word) { vocabulary.insert(word); });
+        forEachWord(descriptions[document], [&vocabulary](std::string_view word) { vocabulary.insert(word); });
+    }
+    terms.assign(vocabulary.begin(), vocabulary.end());
+    std::sort(terms.begin(), terms.end());
+    std::unordered_map<std::string_view, uint32_t> termIds;
+    termIds.reserve(terms.size());
+    for (size_t term = 0; term < terms.size(); term++) {
+        termIds.emplace(terms[term], static_cast<uint32_t>(term));
+    }
+
+    // Forward lists: each document's distinct terms with their field frequencies
+    struct Occurrence {
+        uint32_t term;
+        uint16_t nameFrequency;
+        uint16_t descriptionFrequency;
+    };
+    std::vector<Occurrence> occurrences;
+    std::vector<std::pair<uint32_t, bool>> words;   // (term, in name)
+    nameLengths.assign(documentCount, 0);
+    descriptionLengths.assign(documentCount, 0);
+    forwardOffsets.assign(documentCount + 1, 0);
+    std::vector<uint32_t> documentFrequency(terms.size(), 0);
+    for (size_t document = 0; document < documentCount; document++) {
+        words.clear();
+        forEachWord(names[document], [&](std::string_view word) { words.push_back({termIds.at(word), true}); });
+        nameLengths[document] = clampCount(words.size());
+        forEachWord(descriptions[document], [&](std::string_view word) { words.push_back({termIds.at(word), false}); });
+        descriptionLengths[document] = clampCount(words.size() - nameLengths[document]);
+
+        std::sort(words.begin(), words.end());
+        for (size_t i = 0; i < words.size();) {
+            size_t inDescription = 0, inName = 0;
+            size_t j = i;
+            for (; j < words.size() && words[j].first == words[i].first; j++) {
+                (words[j].second ? inName : inDescription)++;
+            }
+            occurrences.push_back({words[i].first, clampCount(inName), clampCount(inDescription)});
+            documentFrequency[words[i].first]++;
+            i = j;
+        }
+        forwardOffsets[document + 1] = static_cast<uint32_t>(occurrences.size());
+    }
+
+    // Postings: the same occurrences grouped by term (impacts come later)
+    postingOffsets.assign(terms.size() + 1, 0);
+    for (size_t term = 0; term < terms.size(); term++) {
+        postingOffsets[term + 1] = postingOffsets[term] + documentFrequency[term];
+    }
+    postings.assign(occurrences.size(), Posting{0, 0.0f, 0, 0});
+    forward.assign(occurrences.size(), TermImpact{0, 0.0f});
+    std::vector<uint32_t> fill(postingOffsets.begin(), postingOffsets.end() - 1);
+    for (size_t document = 0; document < documentCount; document++) {
+        for (uint32_t i = forwardOffsets[document]; i < forwardOffsets[document + 1]; i++) {
+            const Occurrence& occurrence = occurrences[i];
+            postings[fill[occurrence.term]++] = {static_cast<uint32_t>(document), 0.0f,
+                                                 occurrence.nameFrequency, occurrence.descriptionFrequency};
+            forward[i].term = occurrence.term;
+        }
+    }
+
+    nameOrder.resize(documentCount);
+    std::iota(nameOrder.begin(), nameOrder.end(), 0u);
+    std::stable_sort(nameOrder.begin(), nameOrder.end(),
+                     [this](uint32_t a, uint32_t b) { return names[a] < names[b]; });
+
+    computeImpacts();
+}
+
+void SearchIndex::setParameters(const Parameters& parameters) {
+    params = parameters;
+    computeImpacts();
+}
+
+void SearchIndex::computeImpacts() {
+    const size_t documentCount = names.size();
+    if (documentCount == 0) return;
+    double averageName = 0.0, averageDescription = 0.0;
+    for (size_t document = 0; document < documentCount; document++) {
+        averageName += nameLengths[document];
+        averageDescription += descriptionLengths[document];
+    }
+    averageName = averageName > 0 ? averageName / documentCount : 1.0;
+    averageDescription = averageDescription > 0 ? averageDescription / documentCount : 1.0;
+
+    for (size_t term = 0; term < terms.size(); term++) {
+        auto begin = postings.begin() + postingOffsets[term];
+        auto end = postings.begin() + postingOffsets[term + 1];
+        const double frequency = static_cast<double>(end - begin);
+        const double idf = std::log(1.0 + (documentCount - frequency + 0.5) / (frequency + 0.5));
+
+        for (auto posting = begin; posting != end; ++posting) {
+            const double nameNorm = 1.0 - params.nameB + params.nameB * nameLengths[posting->document] / averageName;
+            const double descriptionNorm = 1.0 - params.descriptionB +
+                params.descriptionB * descriptionLengths[posting->document] / averageDescription;
+            const double weighted = params.nameWeight * posting->nameFrequency / nameNorm +
+                                    params.descriptionWeight * posting->descriptionFrequency / descriptionNorm;
+            const double saturated = params.k1 + weighted > 0 ? weighted * (params.k1 + 1.0) / (params.k1 + weighted) : 0.0;
+            posting->impact = static_cast<float>(idf * saturated);
+        }
+        std::sort(begin, end, [](const Posting& a, const Posting& b) {
+            return a.impact > b.impact || (a.impact == b.impact && a.document < b.document);
+        });
+
+        // Mirror the impacts into the forward lists for exact scoring
+        for (auto posting = begin; posting != end; ++posting) {
+            auto first = forward.begin() + forwardOffsets[posting->document];
+            auto last = forward.begin() + forwardOffsets[posting->document + 1];
+            auto entry = std::lower_bound(first, last, static_cast<uint32_t>(term),
+                                          [](const TermImpact& e, uint32_t t) { return e.term < t; });
+            entry->impact = posting->impact;
+        }
+    }
+}
+
+// ==================== Querying ====================
+
+int SearchIndex::findTerm(std::string_view term) const {
+    auto it = std::lower_bound(terms.begin(), terms.end(), term,
+                               [](const std::string& a, std::string_view b) { return a < b; });
+    return it != terms.end() && *it == term ? static_cast<int>(it - terms.begin()) : -1;
+}
+
+std::pmr::vector<SearchIndex::QueryTerm> SearchIndex::expandQuery(std::string_view foldedQuery,
+                                                                  std::pmr::memory_resource* memory) const {
+    std::pmr::vector<QueryTerm> query(memory);
+    auto add = [&query](uint32_t term, double weight) {
+        for (auto& existing : query) {
+            if (existing.term == term) {
+                existing.weight = std::max(existing.weight, weight);
+                return;
+            }
+        }
+        query.push_back({term, weight});
+    };
+    auto frequencyOf = [this](uint32_t term) { return postingOffsets[term + 1] - postingOffsets[term]; };
+
+    std::pmr::vector<std::pair<uint64_t, uint32_t>> expansions(memory);   // (rank key, term)
+    auto addBest = [&](double weight) {
+        size_t keep = std::min(expansions.size(), params.maxExpansions);
+        std::partial_sort(expansions.begin(), expansions.begin() + keep, expansions.end());
+        for (size_t i = 0; i < keep; i++) {
+            add(expansions[i].second, weight);
+        }
+        expansions.clear();
+    };
+
+    forEachWord(foldedQuery, [&](std::string_view word) {
+        int exact = findTerm(word);
+        if (exact >= 0) {
+            add(static_cast<uint32_t>(exact), 1.0);
+        }
+
+        // Longer terms starting with the word ("egg" -> "eggs"), most frequent first
+        if (word.size() >= 3 && params.prefixWeight > 0) {
+            auto it = std::lower_bound(terms.begin(), terms.end(), word,
+                                       [](const std::string& a, std::string_view b) { return a < b; });
+            for (; it != terms.end() && it->compare(0, word.size(), word) == 0; ++it) {
+                uint32_t term = static_cast<uint32_t>(it - terms.begin());
+                if (it->size() > word.size()) {
+                    expansions.push_back({std::numeric_limits<uint32_t>::max() - frequencyOf(term), term});
+                }
+            }
+            addBest(params.prefixWeight);
+        }
+
+        // Unknown words may be typos: nearest terms first, then the most frequent
+        if (exact < 0 && word.size() >= 4 && params.typoWeight > 0) {
+            const size_t maxEdits = word.size() >= 8 ? 2 : 1;
+            for (uint32_t term = 0; term < terms.size(); term++) {
+                const std::string& candidate = terms[term];
+                size_t lengthGap = candidate.size() > word.size() ? candidate.size() - word.size() : word.size() - candidate.size();
+                if (lengthGap > maxEdits) continue;
+                size_t edits = boundedEditDistance(word, candidate, maxEdits);
+                if (edits <= maxEdits) {
+                    expansions.push_back({(uint64_t{edits} << 32) | (std::numeric_limits<uint32_t>::max() - frequencyOf(term)), term});
+                }
+            }
+            addBest(params.typoWeight);
+        }
+    });
+    return query;
+}
+
+double SearchIndex::boostOf(uint32_t document, std::string_view foldedQuery) const {
+    const std::string& documentName = names[document];
+    if (documentName == foldedQuery) {
+        return params.exactBoost;
+    }
+    if (documentName.size() > foldedQuery.size() && documentName[foldedQuery.size()] == ' ' &&
+        documentName.compare(0, foldedQuery.size(), foldedQuery) == 0) {
+        return params.prefixBoost;
+    }
+    return 0.0;
+}
+
+double SearchIndex::scoreOf(uint32_t document, std::string_view foldedQuery, const std::pmr::vector<QueryTerm>& query) const {
+    double score = boostOf(document, foldedQuery);
+    auto first = forward.begin() + forwardOffsets[document];
+    auto last = forward.begin() + forwardOffsets[document + 1];
+    for (const auto& queryTerm : query) {
+        auto entry = std::lower_bound(first, last, queryTerm.term,
+                                      [](const TermImpact& e, uint32_t t) { return e.term < t; });
+        if (entry != last && entry->term == queryTerm.term) {
+            score += queryTerm.weight * entry->impact;
+        }
+    }
+    return score;
+}
+
+std::pmr::vector<SearchIndex::Hit> SearchIndex::topK(std::string_view foldedQuery, size_t k,
+                                                     std::pmr::memory_resource* memory, Stats* stats) const {
+    std::pmr::vector<Hit> best(memory);   // Heap with the worst kept hit on top
+    Stats local;
+    Stats& counters = stats ? *stats : local;
+    if (k == 0 || names.empty() || foldedQuery.empty()) {
+        return best;
+    }
+    const std::pmr::vector<QueryTerm> query = expandQuery(foldedQuery, memory);
+
+    std::pmr::unordered_set<uint32_t> seen(memory);
+    auto consider = [&](uint32_t document) {
+        if (!seen.insert(document).second) return;
+        counters.documentsScored++;
+        Hit hit{document, scoreOf(document, foldedQuery, query)};
+        if (hit.score <= 0.0) return;
+        if (best.size() < k) {
+            best.push_back(hit);
+            std::push_heap(best.begin(), best.end(), rankedBefore);
+        } else if (rankedBefore(hit, best.front())) {
+            std::pop_heap(best.begin(), best.end(), rankedBefore);
+            best.back() = hit;
+            std::push_heap(best.begin(), best.end(), rankedBefore);
+        }
+    };
+
+    // Boosted products come from the sorted names, so the bound below can ignore boosts
+    auto byName = [this](uint32_t document, std::string_view key) { return names[document] < key; };
+    auto exact = std::lower_bound(nameOrder.begin(), nameOrder.end(), foldedQuery, byName);
+    for (; exact != nameOrder.end() && names[*exact] == foldedQuery; ++exact) {
+        consider(*exact);
+    }
+    std::pmr::string prefix(foldedQuery, memory);
+    prefix += ' ';
+    auto prefixed = std::lower_bound(nameOrder.begin(), nameOrder.end(), std::string_view(prefix), byName);
+    for (; prefixed != nameOrder.end() && names[*prefixed].compare(0, prefix.size(), prefix) == 0; ++prefixed) {
+        consider(*prefixed);
+    }
+
+    // Walk the postings, largest next impact first, until nothing unseen can
+    // make the top k (or the postings budget is spent)
+    struct Cursor {
+        uint32_t position;
+        uint32_t end;
+        double weight;
+    };
+    std::pmr::vector<Cursor> cursors(memory);
+    for (const auto& queryTerm : query) {
+        cursors.push_back({postingOffsets[queryTerm.term], postingOffsets[queryTerm.term + 1], queryTerm.weight});
+    }
+    size_t walked = 0;
+    while (true) {
+        double bound = 0.0;
+        double largest = -1.0;
+        size_t next = cursors.size();
+        for (size_t i = 0; i < cursors.size(); i++) {
+            if (cursors[i].position == cursors[i].end) continue;
+            double impact = cursors[i].weight * postings[cursors[i].position].impact;
+            bound += impact;
+            if (impact > largest) {
+                largest = impact;
+                next = i;
+            }
+        }
+        if (next == cursors.size() || (best.size() == k && best.front().score > bound) ||
+            (params.maxPostings > 0 && walked == params.maxPostings)) {
+            break;
+        }
+        walked++;
+        counters.postingsVisited++;
+        consider(postings[cursors[next].position++].document);
+    }
+
+    std::sort(best.begin(), best.end(), rankedBefore);
+    return best;
+}
@@ -67,15 +67,12 @@ std::vector<Item> StoreApiClient::searchWalmart(const std::string& query) {
     std::cout << "[StoreApiClient] Searching Walmart database for: " << query << std::endl;
     
     // Execute database search (uses intelligent ranking algorithm)
-    auto allResults = database->searchItems(query);
-    
-    // Filter results to Walmart items only
-    std::vector<Item> walmartItems;
-    for (const auto& item : allResults) {
-        if (item.getStore() == "Walmart") {
-            walmartItems.push_back(item);
-        }
-    }
+    auto walmartItems = database->searchItems(query);
+    
+    // Filter results to Walmart items only (in place, without copying items)
+    walmartItems.erase(std::remove_if(walmartItems.begin(), walmartItems.end(), [](const Item& item) {
+        return item.getStore() != "Walmart";
+    }), walmartItems.end());
     
     std::cout << "[StoreApiClient] Found " << walmartItems.size() << " Walmart items" << std::endl;
     return walmartItems;
@@ -90,14 +87,10 @@ std::vector<Item> StoreApiClient::searchLoblaws(const std::string& query) {
     
     std::cout << "[StoreApiClient] Searching Loblaws database for: " << query << std::endl;
     
-    auto allResults = database->searchItems(query);
-    std::vector<Item> loblawsItems;
-    
-    for (const auto& item : allResults) {
-        if (item.getStore() == "Loblaws") {
-            loblawsItems.push_back(item);
-        }
-    }
+    auto loblawsItems = database->searchItems(query);
+    loblawsItems.erase(std::remove_if(loblawsItems.begin(), loblawsItems.end(), [](const Item& item) {
+        return item.getStore() != "Loblaws";
+    }), loblawsItems.end());
     
     std::cout << "[StoreApiClient] Found " << loblawsItems.size() << " Loblaws items" << std::endl;
     return loblawsItems;
@@ -112,14 +105,10 @@ std::vector<Item> StoreApiClient::searchCostco(const std::string& query) {
     
     std::cout << "[StoreApiClient] Searching Costco database for: " << query << std::endl;
     
-    auto allResults = database->searchItems(query);
-    std::vector<Item> costcoItems;
-    
-    for (const auto& item : allResults) {
-        if (item.getStore() == "Costco") {
-            costcoItems.push_back(item);
-        }
-    }
+    auto costcoItems = database->searchItems(query);
+    costcoItems.erase(std::remove_if(costcoItems.begin(), costcoItems.end(), [](const Item& item) {
+        return item.getStore() != "Costco";
+    }), costcoItems.end());
     
     std::cout << "[StoreApiClient] Found " << costcoItems.size() << " Costco items" << std::endl;
     return costcoItems;
@@ -202,3 +191,12 @@ std::vector<Item> StoreApiClient::comparePrices(const std::string& productName)
     std::cout << "[StoreApiClient] Sorted " << items.size() << " items by price" << std::endl;
     return items;
 }
+
+/**
+ * Latest price of every product at every store, for whole-basket totals.
+ * An empty table is returned when no database is attached.
+ */
+const PriceTable& StoreApiClient::getPriceTable() const {
+    static const PriceTable empty;
+    return database ? database->getPriceTable() : empty;
+}
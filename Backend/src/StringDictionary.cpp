@@ -0,0 +1,44 @@
+/**
+ * @file StringDictionary.cpp
+ * @brief Implementation of the string interning dictionary
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "StringDictionary.h"
+#include <algorithm>
+#include <stdexcept>
+
+StringDictionary::StringDictionary(size_t capacity) : limit(capacity) {}
+
+uint32_t StringDictionary::intern(const std::string& value) {
+    auto it = ids.find(value);
+    if (it != ids.end()) {
+        return it->second;
+    }
+    if (names.size() >= limit) {
+        throw std::length_error("more than " + std::to_string(limit) + " distinct values (at '" + value + "')");
+    }
+    uint32_t id = static_cast<uint32_t>(names.size());
+    names.push_back(value);
+    ids.emplace(value, id);
+    return id;
+}
+
+int StringDictionary::find(const std::string& value) const {
+    auto it = ids.find(value);
+    return it == ids.end() ? -1 : static_cast<int>(it->second);
+}
+
+std::vector<std::string> StringDictionary::sortedNames() const {
+    std::vector<std::string> sorted = names;
+    std::sort(sorted.begin(), sorted.end());
+    return sorted;
+}
+
+void StringDictionary::clear() {
+    names.clear();
+    ids.clear();
+}
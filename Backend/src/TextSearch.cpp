@@ -0,0 +1,171 @@
+/**
+ * @file TextSearch.cpp
+ * @brief Implementation of text folding and the substring kernels
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "TextSearch.h"
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define BUDGETEER_TEXT_DISPATCH 1
+#endif
+
+namespace {
+
+// Folded form of U+00C0..U+00FF; a space marks symbols that separate words
+const char* const kLatin1Folds[64] = {
+    "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+    "d", "n", "o", "o", "o", "o", "o", " ", "o", "u", "u", "u", "u", "y", "th", "ss",
+    "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+    "d", "n", "o", "o", "o", "o", "o", " ", "o", "u", "u", "u", "u", "y", "th", "y"
+};
+
+bool containsScalar(std::string_view haystack, std::string_view needle) {
+    return haystack.find(needle) != std::string_view::npos;
+}
+
+#if defined(BUDGETEER_TEXT_DISPATCH)
+
+/**
+ * Both kernels compare the needle's first byte against a block of start
+ * positions and its last byte against the same positions shifted by
+ * needle.size() - 1. Only positions where both match get a full compare.
+ * Blocks stop before reading past the haystack; the rest is scanned scalar.
+ */
+__attribute__((target("sse2")))
+bool containsSse2(std::string_view haystack, std::string_view needle) {
+    const size_t n = needle.size();
+    const size_t middle = n > 2 ? n - 2 : 0;
+    const __m128i first = _mm_set1_epi8(needle.front());
+    const __m128i last = _mm_set1_epi8(needle.back());
+    size_t i = 0;
+    for (; i + n - 1 + 16 <= haystack.size(); i += 16) {
+        const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack.data() + i));
+        const __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack.data() + i + n - 1));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast))));
+        while (mask != 0) {
+            const unsigned offset = static_cast<unsigned>(__builtin_ctz(mask));
+            if (std::memcmp(haystack.data() + i + offset + 1, needle.data() + 1, middle) == 0) {
+                return true;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return containsScalar(haystack.substr(i), needle);
+}
+
+__attribute__((target("avx2")))
+bool containsAvx2(std::string_view haystack, std::string_view needle) {
+    const size_t n = needle.size();
+    const size_t middle = n > 2 ? n - 2 : 0;
+    const __m256i first = _mm256_set1_epi8(needle.front());
+    const __m256i last = _mm256_set1_epi8(needle.back());
+    size_t i = 0;
+    for (; i + n - 1 + 32 <= haystack.size(); i += 32) {
+        const __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack.data() + i));
+        const __m256i blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack.data() + i + n - 1));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst), _mm256_cmpeq_epi8(last, blockLast))));
+        while (mask != 0) {
+            const unsigned offset = static_cast<unsigned>(__builtin_ctz(mask));
+            if (std::memcmp(haystack.data() + i + offset + 1, needle.data() + 1, middle) == 0) {
+                return true;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return containsSse2(haystack.substr(i), needle);
+}
+
+#endif
+
+struct Kernel {
+    bool (*contains)(std::string_view, std::string_view);
+    const char* name;
+};
+
+const Kernel& kernel() {
+    static const Kernel selected = [] {
+#if defined(BUDGETEER_TEXT_DISPATCH)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return Kernel{containsAvx2, "avx2"};
+        if (__builtin_cpu_supports("sse2")) return Kernel{containsSse2, "sse2"};
+#endif
+        return Kernel{containsScalar, "scalar"};
+    }();
+    return selected;
+}
+
+// Shared by both fold() overloads (see TextSearch.h for the rules)
+template <typename String>
+void foldInto(std::string_view text, String& folded) {
+    folded.reserve(text.size());
+    bool pendingSpace = false;
+    auto append = [&](const char* piece) {
+        if (pendingSpace && !folded.empty()) folded += ' ';
+        pendingSpace = false;
+        folded += piece;
+    };
+
+    for (size_t i = 0; i < text.size(); i++) {
+        const unsigned char c = static_cast<unsigned char>(text[i]);
+        if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
+            const char piece[2] = {static_cast<char>(c), '\0'};
+            append(piece);
+        } else if (c >= 'A' && c <= 'Z') {
+            const char piece[2] = {static_cast<char>(c - 'A' + 'a'), '\0'};
+            append(piece);
+        } else if (c == '\'') {
+            // Dropped: "kellogg's" matches "kelloggs"
+        } else if (c < 0x80) {
+            pendingSpace = true;
+        } else if (c == 0xC3 && i + 1 < text.size() && (static_cast<unsigned char>(text[i + 1]) & 0xC0) == 0x80) {
+            const char* piece = kLatin1Folds[static_cast<unsigned char>(text[++i]) - 0x80];
+            if (piece[0] == ' ') pendingSpace = true; else append(piece);
+        } else if (c == 0xC2 && i + 1 < text.size()) {
+            i++;   // Latin-1 symbols (no-break space, (R), degree sign, ...)
+            pendingSpace = true;
+        } else if (c == 0xE2 && i + 2 < text.size() && static_cast<unsigned char>(text[i + 1]) == 0x80 &&
+                   static_cast<unsigned char>(text[i + 2]) == 0x99) {
+            i += 2;   // Right single quotation mark, used as an apostrophe
+        } else {
+            // Other UTF-8 bytes are kept as they are
+            const char piece[2] = {static_cast<char>(c), '\0'};
+            append(piece);
+        }
+    }
+}
+
+} // namespace
+
+std::string TextSearch::fold(std::string_view text) {
+    std::string folded;
+    foldInto(text, folded);
+    return folded;
+}
+
+std::pmr::string TextSearch::fold(std::string_view text, std::pmr::memory_resource* memory) {
+    std::pmr::string folded(memory);
+    foldInto(text, folded);
+    return folded;
+}
+
+bool TextSearch::contains(std::string_view haystack, std::string_view needle) {
+    if (needle.empty()) {
+        return true;
+    }
+    if (needle.size() > haystack.size()) {
+        return false;
+    }
+    return kernel().contains(haystack, needle);
+}
+
+const char* TextSearch::kernelName() {
+    return kernel().name;
+}
@@ -0,0 +1,224 @@
+/**
+ * @file Tracing.cpp
+ * @brief Implementation of request traces, spans and their exporters
+ *
+ * The current trace and innermost open span are tracked per thread, so a
+ * request handled on one httplib worker never sees spans from another.
+ * Chrome trace output uses the JSON Array format; the closing bracket is
+ * optional in that format, which lets us append one event per line for the
+ * lifetime of the process.
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "Tracing.h"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <nlohmann/json.hpp>
+
+namespace {
+
+thread_local Trace* currentTrace = nullptr;
+thread_local int currentSpan = -1;
+
+std::mutex traceFileMutex;
+std::string traceFilePath;
+bool traceFileStarted = false;
+
+// Small sequential thread ids keep the Chrome timeline readable
+uint64_t currentThreadId() {
+    static std::atomic<uint64_t> nextThreadId{1};
+    thread_local uint64_t threadId = nextThreadId.fetch_add(1);
+    return threadId;
+}
+
+} // namespace
+
+// ==================== Trace ====================
+
+Trace::Trace(std::string name)
+    : name(std::move(name)),
+      start(std::chrono::steady_clock::now()),
+      startEpochMicros(std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::system_clock::now().time_since_epoch()).count()) {}
+
+Trace::Scope::Scope(Trace& trace)
+    : previousTrace(currentTrace), previousSpan(currentSpan) {
+    currentTrace = &trace;
+    currentSpan = -1;
+}
+
+Trace::Scope::~Scope() {
+    currentTrace = previousTrace;
+    currentSpan = previousSpan;
+}
+
+Trace* Trace::current() {
+    return currentTrace;
+}
+
+int Trace::beginSpan(const std::string& spanName, int parentId) {
+    auto offset = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    int id = static_cast<int>(spans.size());
+    spans.push_back({id, parentId, spanName, offset, -1, currentThreadId(), {}});
+    return id;
+}
+
+void Trace::endSpan(int spanId) {
+    auto offset = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (spanId >= 0 && spanId < static_cast<int>(spans.size())) {
+        spans[spanId].durationMicros = offset - spans[spanId].startMicros;
+    }
+}
+
+void Trace::addAttribute(int spanId, const std::string& key, const std::string& value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (spanId >= 0 && spanId < static_cast<int>(spans.size())) {
+        spans[spanId].attributes.emplace_back(key, value);
+    }
+}
+
+std::vector<Trace::SpanRecord> Trace::getSpans() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return spans;
+}
+
+std::string Trace::serverTimingHeader() const {
+    struct Aggregate {
+        int64_t micros = 0;
+        int count = 0;
+        size_t firstSeen = 0;
+    };
+
+    std::map<std::string, Aggregate> byName;
+    for (const auto& span : getSpans()) {
+        if (span.durationMicros < 0) continue;
+        auto it = byName.find(span.name);
+        if (it == byName.end()) {
+            it = byName.emplace(span.name, Aggregate{}).first;
+            it->second.firstSeen = byName.size();
+        }
+        it->second.micros += span.durationMicros;
+        it->second.count++;
+    }
+
+    // Keep the order in which stages first ran
+    std::vector<std::pair<std::string, Aggregate>> ordered(byName.begin(), byName.end());
+    std::sort(ordered.begin(), ordered.end(), [](const auto& a, const auto& b) {
+        return a.second.firstSeen < b.second.firstSeen;
+    });
+
+    std::ostringstream header;
+    header << std::fixed << std::setprecision(1);
+    for (size_t i = 0; i < ordered.size(); i++) {
+        if (i > 0) header << ", ";
+        header << ordered[i].first << ";dur=" << (ordered[i].second.micros / 1000.0);
+        if (ordered[i].second.count > 1) {
+            header << ";desc=\"x" << ordered[i].second.count << "\"";
+        }
+    }
+    return header.str();
+}
+
+void Trace::finish() const {
+    std::lock_guard<std::mutex> fileLock(traceFileMutex);
+    if (traceFilePath.empty()) return;
+
+    std::ofstream out(traceFilePath, traceFileStarted ? std::ios::app : std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "[Trace] Could not open trace file " << traceFilePath << std::endl;
+        return;
+    }
+    if (!traceFileStarted) {
+        out << "[\n";
+        traceFileStarted = true;
+    }
+
+    for (const auto& span : getSpans()) {
+        nlohmann::json event = {
+            {"name", span.name},
+            {"cat", name},
+            {"ph", "X"},
+            {"ts", startEpochMicros + span.startMicros},
+            {"dur", span.durationMicros < 0 ? 0 : span.durationMicros},
+            {"pid", 1},
+            {"tid", span.threadId}
+        };
+        nlohmann::json args = nlohmann::json::object();
+        args["span_id"] = span.id;
+        args["parent_id"] = span.parentId;
+        for (const auto& [key, value] : span.attributes) {
+            args[key] = value;
+        }
+        event["args"] = args;
+        out << event.dump() << ",\n";
+    }
+}
+
+void Trace::setChromeTraceFile(const std::string& path) {
+    std::lock_guard<std::mutex> lock(traceFileMutex);
+    traceFilePath = path;
+    traceFileStarted = false;
+    if (!path.empty()) {
+        std::cout << "[Trace] Writing Chrome trace events to " << path << std::endl;
+    }
+}
+
+std::string Trace::getChromeTraceFile() {
+    std::lock_guard<std::mutex> lock(traceFileMutex);
+    return traceFilePath;
+}
+
+// ==================== TraceSpan ====================
+
+TraceSpan::TraceSpan(const std::string& name)
+    : trace(currentTrace), spanId(-1), previousSpan(currentSpan) {
+    if (trace) {
+        spanId = trace->beginSpan(name, previousSpan);
+        currentSpan = spanId;
+    }
+}
+
+TraceSpan::~TraceSpan() {
+    if (trace) {
+        trace->endSpan(spanId);
+        currentSpan = previousSpan;
+    }
+}
+
+void TraceSpan::setAttribute(const std::string& key, const std::string& value) {
+    if (trace) trace->addAttribute(spanId, key, value);
+}
+
+void TraceSpan::setAttribute(const std::string& key, const char* value) {
+    if (trace) trace->addAttribute(spanId, key, value);
+}
+
+void TraceSpan::setAttribute(const std::string& key, long long value) {
+    if (trace) trace->addAttribute(spanId, key, std::to_string(value));
+}
+
+void TraceSpan::setAttribute(const std::string& key, double value) {
+    if (trace) {
+        std::ostringstream out;
+        out << value;
+        trace->addAttribute(spanId, key, out.str());
+    }
+}
+
+void TraceSpan::setAttribute(const std::string& key, bool value) {
+    if (trace) trace->addAttribute(spanId, key, value ? "true" : "false");
+}
@@ -15,8 +15,12 @@
  */
 
 #include "ApiServer.h"
+#include "Tracing.h"
 #include <iostream>
 #include <string>
+#include <sstream>
+#include <vector>
+#include <cstdlib>
 
 /**
  * @brief Main application entry point
@@ -31,6 +35,25 @@
  * Command-line options:
  *   --http, -h          Start in HTTP server mode (default: CLI mode)
  *   --port, -p <num>    Set server port (default: 8080)
+ *   --trace-file <path> Append Chrome trace events for LLM requests to <path>
+ *                       (also read from the BUDGETEER_TRACE_FILE environment variable)
+ *   --llm-endpoint <url> Chat completions base URL (default: https://models.github.ai/inference,
+ *                       also read from BUDGETEER_LLM_ENDPOINT), e.g. a local budgeteer_mock_llm
+ *   --llm-deadline-ms <n> End-to-end budget for one LLM request (default: 25000)
+ *   --llm-pipeline <name> sequential (default) or single_pass; requests may override it
+ *   --search-params <spec> Catalogue ranking parameters, e.g. "k1=1.5,prefix_boost=6,max_postings=2000"
+ *                       (also read from BUDGETEER_SEARCH_PARAMS)
+ *   --intent-model <file> Learned local-vs-GPT router from budgeteer_train_intent
+ *                       (also read from BUDGETEER_INTENT_MODEL)
+ *   --catalogue-threads <n> HTTP workers reserved for catalogue routes (default: max(4, cores))
+ *   --llm-threads <n>   Threads running LLM requests (default: 8)
+ *   --llm-queue <n>     LLM requests allowed to wait for a thread before 503 (default: 16)
+ *   --client-rate <r>   Sustained LLM requests per second per client before 429 (default: 1)
+ *   --client-burst <n>  LLM requests a client may send back to back (default: 5)
+ *   --llm-max-concurrent <n> Admitted LLM requests in flight before 503 (default: threads + queue)
+ *   --llm-latency-budget-ms <n> Shed LLM requests whose estimated queue wait exceeds this (default: 12000)
+ *   --trusted-proxy <addr> Peer whose X-Forwarded-For header identifies the client; repeatable
+ *                       (also read as a comma-separated list from BUDGETEER_TRUSTED_PROXIES)
  *   --help              Display help message
  * 
  * Example usage:
@@ -49,6 +72,43 @@ int main(int argc, char* argv[]) {
     bool httpMode = false;  // Default to CLI mode
     int port = 8080;        // Default HTTP port
     
+    // Optional Chrome trace output for LLM pipeline spans
+    const char* envTraceFile = std::getenv("BUDGETEER_TRACE_FILE");
+    std::string traceFile = envTraceFile ? envTraceFile : "";
+    
+    // Optional chat completions endpoint override (environment is handled by LLMInterface)
+    std::string llmEndpoint;
+    int llmDeadlineMs = 0;  // 0 = server default
+    std::string llmPipeline;
+    std::string intentModel;
+    
+    // Optional search ranking parameters (see SearchIndex::Parameters)
+    const char* envSearchParams = std::getenv("BUDGETEER_SEARCH_PARAMS");
+    std::string searchParams = envSearchParams ? envSearchParams : "";
+    
+    // Worker sizing per route class (-1 = server default)
+    int catalogueThreads = -1;
+    int llmThreads = -1;
+    int llmQueue = -1;
+    
+    // Admission control (negative = server default)
+    double clientRate = -1.0;
+    double clientBurst = -1.0;
+    int llmMaxConcurrent = -1;
+    int llmLatencyBudgetMs = -1;
+    
+    // Reverse proxies allowed to name the client in X-Forwarded-For
+    std::vector<std::string> trustedProxies;
+    if (const char* envTrustedProxies = std::getenv("BUDGETEER_TRUSTED_PROXIES")) {
+        std::stringstream list(envTrustedProxies);
+        std::string address;
+        while (std::getline(list, address, ',')) {
+            if (!address.empty()) {
+                trustedProxies.push_back(address);
+            }
+        }
+    }
+    
     // Parse command-line arguments
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
@@ -63,12 +123,104 @@ int main(int argc, char* argv[]) {
                 port = std::stoi(argv[++i]);
             }
         } 
+        // Check for Chrome trace output
+        else if (arg == "--trace-file") {
+            if (i + 1 < argc) {
+                traceFile = argv[++i];
+            }
+        } 
+        // Check for LLM endpoint override
+        else if (arg == "--llm-endpoint") {
+            if (i + 1 < argc) {
+                llmEndpoint = argv[++i];
+            }
+        } 
+        // Check for LLM request deadline
+        else if (arg == "--llm-deadline-ms") {
+            if (i + 1 < argc) {
+                llmDeadlineMs = std::stoi(argv[++i]);
+            }
+        } 
+        // Check for default LLM pipeline
+        else if (arg == "--llm-pipeline") {
+            if (i + 1 < argc) {
+                llmPipeline = argv[++i];
+            }
+        } 
+        // Check for search ranking parameters
+        else if (arg == "--search-params") {
+            if (i + 1 < argc) {
+                searchParams = argv[++i];
+            }
+        } 
+        // Check for learned query router
+        else if (arg == "--intent-model") {
+            if (i + 1 < argc) {
+                intentModel = argv[++i];
+            }
+        } 
+        // Check for worker sizing
+        else if (arg == "--catalogue-threads") {
+            if (i + 1 < argc) {
+                catalogueThreads = std::stoi(argv[++i]);
+            }
+        } 
+        else if (arg == "--llm-threads") {
+            if (i + 1 < argc) {
+                llmThreads = std::stoi(argv[++i]);
+            }
+        } 
+        else if (arg == "--llm-queue") {
+            if (i + 1 < argc) {
+                llmQueue = std::stoi(argv[++i]);
+            }
+        } 
+        // Check for admission control limits
+        else if (arg == "--client-rate") {
+            if (i + 1 < argc) {
+                clientRate = std::stod(argv[++i]);
+            }
+        } 
+        else if (arg == "--client-burst") {
+            if (i + 1 < argc) {
+                clientBurst = std::stod(argv[++i]);
+            }
+        } 
+        else if (arg == "--llm-max-concurrent") {
+            if (i + 1 < argc) {
+                llmMaxConcurrent = std::stoi(argv[++i]);
+            }
+        } 
+        else if (arg == "--llm-latency-budget-ms") {
+            if (i + 1 < argc) {
+                llmLatencyBudgetMs = std::stoi(argv[++i]);
+            }
+        } 
+        else if (arg == "--trusted-proxy") {
+            if (i + 1 < argc) {
+                trustedProxies.push_back(argv[++i]);
+            }
+        } 
         // Display help information
         else if (arg == "--help") {
             std::cout << "Usage: " << argv[0] << " [options]\n\n";
             std::cout << "Options:\n";
             std::cout << "  --http, -h        Start HTTP server mode (requires cpp-httplib)\n";
             std::cout << "  --port, -p <num>  Set server port (default: 8080)\n";
+            std::cout << "  --trace-file <path>  Write Chrome trace events for LLM requests\n";
+            std::cout << "  --llm-endpoint <url> Chat completions base URL (e.g. http://localhost:8089/inference)\n";
+            std::cout << "  --llm-deadline-ms <n>  End-to-end budget per LLM request (default: 25000)\n";
+            std::cout << "  --llm-pipeline <name>  sequential or single_pass (default: sequential)\n";
+            std::cout << "  --search-params <spec>  Search ranking, e.g. k1=1.5,prefix_boost=6,max_postings=2000\n";
+            std::cout << "  --intent-model <file>  Learned local-vs-GPT router (budgeteer_train_intent)\n";
+            std::cout << "  --catalogue-threads <n>  HTTP workers reserved for catalogue routes\n";
+            std::cout << "  --llm-threads <n>    Threads running LLM requests (default: 8)\n";
+            std::cout << "  --llm-queue <n>      LLM requests that may wait before 503 (default: 16)\n";
+            std::cout << "  --client-rate <r>    LLM requests per second per client before 429 (default: 1)\n";
+            std::cout << "  --client-burst <n>   LLM requests a client may send back to back (default: 5)\n";
+            std::cout << "  --llm-max-concurrent <n>  Admitted LLM requests before 503 (default: threads + queue)\n";
+            std::cout << "  --llm-latency-budget-ms <n>  Shed when the estimated LLM queue wait exceeds this (default: 12000)\n";
+            std::cout << "  --trusted-proxy <addr>  Believe X-Forwarded-For from this peer (repeatable)\n";
             std::cout << "  --help            Show this help message\n\n";
             std::cout << "Examples:\n";
             std::cout << "  " << argv[0] << "                  # CLI mode with sample dataset\n";
@@ -79,6 +231,10 @@ int main(int argc, char* argv[]) {
         }
     }
     
+    if (!traceFile.empty()) {
+        Trace::setChromeTraceFile(traceFile);
+    }
+    
     // Database file path (relative to executable location)
     // This CSV file contains sample product data from Walmart, Loblaws, and Costco
     std::string dbPath = "SampleDataset/yec_competition_dataset.csv";
@@ -90,6 +246,37 @@ int main(int argc, char* argv[]) {
     //   - useRealTimeApis: false (always use local database, real-time APIs removed)
     ApiServer server(dbPath, port, false);
     
+    if (!llmEndpoint.empty()) {
+        server.setLLMEndpoint(llmEndpoint);
+    }
+    if (llmDeadlineMs > 0) {
+        server.setLLMDeadline(llmDeadlineMs);
+    }
+    if (!llmPipeline.empty() && !server.setLLMPipeline(llmPipeline)) {
+        return 1;
+    }
+    if (!searchParams.empty() && !server.setSearchParameters(searchParams)) {
+        return 1;
+    }
+    if (!intentModel.empty() && !server.setIntentModel(intentModel)) {
+        return 1;
+    }
+    if (catalogueThreads >= 0 || llmThreads >= 0 || llmQueue >= 0) {
+        server.configureWorkers(catalogueThreads >= 0 ? catalogueThreads : server.getCatalogueThreads(),
+                                llmThreads >= 0 ? llmThreads : server.getLLMThreads(),
+                                llmQueue >= 0 ? llmQueue : server.getLLMQueueCapacity());
+    }
+    if (clientRate > 0 || clientBurst > 0 || llmMaxConcurrent >= 0 || llmLatencyBudgetMs > 0) {
+        AdmissionController::Config defaults;
+        server.configureAdmission(clientRate > 0 ? clientRate : defaults.clientRatePerSecond,
+                                  clientBurst > 0 ? clientBurst : defaults.clientBurst,
+                                  llmMaxConcurrent >= 0 ? llmMaxConcurrent : 0,
+                                  llmLatencyBudgetMs > 0 ? llmLatencyBudgetMs : defaults.latencyBudgetMs);
+    }
+    if (!trustedProxies.empty()) {
+        server.setTrustedProxies(trustedProxies);
+    }
+    
     // Initialize server and load database from CSV file
     // This step loads all product data into memory for fast querying
     if (!server.initialize()) {
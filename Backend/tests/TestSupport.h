@@ -0,0 +1,46 @@
+/**
+ * @file TestSupport.h
+ * @brief Minimal check/report helpers shared by the unit tests
+ *
+ * Each test is a plain executable run by ctest. Checks record failures
+ * instead of aborting, so one run reports every broken expectation:
+ *
+ *   check(total == expected, "basket total");
+ *   return finishTests("budget_solver_test");
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#ifndef TEST_SUPPORT_H
+#define TEST_SUPPORT_H
+
+#include <iostream>
+#include <string>
+
+/// Failed checks so far in this test executable
+inline int& testFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+/// Record a failure (and print what) unless condition holds
+inline void check(bool condition, const std::string& what) {
+    if (!condition) {
+        std::cerr << "FAIL: " << what << std::endl;
+        testFailures()++;
+    }
+}
+
+/// Report the result; returns the process exit code for main()
+inline int finishTests(const std::string& testName) {
+    if (testFailures() == 0) {
+        std::cout << testName << ": all checks passed" << std::endl;
+        return 0;
+    }
+    std::cerr << testName << ": " << testFailures() << " check(s) failed" << std::endl;
+    return 1;
+}
+
+#endif // TEST_SUPPORT_H
@@ -0,0 +1,117 @@
+/**
+ * @file budget_solver_test.cpp
+ * @brief Checks request constraint parsing and the budget knapsack's preference
+ *        order: coverage, then cost, then search rank
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "BudgetSolver.h"
+#include "TestSupport.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+Item product(const std::string& name, long long cents) {
+    return Item(0, name, "", Money::fromCents(cents), "Walmart", {}, "", "2025-10-01");
+}
+
+const std::vector<std::string> kStores = {"Walmart", "Loblaws", "Costco"};
+
+ShoppingConstraints parse(const std::string& request) {
+    return ShoppingConstraints::parse(request, kStores);
+}
+
+bool hasBudget(const ShoppingConstraints& constraints, long long cents) {
+    return constraints.budget && *constraints.budget == Money::fromCents(cents);
+}
+
+} // namespace
+
+int main() {
+    // Budgets: currency marks, currency words and cue words
+    check(hasBudget(parse("party snacks under $40"), 4000), "\"under $40\"");
+    check(hasBudget(parse("groceries with a budget of 25 dollars"), 2500), "\"budget of 25 dollars\"");
+    check(hasBudget(parse("lunch for less than 12.50 at Walmart"), 1250), "\"less than 12.50\" ending a phrase");
+    check(hasBudget(parse("spend $30 or under 20 for snacks"), 2000), "the lower of two budgets");
+    check(parse("party snacks under $40").remainder == "party snacks", "budget words leave the remainder");
+
+    // No budget: counts, sizes and plain requests are not money
+    check(!parse("breakfast for the week").budget, "no amount, no budget");
+    check(!parse("no more than 3 apples").budget, "a cued count is not a budget");
+    check(!parse("dinner for 4 people").budget, "a headcount is not a budget");
+    check(!parse("2 lb ground beef").budget, "a weight is not a budget");
+
+    // Quantities: plain counts, number words and containers
+    {
+        auto constraints = parse("3 pizzas and 2 bags of chips under $40");
+        check(constraints.quantityFor("Frozen Pizza") == 3, "\"3 pizzas\"");
+        check(constraints.quantityFor("Potato Chips") == 2, "\"2 bags of chips\"");
+        check(constraints.quantityFor("Milk") == 1, "unmentioned products default to 1");
+    }
+    check(parse("two loaves of bread").quantityFor("bread") == 2, "number word with a container");
+    check(parse("2 dozen eggs").quantityFor("eggs") == 2, "\"2 dozen eggs\" is two packs");
+
+    // Units and pack sizes are not multipliers
+    check(parse("2 lb ground beef").quantities.empty(), "weights are not counts");
+    check(parse("dinner for 4 people").quantities.empty(), "headcounts are not counts");
+    check(parse("12 eggs and bread").quantityFor("eggs") == 1, "\"12 eggs\" is one pack of twelve");
+    check(parse("12 eggs and bread").remainder.find("12") != std::string::npos, "pack size stays in the search text");
+    check(parse("a 12 pack of pop").quantityFor("pop") == 1, "\"12 pack of pop\" is one pack");
+    check(parse("2 packs of gum").quantityFor("gum") == 2, "\"2 packs of gum\" is two packs");
+
+    // Stores
+    {
+        auto constraints = parse("snacks at Walmart, not Costco");
+        check(constraints.allowsStore("walmart") && !constraints.allowsStore("Costco") &&
+              !constraints.allowsStore("Loblaws"), "only Walmart, never Costco");
+        check(constraints.remainder == "snacks", "store phrases leave the remainder");
+    }
+
+    // A cheaper but less relevant option must win when both fit
+    {
+        std::vector<BudgetSolver::Group> groups = {
+            {"milk", {product("Organic Milk 2L", 650), product("Milk 2L", 480)}, 1},
+            {"bread", {product("Sourdough Bread", 500), product("White Bread", 250)}, 1},
+        };
+        auto selection = BudgetSolver::solve(groups, Money::fromCents(2000));
+        check(selection.covered == 2, "both products fit");
+        check(selection.choice[0] == 1 && selection.choice[1] == 1, "cheaper options chosen");
+        check(selection.totalCost == Money::fromCents(730), "total is the cheapest covering list");
+    }
+
+    // Coverage still comes first: a dearer list that covers more wins
+    {
+        std::vector<BudgetSolver::Group> groups = {
+            {"chips", {product("Chips", 300)}, 1},
+            {"pop", {product("Pop 12 pack", 700)}, 1},
+        };
+        auto selection = BudgetSolver::solve(groups, Money::fromCents(1000));
+        check(selection.covered == 2 && selection.totalCost == Money::fromCents(1000), "cover both at exactly the budget");
+    }
+
+    // Equal cost: search rank breaks the tie
+    {
+        std::vector<BudgetSolver::Group> groups = {
+            {"eggs", {product("Eggs 12", 400), product("Egg Whites", 400)}, 1},
+        };
+        auto selection = BudgetSolver::solve(groups, Money::fromCents(1000));
+        check(selection.choice[0] == 0, "best match among equal prices");
+    }
+
+    // Quantities count against the budget
+    {
+        std::vector<BudgetSolver::Group> groups = {
+            {"pizza", {product("Pizza", 600)}, 3},
+            {"chips", {product("Chips", 300)}, 1},
+        };
+        auto selection = BudgetSolver::solve(groups, Money::fromCents(2000));
+        check(selection.covered == 1, "three pizzas and chips do not fit together");
+        check(selection.totalCost <= Money::fromCents(2000), "total within budget");
+    }
+
+    return finishTests("budget_solver_test");
+}
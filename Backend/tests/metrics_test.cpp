@@ -0,0 +1,69 @@
+/**
+ * @file metrics_test.cpp
+ * @brief Checks that exported histogram buckets count samples by their exact value
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "Metrics.h"
+#include "TestSupport.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+void checkCounts(const Histogram& histogram, const std::vector<uint64_t>& expected, const std::string& what) {
+    auto counts = histogram.cumulativeExportCounts();
+    check(counts == expected, what);
+    check(counts.back() == histogram.getCount(), what + ": +Inf bucket equals _count");
+}
+
+} // namespace
+
+int main() {
+    // Latencies in microseconds, exported in seconds. 1000 us shares a fine
+    // bucket (960..1023) with values above the 1 ms bound.
+    {
+        Histogram latency(1e-6, {0.001, 0.0025});
+        latency.record(1000);   // Exactly on le="0.001"
+        latency.record(1001);   // Just above it
+        latency.record(960);    // Bottom of the straddling fine bucket
+        latency.record(2500);   // Exactly on le="0.0025"
+        latency.record(2501);   // Only in +Inf
+        checkCounts(latency, {2, 4, 5}, "latency samples on and just above a bound");
+    }
+
+    // Plain counts, including the le="0" bound
+    {
+        Histogram sizes(1.0, Histogram::sizeBounds());
+        for (uint64_t value : {0, 1, 10, 11, 100000, 100001}) {
+            sizes.record(value);
+        }
+        auto counts = sizes.cumulativeExportCounts();
+        const auto& bounds = sizes.getExportBounds();
+        for (size_t b = 0; b < bounds.size(); b++) {
+            uint64_t expected = 0;
+            for (uint64_t value : {0, 1, 10, 11, 100000, 100001}) {
+                expected += static_cast<double>(value) <= bounds[b] ? 1 : 0;
+            }
+            check(counts[b] == expected, "size bucket le=" + std::to_string(bounds[b]));
+        }
+        check(counts.back() == 6, "size +Inf bucket");
+    }
+
+    // The exposition agrees with the histogram
+    {
+        Histogram& exported = MetricsRegistry::instance().histogram(
+            "test_boundary_seconds", "Boundary samples", {}, 1e-6, {0.001});
+        exported.record(1000);
+        exported.record(1001);
+        std::string text = MetricsRegistry::instance().renderPrometheus();
+        check(text.find("test_boundary_seconds_bucket{le=\"0.001\"} 1\n") != std::string::npos, "exported le=\"0.001\"");
+        check(text.find("test_boundary_seconds_bucket{le=\"+Inf\"} 2\n") != std::string::npos, "exported le=\"+Inf\"");
+        check(text.find("test_boundary_seconds_count 2\n") != std::string::npos, "exported _count");
+    }
+
+    return finishTests("metrics_test");
+}
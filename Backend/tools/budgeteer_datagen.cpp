@@ -0,0 +1,571 @@
+/**
+ * @file budgeteer_datagen.cpp
+ * @brief Synthetic catalogue and query workload generator for scale testing
+ *
+ * Produces CSV catalogues of arbitrary size in the same 8-column schema as
+ * SampleDataset/yec_competition_dataset.csv:
+ *
+ *   item_id,item_name,item_description,current_price,store,category_tags,image_url,price_date
+ *
+ * Product popularity follows a Zipf distribution: popular products get more
+ * price observations (more stores, deeper history) and are queried more
+ * often in the generated workload, which mirrors real catalogue skew.
+ *
+ * Output is a pure function of the options and --seed. All randomness is
+ * drawn from std::mt19937_64 through hand-written distributions, because the
+ * standard library distributions are not guaranteed to produce the same
+ * sequence on different compilers.
+ *
+ * Usage:
+ *   budgeteer_datagen --rows 10000000 --products 200000 --stores 10 \
+ *                     --out catalogue.csv --queries 100000 --queries-out queries.tsv
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+// ==================== Options ====================
+
+struct Options {
+    uint64_t rows = 100000;              ///< Exact number of CSV rows
+    int products = 2000;                 ///< Distinct item_ids
+    int stores = 3;                      ///< Number of stores
+    std::string startDate = "2022-01-01";
+    std::string endDate = "2024-12-31";
+    int tags = 24;                       ///< Tag vocabulary size
+    int maxTagsPerProduct = 3;
+    double nameWordsMean = 3.0;          ///< Words per product name (before the size suffix)
+    double nameWordsStddev = 1.0;
+    int nameWordsMax = 8;
+    double descWordsMean = 8.0;
+    double zipfExponent = 1.0;           ///< Popularity skew (0 = uniform)
+    uint64_t seed = 42;
+    std::string outFile = "synthetic_catalogue.csv";
+    uint64_t queries = 0;                ///< Number of workload queries (0 = none)
+    std::string queriesOut = "synthetic_queries.tsv";
+};
+
+// ==================== Deterministic randomness ====================
+
+class Random {
+private:
+    std::mt19937_64 engine;
+
+public:
+    explicit Random(uint64_t seed) : engine(seed) {}
+
+    /// Uniform double in [0, 1)
+    double uniform() {
+        return static_cast<double>(engine() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    /// Uniform integer in [lo, hi]
+    int64_t range(int64_t lo, int64_t hi) {
+        return lo + static_cast<int64_t>(uniform() * static_cast<double>(hi - lo + 1));
+    }
+
+    /// Standard normal sample (Box-Muller)
+    double normal(double mean, double stddev) {
+        double u1 = std::max(uniform(), 1e-12);
+        double u2 = uniform();
+        return mean + stddev * std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+    }
+
+    template <typename T>
+    const T& pick(const std::vector<T>& values) {
+        return values[static_cast<size_t>(range(0, static_cast<int64_t>(values.size()) - 1))];
+    }
+};
+
+/// Zipf sampler over ranks [0, n) using a precomputed CDF
+class ZipfSampler {
+private:
+    std::vector<double> cdf;
+
+public:
+    ZipfSampler(int n, double exponent) : cdf(static_cast<size_t>(n)) {
+        double total = 0.0;
+        for (int i = 0; i < n; i++) {
+            total += 1.0 / std::pow(static_cast<double>(i + 1), exponent);
+            cdf[static_cast<size_t>(i)] = total;
+        }
+        for (auto& c : cdf) c /= total;
+    }
+
+    double weight(int rank) const {
+        return rank == 0 ? cdf[0] : cdf[static_cast<size_t>(rank)] - cdf[static_cast<size_t>(rank) - 1];
+    }
+
+    int sample(Random& rng) const {
+        double u = rng.uniform();
+        auto it = std::lower_bound(cdf.begin(), cdf.end(), u);
+        return static_cast<int>(std::min<size_t>(static_cast<size_t>(it - cdf.begin()), cdf.size() - 1));
+    }
+};
+
+// ==================== Calendar helpers ====================
+
+// Days since 1970-01-01 for a proleptic Gregorian date (Howard Hinnant's algorithm)
+int64_t daysFromCivil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+std::string civilFromDays(int64_t z) {
+    z += 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const int64_t y = static_cast<int64_t>(yoe) + era * 400;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    const unsigned d = doy - (153 * mp + 2) / 5 + 1;
+    const unsigned m = mp + (mp < 10 ? 3 : -9);
+
+    char buffer[48];
+    std::snprintf(buffer, sizeof(buffer), "%04lld-%02u-%02u", static_cast<long long>(y + (m <= 2)), m, d);
+    return buffer;
+}
+
+int64_t parseDate(const std::string& date) {
+    int y = 0;
+    unsigned m = 1, d = 1;
+    if (std::sscanf(date.c_str(), "%d-%u-%u", &y, &m, &d) != 3) {
+        std::cerr << "Error: invalid date '" << date << "' (expected YYYY-MM-DD)" << std::endl;
+        std::exit(1);
+    }
+    return daysFromCivil(y, m, d);
+}
+
+// ==================== Vocabulary ====================
+
+const std::vector<std::string> kStoreNames = {
+    "Walmart", "Loblaws", "Costco", "Metro", "Sobeys", "No Frills", "FreshCo",
+    "Food Basics", "Real Canadian Superstore", "Save-On-Foods", "Longo's", "T&T Supermarket"
+};
+
+const std::vector<std::string> kTagNames = {
+    "dairy", "bakery", "produce", "meat", "seafood", "frozen", "snacks", "beverages",
+    "pantry", "breakfast", "baking", "household", "cleaning", "personal care", "baby",
+    "pets", "electronics", "entertainment", "home", "health", "organic", "deli",
+    "condiments", "international"
+};
+
+const std::vector<std::string> kBrands = {
+    "Golden", "Maple", "Northern", "Harvest", "Prairie", "Coastal", "Sunrise", "Valley",
+    "Summit", "Heritage", "Urban", "Classic", "Premium", "Everyday", "Family", "Select"
+};
+
+const std::vector<std::string> kAdjectives = {
+    "Fresh", "Organic", "Whole", "Lite", "Crunchy", "Smooth", "Spicy", "Sweet", "Salted",
+    "Unsalted", "Roasted", "Frozen", "Natural", "Extra", "Original", "Honey", "Garlic",
+    "Vanilla", "Chocolate", "Strawberry", "Lemon", "Mild", "Sharp", "Large", "Mini"
+};
+
+const std::vector<std::string> kNouns = {
+    "Milk", "Cheese", "Yogurt", "Butter", "Bread", "Bagels", "Apples", "Bananas", "Carrots",
+    "Chicken Breast", "Ground Beef", "Salmon", "Pasta", "Rice", "Flour", "Sugar", "Eggs",
+    "Cereal", "Granola Bars", "Chips", "Cookies", "Crackers", "Coffee", "Tea", "Juice",
+    "Soda", "Water", "Dish Soap", "Laundry Detergent", "Paper Towels", "Shampoo",
+    "Toothpaste", "Diapers", "Wipes", "Dog Food", "Headphones", "Batteries", "Pizza",
+    "Ice Cream", "Peanut Butter", "Sauce", "Soup", "Tortillas", "Oatmeal", "Popcorn"
+};
+
+const std::vector<std::string> kSizes = {
+    "(500g)", "(1kg)", "(2L)", "(4L)", "(12 pack)", "(6 pack)", "(24 rolls)", "(750ml)",
+    "(per lb)", "(900g)", "(250g)", "(40 count)", "(2lb bag)", "(1.5L)"
+};
+
+const std::vector<std::string> kDescriptionWords = {
+    "quality", "everyday", "value", "family", "size", "great", "taste", "made", "with",
+    "real", "ingredients", "perfect", "for", "meals", "snacking", "home", "use", "long",
+    "lasting", "fresh", "daily", "favourite", "classic", "recipe", "pack", "premium"
+};
+
+struct Product {
+    int id;
+    std::string name;
+    std::string description;
+    std::string tags;
+    std::string imageUrl;
+    double basePrice;
+    std::vector<int> stores;
+};
+
+std::string slugify(const std::string& name) {
+    std::string slug;
+    bool dash = false;
+    for (char c : name) {
+        unsigned char u = static_cast<unsigned char>(c);
+        if (std::isalnum(u)) {
+            slug += static_cast<char>(std::tolower(u));
+            dash = false;
+        } else if (!dash && !slug.empty()) {
+            slug += '-';
+            dash = true;
+        }
+    }
+    while (!slug.empty() && slug.back() == '-') slug.pop_back();
+    return slug;
+}
+
+std::vector<Product> generateProducts(const Options& options, Random& rng) {
+    std::vector<std::string> tagVocabulary;
+    for (int i = 0; i < options.tags; i++) {
+        tagVocabulary.push_back(i < static_cast<int>(kTagNames.size())
+                                    ? kTagNames[static_cast<size_t>(i)]
+                                    : "category-" + std::to_string(i + 1));
+    }
+
+    std::vector<Product> products;
+    products.reserve(static_cast<size_t>(options.products));
+    std::set<std::string> usedNames;
+
+    for (int i = 0; i < options.products; i++) {
+        Product p;
+        p.id = 1001 + i;
+
+        // Name: optional brand + adjectives + noun + size suffix
+        int words = static_cast<int>(std::lround(rng.normal(options.nameWordsMean, options.nameWordsStddev)));
+        words = std::max(1, std::min(options.nameWordsMax, words));
+        std::string name;
+        if (words >= 3) name += rng.pick(kBrands) + " ";
+        for (int w = 1; w < words - (words >= 3 ? 1 : 0); w++) {
+            name += rng.pick(kAdjectives) + " ";
+        }
+        name += rng.pick(kNouns) + " " + rng.pick(kSizes);
+        // Keep names unique so item_id <-> name stays one-to-one like the sample dataset
+        if (!usedNames.insert(name).second) {
+            name += " #" + std::to_string(p.id);
+            usedNames.insert(name);
+        }
+        p.name = name;
+
+        int descWords = std::max(2, static_cast<int>(std::lround(rng.normal(options.descWordsMean, 2.0))));
+        std::string description;
+        for (int w = 0; w < descWords; w++) {
+            if (w > 0) description += " ";
+            description += rng.pick(kDescriptionWords);
+        }
+        description[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(description[0])));
+        p.description = description;
+
+        int tagCount = static_cast<int>(rng.range(1, std::max(1, options.maxTagsPerProduct)));
+        std::set<std::string> tags;
+        while (static_cast<int>(tags.size()) < std::min(tagCount, options.tags)) {
+            tags.insert(rng.pick(tagVocabulary));
+        }
+        for (const auto& tag : tags) {
+            if (!p.tags.empty()) p.tags += ",";
+            p.tags += tag;
+        }
+
+        p.imageUrl = "https://example.com/" + slugify(p.name) + ".jpg";
+        p.basePrice = std::exp(rng.normal(2.0, 1.0));   // log-normal, median ~$7.40
+        products.push_back(p);
+    }
+    return products;
+}
+
+std::string csvField(const std::string& value) {
+    if (value.find(',') == std::string::npos) return value;
+    return "\"" + value + "\"";
+}
+
+/**
+ * Rows per product, in rank order, summing to exactly totalRows: one each,
+ * then the rest split by Zipf weight, with the rounding remainder going to
+ * the largest fractional shares (lower rank first on ties).
+ */
+std::vector<uint64_t> rowQuotas(uint64_t totalRows, size_t productCount, const ZipfSampler& zipf) {
+    std::vector<uint64_t> quotas(productCount, 1);
+    const uint64_t extra = totalRows - productCount;
+    std::vector<std::pair<double, size_t>> remainders;
+    remainders.reserve(productCount);
+    uint64_t assigned = 0;
+    for (size_t rank = 0; rank < productCount; rank++) {
+        double share = zipf.weight(static_cast<int>(rank)) * static_cast<double>(extra);
+        uint64_t whole = std::min(extra - assigned, static_cast<uint64_t>(std::floor(share)));
+        quotas[rank] += whole;
+        assigned += whole;
+        remainders.push_back({share - std::floor(share), rank});
+    }
+    std::sort(remainders.begin(), remainders.end(), [](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+    for (size_t i = 0; assigned < extra; i = (i + 1) % productCount, assigned++) {
+        quotas[remainders[i].second]++;
+    }
+    return quotas;
+}
+
+void writeCatalogue(const Options& options, std::vector<Product>& products, const ZipfSampler& zipf, Random& rng) {
+    std::ofstream out(options.outFile, std::ios::binary);
+    if (!out.is_open()) {
+        std::cerr << "Error: could not open " << options.outFile << std::endl;
+        std::exit(1);
+    }
+
+    const int64_t firstDay = parseDate(options.startDate);
+    const int64_t lastDay = std::max(firstDay, parseDate(options.endDate));
+    const int storeCount = std::max(1, options.stores);
+
+    std::vector<std::string> storeNames;
+    std::vector<double> storeMultiplier;
+    for (int s = 0; s < storeCount; s++) {
+        storeNames.push_back(s < static_cast<int>(kStoreNames.size())
+                                 ? kStoreNames[static_cast<size_t>(s)]
+                                 : "Store " + std::to_string(s + 1));
+        storeMultiplier.push_back(0.9 + 0.2 * rng.uniform());
+    }
+
+    std::string buffer;
+    buffer.reserve(1 << 22);
+    buffer += "item_id,item_name,item_description,current_price,store,category_tags,image_url,price_date\n";
+
+    // Popular products get proportionally more observations (at least one)
+    const std::vector<uint64_t> quotas = rowQuotas(options.rows, products.size(), zipf);
+    uint64_t written = 0;
+    for (size_t rank = 0; rank < products.size(); rank++) {
+        Product& p = products[rank];
+        const uint64_t observations = quotas[rank];
+
+        // Popular products are carried by more stores
+        int carriedBy = std::max(1, std::min(storeCount, static_cast<int>(
+            std::ceil(static_cast<double>(storeCount) * std::min(1.0, 0.3 + static_cast<double>(observations) / 24.0)))));
+        std::vector<int> order(static_cast<size_t>(storeCount));
+        for (int s = 0; s < storeCount; s++) order[static_cast<size_t>(s)] = s;
+        for (int s = storeCount - 1; s > 0; s--) {
+            std::swap(order[static_cast<size_t>(s)], order[static_cast<size_t>(rng.range(0, s))]);
+        }
+        p.stores.assign(order.begin(), order.begin() + carriedBy);
+        std::sort(p.stores.begin(), p.stores.end());
+
+        // Spread observations across the carrying stores, dates evenly spaced per store
+        uint64_t perStore = (observations + static_cast<uint64_t>(carriedBy) - 1) / static_cast<uint64_t>(carriedBy);
+        uint64_t emitted = 0;
+        for (int store : p.stores) {
+            double price = p.basePrice * storeMultiplier[static_cast<size_t>(store)];
+            for (uint64_t k = 0; k < perStore && emitted < observations; k++, emitted++) {
+                int64_t span = lastDay - firstDay;
+                int64_t day = firstDay + (perStore > 1 ? static_cast<int64_t>(k) * span / static_cast<int64_t>(perStore - 1) : span);
+                price = std::max(0.25, price * (1.0 + rng.normal(0.0, 0.03)));
+
+                char priceText[32];
+                std::snprintf(priceText, sizeof(priceText), "%.2f", price);
+
+                buffer += std::to_string(p.id);
+                buffer += ',';
+                buffer += csvField(p.name);
+                buffer += ',';
+                buffer += csvField(p.description);
+                buffer += ',';
+                buffer += priceText;
+                buffer += ',';
+                buffer += csvField(storeNames[static_cast<size_t>(store)]);
+                buffer += ",\"";
+                buffer += p.tags;
+                buffer += "\",";
+                buffer += p.imageUrl;
+                buffer += ',';
+                buffer += civilFromDays(day);
+                buffer += '\n';
+
+                if (buffer.size() > (1 << 22) - 1024) {
+                    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                    buffer.clear();
+                }
+            }
+        }
+        written += emitted;
+    }
+
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    std::cerr << "[Datagen] Wrote " << written << " rows for " << products.size() << " products across "
+              << storeCount << " stores to " << options.outFile << std::endl;
+}
+
+/// Shortest word withTypo alters; shorter ones are left for other query kinds
+constexpr size_t kMinTypoWordLength = 4;
+
+/// Introduce a single-character typo (substitution, deletion or transposition)
+/// into a word of at least kMinTypoWordLength characters; the result always differs
+std::string withTypo(std::string word, Random& rng) {
+    if (word.size() < kMinTypoWordLength) return word;
+    size_t pos = static_cast<size_t>(rng.range(1, static_cast<int64_t>(word.size()) - 2));
+    int64_t edit = rng.range(0, 2);
+    if (edit == 2 && word[pos] == word[pos + 1]) edit = 1;  // swapping a double letter changes nothing
+    switch (edit) {
+        case 0: {
+            char c = static_cast<char>('a' + rng.range(0, 24));
+            if (c >= word[pos]) c++;  // skip the letter already there
+            word[pos] = c;
+            break;
+        }
+        case 1: word.erase(pos, 1); break;
+        default: std::swap(word[pos], word[pos + 1]); break;
+    }
+    return word;
+}
+
+std::vector<std::string> splitWords(const std::string& text) {
+    std::vector<std::string> words;
+    std::string word;
+    for (char c : text) {
+        if (c == ' ') {
+            if (!word.empty()) words.push_back(word);
+            word.clear();
+        } else {
+            word += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+    }
+    if (!word.empty()) words.push_back(word);
+    return words;
+}
+
+void writeQueries(const Options& options, const std::vector<Product>& products, const ZipfSampler& zipf, Random& rng) {
+    std::ofstream out(options.queriesOut);
+    if (!out.is_open()) {
+        std::cerr << "Error: could not open " << options.queriesOut << std::endl;
+        std::exit(1);
+    }
+
+    out << "kind\tquery\n";
+    for (uint64_t i = 0; i < options.queries; i++) {
+        const Product& p = products[static_cast<size_t>(zipf.sample(rng))];
+        auto words = splitWords(p.name.substr(0, p.name.find(" (")));
+        std::string kind;
+        std::string query;
+
+        // Typos go into the last word long enough to alter; a name without one
+        // falls through to the next kind so every "typo" query really has one
+        auto typoWord = std::find_if(words.rbegin(), words.rend(),
+                                     [](const std::string& w) { return w.size() >= kMinTypoWordLength; });
+
+        double r = rng.uniform();
+        if (r < 0.25) {
+            kind = "exact";
+            query = p.name;
+        } else if (r < 0.55) {
+            kind = "prefix";
+            query = words.back().substr(0, std::max<size_t>(3, words.back().size() / 2 + 1));
+        } else if (r < 0.70 && typoWord != words.rend()) {
+            kind = "typo";
+            query = withTypo(*typoWord, rng);
+        } else if (r < 0.90 && words.size() >= 2) {
+            kind = "multi_word";
+            query = words[words.size() - 2] + " " + words.back();
+        } else {
+            kind = "category";
+            query = p.tags.substr(0, p.tags.find(','));
+        }
+        out << kind << '\t' << query << '\n';
+    }
+    std::cerr << "[Datagen] Wrote " << options.queries << " queries to " << options.queriesOut << std::endl;
+}
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n\n";
+    std::cout << "Catalogue options:\n";
+    std::cout << "  --rows <n>                Number of rows, at least one per product (default: 100000)\n";
+    std::cout << "  --products <n>            Distinct products / item_ids (default: 2000)\n";
+    std::cout << "  --stores <n>              Number of stores (default: 3)\n";
+    std::cout << "  --start-date <YYYY-MM-DD> First price date (default: 2022-01-01)\n";
+    std::cout << "  --end-date <YYYY-MM-DD>   Last price date (default: 2024-12-31)\n";
+    std::cout << "  --tags <n>                Tag vocabulary size (default: 24)\n";
+    std::cout << "  --max-tags <n>            Maximum tags per product (default: 3)\n";
+    std::cout << "  --name-words-mean <x>     Mean words per product name (default: 3)\n";
+    std::cout << "  --name-words-stddev <x>   Standard deviation of name words (default: 1)\n";
+    std::cout << "  --name-words-max <n>      Maximum words per product name (default: 8)\n";
+    std::cout << "  --desc-words-mean <x>     Mean words per description (default: 8)\n";
+    std::cout << "  --zipf <s>                Popularity skew exponent, 0 = uniform (default: 1.0)\n";
+    std::cout << "  --seed <n>                Random seed (default: 42)\n";
+    std::cout << "  --out <file>              Catalogue CSV path (default: synthetic_catalogue.csv)\n\n";
+    std::cout << "Workload options:\n";
+    std::cout << "  --queries <n>             Number of queries to generate (default: 0)\n";
+    std::cout << "  --queries-out <file>      Query workload TSV path (default: synthetic_queries.tsv)\n";
+}
+
+Options parseArgs(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: " << arg << " requires a value" << std::endl;
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--rows") options.rows = std::max<uint64_t>(1, std::stoull(next()));
+        else if (arg == "--products") options.products = std::max(1, std::stoi(next()));
+        else if (arg == "--stores") options.stores = std::max(1, std::stoi(next()));
+        else if (arg == "--start-date") options.startDate = next();
+        else if (arg == "--end-date") options.endDate = next();
+        else if (arg == "--tags") options.tags = std::max(1, std::stoi(next()));
+        else if (arg == "--max-tags") options.maxTagsPerProduct = std::max(1, std::stoi(next()));
+        else if (arg == "--name-words-mean") options.nameWordsMean = std::stod(next());
+        else if (arg == "--name-words-stddev") options.nameWordsStddev = std::stod(next());
+        else if (arg == "--name-words-max") options.nameWordsMax = std::max(1, std::stoi(next()));
+        else if (arg == "--desc-words-mean") options.descWordsMean = std::stod(next());
+        else if (arg == "--zipf") options.zipfExponent = std::max(0.0, std::stod(next()));
+        else if (arg == "--seed") options.seed = std::stoull(next());
+        else if (arg == "--out") options.outFile = next();
+        else if (arg == "--queries") options.queries = std::stoull(next());
+        else if (arg == "--queries-out") options.queriesOut = next();
+        else if (arg == "--help") {
+            printUsage(argv[0]);
+            std::exit(0);
+        } else {
+            std::cerr << "Error: unknown option " << arg << std::endl;
+            printUsage(argv[0]);
+            std::exit(1);
+        }
+    }
+    return options;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options = parseArgs(argc, argv);
+    if (options.rows < static_cast<uint64_t>(options.products)) {
+        // Every product gets at least one row
+        std::cerr << "[Datagen] --products capped at --rows (" << options.rows << ")" << std::endl;
+        options.products = static_cast<int>(options.rows);
+    }
+
+    // Independent streams so changing the workload size never changes the catalogue
+    Random catalogueRng(options.seed);
+    Random queryRng(options.seed ^ 0x9E3779B97F4A7C15ULL);
+
+    ZipfSampler zipf(options.products, options.zipfExponent);
+    auto products = generateProducts(options, catalogueRng);
+    writeCatalogue(options, products, zipf, catalogueRng);
+
+    if (options.queries > 0) {
+        writeQueries(options, products, zipf, queryRng);
+    }
+    return 0;
+}
@@ -0,0 +1,248 @@
+/**
+ * @file budgeteer_train_intent.cpp
+ * @brief Offline trainer for the local-vs-GPT intent model
+ *
+ * Reads labelled queries and writes a model file for
+ * BudgeteerAPI --intent-model (or BUDGETEER_INTENT_MODEL). Query logs are the
+ * tab-separated files the server appends to when BUDGETEER_QUERY_LOG is set:
+ *
+ *   route<TAB>mode<TAB>query        e.g.  local<TAB>cheapest_mix<TAB>price of milk
+ *
+ * route is "local" or "gpt"; mode is cheapest_mix, single_store,
+ * budget_insight or "-" when unknown. Logged labels can be edited by hand
+ * before training. With --catalogue, product names from a catalogue CSV are
+ * added as "local" examples, since a bare product name is the simplest query
+ * there is.
+ *
+ * A fraction of the examples (--holdout) is kept out of training and used to
+ * report accuracy against always predicting the majority label.
+ *
+ * Usage:
+ *   budgeteer_train_intent --log queries.tsv --catalogue SampleDataset/yec_competition_dataset.csv \
+ *                          --out intent.model
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include "Database.h"
+#include "IntentClassifier.h"
+#include "LLMInterface.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    std::vector<std::string> logFiles;
+    std::string catalogueFile;
+    size_t catalogueExamples = 2000;     ///< Product names taken from the catalogue
+    std::string outFile = "intent.model";
+    size_t buckets = IntentClassifier::kDefaultBuckets;
+    IntentClassifier::TrainingOptions training;
+    double holdout = 0.1;                ///< Fraction of examples used only for evaluation
+};
+
+const std::vector<LLMInterface::Mode> kModes = {
+    LLMInterface::Mode::CHEAPEST_MIX, LLMInterface::Mode::SINGLE_STORE, LLMInterface::Mode::BUDGET_INSIGHT
+};
+
+size_t readLog(const std::string& path, std::vector<IntentClassifier::Example>& examples) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Error: cannot open " << path << std::endl;
+        std::exit(1);
+    }
+
+    size_t added = 0, skipped = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        size_t first = line.find('\t');
+        size_t second = first == std::string::npos ? std::string::npos : line.find('\t', first + 1);
+        if (second == std::string::npos) {
+            skipped++;
+            continue;
+        }
+        std::string route = line.substr(0, first);
+        std::string mode = line.substr(first + 1, second - first - 1);
+        std::string query = line.substr(second + 1);
+        if ((route != "local" && route != "gpt") || query.empty()) {
+            skipped++;
+            continue;
+        }
+
+        int modeIndex = -1;
+        if (auto parsed = LLMInterface::parseMode(mode)) {
+            modeIndex = static_cast<int>(std::find(kModes.begin(), kModes.end(), *parsed) - kModes.begin());
+        }
+        examples.push_back({query, route == "local", modeIndex});
+        added++;
+    }
+    std::cout << path << ": " << added << " examples";
+    if (skipped > 0) std::cout << " (" << skipped << " malformed lines skipped)";
+    std::cout << std::endl;
+    return added;
+}
+
+size_t addCatalogueNames(const Options& options, std::vector<IntentClassifier::Example>& examples) {
+    // Database logs while loading; keep the trainer's own output readable
+    std::streambuf* stdoutBuf = std::cout.rdbuf();
+    std::ostringstream discarded;
+    std::cout.rdbuf(discarded.rdbuf());
+    Database database(options.catalogueFile);
+    bool loaded = database.loadFromCSV();
+    std::cout.rdbuf(stdoutBuf);
+    if (!loaded) {
+        std::cerr << "Error: cannot load catalogue " << options.catalogueFile << std::endl;
+        std::exit(1);
+    }
+
+    std::set<std::string> names;
+    for (const auto& item : database.getAllItems()) {
+        if (names.size() >= options.catalogueExamples) break;
+        names.insert(item.getItemName());
+    }
+    for (const auto& name : names) {
+        examples.push_back({name, true, -1});
+    }
+    std::cout << options.catalogueFile << ": " << names.size() << " product names as local examples" << std::endl;
+    return names.size();
+}
+
+void evaluate(const IntentClassifier& model, const std::vector<IntentClassifier::Example>& heldOut) {
+    if (heldOut.empty()) {
+        return;
+    }
+    size_t routeCorrect = 0, localCount = 0, modeTotal = 0, modeCorrect = 0;
+    std::vector<size_t> modeCounts(kModes.size(), 0);
+    for (const auto& example : heldOut) {
+        auto prediction = model.predict(example.query);
+        routeCorrect += (prediction.localProbability >= 0.5) == example.local;
+        localCount += example.local;
+        if (example.mode >= 0) {
+            modeTotal++;
+            modeCounts[example.mode]++;
+            modeCorrect += prediction.mode == example.mode;
+        }
+    }
+
+    auto percent = [](size_t part, size_t whole) { return whole == 0 ? 0.0 : 100.0 * part / whole; };
+    size_t majorityRoute = std::max(localCount, heldOut.size() - localCount);
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Held-out route accuracy: " << percent(routeCorrect, heldOut.size()) << "% (majority label "
+              << percent(majorityRoute, heldOut.size()) << "%, " << heldOut.size() << " examples)" << std::endl;
+    if (modeTotal > 0) {
+        size_t majorityMode = *std::max_element(modeCounts.begin(), modeCounts.end());
+        std::cout << "Held-out mode accuracy: " << percent(modeCorrect, modeTotal) << "% (majority label "
+                  << percent(majorityMode, modeTotal) << "%, " << modeTotal << " examples)" << std::endl;
+    }
+}
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " --log <file> [options]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --log <file>             Labelled query log (route<TAB>mode<TAB>query); repeatable\n";
+    std::cout << "  --catalogue <csv>        Add catalogue product names as local examples\n";
+    std::cout << "  --catalogue-examples <n> Maximum product names taken (default: 2000)\n";
+    std::cout << "  --out <file>             Model file to write (default: intent.model)\n";
+    std::cout << "  --buckets <n>            Hashed feature buckets (default: 16384)\n";
+    std::cout << "  --epochs <n>             SGD passes over the data (default: 12)\n";
+    std::cout << "  --learning-rate <x>      Initial SGD step size (default: 0.2)\n";
+    std::cout << "  --l2 <x>                 L2 regularisation (default: 1e-5)\n";
+    std::cout << "  --holdout <fraction>     Examples kept out for evaluation (default: 0.1)\n";
+    std::cout << "  --seed <n>               Shuffle seed (default: 42)\n";
+    std::cout << "  --help                   Show this message\n";
+}
+
+Options parseArgs(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: " << arg << " requires a value" << std::endl;
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--log") options.logFiles.push_back(next());
+        else if (arg == "--catalogue") options.catalogueFile = next();
+        else if (arg == "--catalogue-examples") options.catalogueExamples = std::stoull(next());
+        else if (arg == "--out") options.outFile = next();
+        else if (arg == "--buckets") options.buckets = std::max<size_t>(1, std::stoull(next()));
+        else if (arg == "--epochs") options.training.epochs = std::max(1, std::stoi(next()));
+        else if (arg == "--learning-rate") options.training.learningRate = std::stod(next());
+        else if (arg == "--l2") options.training.l2 = std::max(0.0, std::stod(next()));
+        else if (arg == "--holdout") options.holdout = std::min(0.9, std::max(0.0, std::stod(next())));
+        else if (arg == "--seed") options.training.seed = std::stoull(next());
+        else if (arg == "--help") {
+            printUsage(argv[0]);
+            std::exit(0);
+        } else {
+            std::cerr << "Error: unknown option " << arg << std::endl;
+            printUsage(argv[0]);
+            std::exit(1);
+        }
+    }
+    if (options.logFiles.empty() && options.catalogueFile.empty()) {
+        std::cerr << "Error: give at least one --log or a --catalogue" << std::endl;
+        printUsage(argv[0]);
+        std::exit(1);
+    }
+    return options;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options = parseArgs(argc, argv);
+
+    std::vector<IntentClassifier::Example> examples;
+    for (const auto& path : options.logFiles) {
+        readLog(path, examples);
+    }
+    if (!options.catalogueFile.empty()) {
+        addCatalogueNames(options, examples);
+    }
+    if (examples.empty()) {
+        std::cerr << "Error: no training examples" << std::endl;
+        return 1;
+    }
+
+    // Deterministic split: shuffle once with the seed, hold out the tail
+    std::mt19937_64 rng(options.training.seed ^ 0x9E3779B97F4A7C15ULL);
+    for (size_t i = examples.size(); i > 1; i--) {
+        std::swap(examples[i - 1], examples[rng() % i]);
+    }
+    size_t heldOutCount = static_cast<size_t>(examples.size() * options.holdout);
+    std::vector<IntentClassifier::Example> heldOut(examples.end() - heldOutCount, examples.end());
+    examples.resize(examples.size() - heldOutCount);
+
+    std::vector<std::string> modeLabels;
+    for (auto mode : kModes) {
+        modeLabels.push_back(LLMInterface::modeName(mode));
+    }
+
+    IntentClassifier model(options.buckets);
+    model.train(examples, modeLabels, options.training);
+    std::cout << "Trained on " << examples.size() << " examples" << std::endl;
+    evaluate(model, heldOut);
+
+    if (!model.save(options.outFile)) {
+        return 1;
+    }
+    std::cout << "Wrote " << options.outFile << std::endl;
+    return 0;
+}
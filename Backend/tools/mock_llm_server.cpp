@@ -0,0 +1,540 @@
+/**
+ * @file mock_llm_server.cpp
+ * @brief Local stand-in for the GitHub Models chat-completions endpoint
+ *
+ * Serves POST /inference/chat/completions (and /chat/completions) in the
+ * OpenAI response shape, so the LLM pipeline can be load-tested and
+ * benchmarked without network access or API quota:
+ *
+ *   budgeteer_mock_llm --port 8089 --latency-ms 400 --jitter-ms 100
+ *   BudgeteerAPI --http --llm-endpoint http://localhost:8089/inference
+ *
+ * The Authorization header is not checked (only forwarded when recording),
+ * so any GITHUB_TOKEN value works against the mock.
+ *
+ * Responses come from, in order of precedence:
+ *   1. A replay file (--replay) of previously recorded responses, keyed by
+ *      a hash of the model and prompt messages
+ *   2. A script file (--script) of substring rules
+ *   3. Built-in responses that recognise each Budgeteer pipeline prompt
+ *      (single-pass planning, cherry-pick, reasoning, validation, list
+ *      generation, query analysis)
+ *      and answer with a well-formed payload derived from the prompt
+ *
+ * Requests with "stream": true are answered as server-sent events, one
+ * content delta per ~16 characters, ending with usage and "data: [DONE]".
+ *
+ * With --record <file> --upstream <url> the mock instead forwards every
+ * request to a real endpoint and appends the responses to <file>, which can
+ * later be served with --replay.
+ *
+ * Latency, jitter and error injection are decided from a hash of --seed, the
+ * prompt and how many times that prompt has been seen, so the n-th repeat of
+ * a prompt always behaves the same regardless of request interleaving.
+ *
+ * @author York Entrepreneurship Competition Team
+ * @date October 2025
+ * @version 1.0
+ */
+
+#include <httplib.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace {
+
+// ==================== Options ====================
+
+struct Options {
+    std::string host = "127.0.0.1";
+    int port = 8089;
+    int latencyMs = 0;                   ///< Base response latency
+    int jitterMs = 0;                    ///< Uniform +/- jitter around the base latency
+    double errorRate = 0.0;              ///< Fraction of requests answered with errorStatus
+    int errorStatus = 429;
+    uint64_t seed = 42;
+    std::string scriptFile;
+    std::string replayFile;
+    std::string recordFile;
+    std::string upstream;                ///< Base URL forwarded to in record mode
+};
+
+// ==================== Hashing ====================
+
+uint64_t fnv1a(const std::string& text, uint64_t hash = 1469598103934665603ULL) {
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/// SplitMix64 finaliser, turns a hash into well-distributed random bits
+uint64_t mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+double unitInterval(uint64_t bits) {
+    return static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/// Stable key for a request: model plus every message's role and content
+std::string promptKey(const json& request) {
+    std::string material = request.value("model", "");
+    if (request.contains("messages") && request["messages"].is_array()) {
+        for (const auto& message : request["messages"]) {
+            material += '\x1f';
+            material += message.value("role", "");
+            material += '\x1e';
+            material += message.value("content", "");
+        }
+    }
+    std::ostringstream key;
+    key << std::hex << fnv1a(material);
+    return key.str();
+}
+
+std::string lastUserMessage(const json& request) {
+    std::string content;
+    if (request.contains("messages") && request["messages"].is_array()) {
+        for (const auto& message : request["messages"]) {
+            if (message.value("role", "") == "user") {
+                content = message.value("content", "");
+            }
+        }
+    }
+    return content;
+}
+
+// ==================== Built-in responses ====================
+
+/// Text between the first pair of double quotes after marker
+std::string quotedAfter(const std::string& prompt, const std::string& marker) {
+    size_t pos = prompt.find(marker);
+    if (pos == std::string::npos) return "";
+    size_t open = prompt.find('"', pos + marker.size());
+    size_t close = open == std::string::npos ? std::string::npos : prompt.find('"', open + 1);
+    if (close == std::string::npos) return "";
+    return prompt.substr(open + 1, close - open - 1);
+}
+
+std::vector<std::string> words(const std::string& text) {
+    std::vector<std::string> result;
+    std::string word;
+    for (char c : text) {
+        if (std::isalpha(static_cast<unsigned char>(c))) {
+            word += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        } else if (!word.empty()) {
+            if (word.size() > 2) result.push_back(word);
+            word.clear();
+        }
+    }
+    if (word.size() > 2) result.push_back(word);
+    return result;
+}
+
+/// Numbered product lines ("12. Name") following "Available products:"
+std::vector<std::string> listedProducts(const std::string& prompt) {
+    std::vector<std::string> names;
+    size_t pos = prompt.find("Available products:");
+    if (pos == std::string::npos) return names;
+    std::istringstream lines(prompt.substr(pos));
+    std::string line;
+    std::getline(lines, line);
+    while (std::getline(lines, line)) {
+        size_t dot = line.find(". ");
+        if (dot == std::string::npos || dot == 0 || !std::isdigit(static_cast<unsigned char>(line[0]))) break;
+        names.push_back(line.substr(dot + 2));
+    }
+    return names;
+}
+
+/// Number of numbered candidate lines following "Candidate products"
+size_t candidateCount(const std::string& prompt) {
+    size_t pos = prompt.find("Candidate products");
+    if (pos == std::string::npos) return 0;
+    std::istringstream lines(prompt.substr(pos));
+    std::string line;
+    std::getline(lines, line);
+    size_t count = 0;
+    while (std::getline(lines, line) && !line.empty() && std::isdigit(static_cast<unsigned char>(line[0]))) {
+        count++;
+    }
+    return count;
+}
+
+std::string builtinResponse(const std::string& prompt) {
+    if (prompt.find("\"selected_ids\"") != std::string::npos) {
+        // Single-pass plan: pick every other candidate (up to a dozen), nothing missing
+        json selected = json::array();
+        size_t candidates = candidateCount(prompt);
+        for (size_t id = 1; id <= candidates && selected.size() < 12; id += 2) {
+            selected.push_back(id);
+        }
+        json missing = candidates == 0 ? json(words(quotedAfter(prompt, "shopping request:"))) : json::array();
+        return json{{"selected_ids", selected}, {"missing_products", missing}, {"excluded_ids", json::array()},
+                    {"complete", true}, {"reasoning", "Mock: every other candidate"}}.dump();
+    }
+    if (prompt.find("Available products:") != std::string::npos) {
+        // Cherry-pick: keep the first dozen candidates by number
+        json ids = json::array();
+        for (size_t id = 1; id <= listedProducts(prompt).size() && ids.size() < 12; id++) {
+            ids.push_back(id);
+        }
+        return ids.dump();
+    }
+    if (prompt.find("\"is_complete\"") != std::string::npos) {
+        return json{{"is_complete", true}, {"reasoning", "Mock: the list covers the request"},
+                    {"missing_items", json::array()}, {"unnecessary_ids", json::array()}}.dump();
+    }
+    if (prompt.find("\"remove_ids\"") != std::string::npos) {
+        return json{{"remove_ids", json::array()}, {"reason", "All items are valid"}}.dump();
+    }
+    if (prompt.find("\"search_terms\"") != std::string::npos) {
+        size_t pos = prompt.find("User query: ");
+        std::string query = pos == std::string::npos ? "" : prompt.substr(pos + 12, prompt.find('\n', pos) - pos - 12);
+        auto terms = words(query);
+        return json{{"intent", "search"}, {"products", terms}, {"budget", nullptr},
+                    {"stores", json::array()}, {"search_terms", terms}}.dump();
+    }
+    if (prompt.find("\"items\":") != std::string::npos) {
+        auto terms = words(quotedAfter(prompt, "shopping request:"));
+        std::vector<std::string> items = {"milk", "eggs", "bread", "butter", "cheese"};
+        items.insert(items.end(), terms.begin(), terms.end());
+        return json{{"items", items}, {"reasoning", "Mock: staples plus the requested products"}}.dump();
+    }
+    return "Mock response from budgeteer_mock_llm.";
+}
+
+// ==================== Mock state ====================
+
+struct ScriptRule {
+    std::string match;
+    std::string response;
+    int status;
+};
+
+class MockState {
+private:
+    Options options;
+    std::vector<ScriptRule> rules;
+    std::unordered_map<std::string, std::string> replay;
+    std::unordered_map<std::string, uint64_t> seenCount;
+    std::mutex mutex;
+    std::mutex recordMutex;
+
+public:
+    std::atomic<uint64_t> requests{0};
+    std::atomic<uint64_t> injectedErrors{0};
+    std::atomic<uint64_t> replayHits{0};
+    std::atomic<uint64_t> scriptHits{0};
+    std::atomic<uint64_t> builtinHits{0};
+
+    explicit MockState(Options opts) : options(std::move(opts)) {}
+
+    const Options& getOptions() const { return options; }
+
+    bool loadScript(const std::string& path) {
+        std::ifstream in(path);
+        if (!in.is_open()) return false;
+        json script = json::parse(in, nullptr, false);
+        if (script.is_discarded()) return false;
+        const json& list = script.is_array() ? script : script.value("rules", json::array());
+        for (const auto& rule : list) {
+            rules.push_back({rule.value("match", ""), rule.value("response", ""), rule.value("status", 200)});
+        }
+        return true;
+    }
+
+    /// Replay files hold one {"key": ..., "content": ...} object per line
+    bool loadReplay(const std::string& path) {
+        std::ifstream in(path);
+        if (!in.is_open()) return false;
+        std::string line;
+        while (std::getline(in, line)) {
+            json entry = json::parse(line, nullptr, false);
+            if (!entry.is_discarded() && entry.contains("key")) {
+                replay[entry["key"].get<std::string>()] = entry.value("content", "");
+            }
+        }
+        return true;
+    }
+
+    void appendRecording(const std::string& key, const std::string& content) {
+        std::lock_guard<std::mutex> lock(recordMutex);
+        std::ofstream out(options.recordFile, std::ios::app);
+        out << json{{"key", key}, {"content", content}}.dump() << "\n";
+    }
+
+    /// Random bits for the n-th occurrence of this prompt
+    uint64_t occurrenceBits(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        uint64_t occurrence = seenCount[key]++;
+        return mix(options.seed ^ fnv1a(key) ^ mix(occurrence));
+    }
+
+    /// Scripted or replayed content; status 0 means "no match"
+    std::pair<int, std::string> lookup(const std::string& key, const std::string& prompt) {
+        auto it = replay.find(key);
+        if (it != replay.end()) {
+            replayHits++;
+            return {200, it->second};
+        }
+        for (const auto& rule : rules) {
+            if (rule.match.empty() || prompt.find(rule.match) != std::string::npos) {
+                scriptHits++;
+                return {rule.status, rule.response};
+            }
+        }
+        builtinHits++;
+        return {200, builtinResponse(prompt)};
+    }
+};
+
+json completion(const json& request, const std::string& content, uint64_t id) {
+    const std::string prompt = lastUserMessage(request);
+    int promptTokens = static_cast<int>(prompt.size() / 4) + 1;
+    int completionTokens = static_cast<int>(content.size() / 4) + 1;
+    return {
+        {"id", "mock-" + std::to_string(id)},
+        {"object", "chat.completion"},
+        {"model", request.value("model", "mock")},
+        {"choices", json::array({
+            {{"index", 0}, {"message", {{"role", "assistant"}, {"content", content}}}, {"finish_reason", "stop"}}
+        })},
+        {"usage", {{"prompt_tokens", promptTokens}, {"completion_tokens", completionTokens},
+                   {"total_tokens", promptTokens + completionTokens}}}
+    };
+}
+
+/// The same completion as "stream": true server-sent events, about 16 characters per delta
+std::vector<std::string> completionEvents(const json& request, const std::string& content, uint64_t id) {
+    json full = completion(request, content, id);
+    json chunk = {
+        {"id", full["id"]},
+        {"object", "chat.completion.chunk"},
+        {"model", full["model"]}
+    };
+
+    std::vector<std::string> events;
+    for (size_t pos = 0; pos < content.size(); pos += 16) {
+        chunk["choices"] = json::array({{{"index", 0}, {"delta", {{"content", content.substr(pos, 16)}}}}});
+        events.push_back("data: " + chunk.dump() + "\n\n");
+    }
+    chunk["choices"] = json::array({{{"index", 0}, {"delta", json::object()}, {"finish_reason", "stop"}}});
+    chunk["usage"] = full["usage"];
+    events.push_back("data: " + chunk.dump() + "\n\n");
+    events.push_back("data: [DONE]\n\n");
+    return events;
+}
+
+/// Forward a request to the upstream endpoint (record mode)
+httplib::Result forward(const Options& options, const httplib::Request& req) {
+    size_t schemeEnd = options.upstream.find("://");
+    size_t pathStart = options.upstream.find('/', schemeEnd == std::string::npos ? 0 : schemeEnd + 3);
+    std::string origin = options.upstream.substr(0, pathStart);
+    std::string basePath = pathStart == std::string::npos ? "" : options.upstream.substr(pathStart);
+
+    httplib::Client cli(origin);
+    cli.set_connection_timeout(10, 0);
+    cli.set_read_timeout(60, 0);
+    httplib::Headers headers;
+    if (req.has_header("Authorization")) {
+        headers.emplace("Authorization", req.get_header_value("Authorization"));
+    }
+    return cli.Post(basePath + "/chat/completions", headers, req.body, "application/json");
+}
+
+void handleCompletion(MockState& state, const httplib::Request& req, httplib::Response& res) {
+    const Options& options = state.getOptions();
+    uint64_t id = ++state.requests;
+
+    json request = json::parse(req.body, nullptr, false);
+    if (request.is_discarded()) {
+        res.status = 400;
+        res.set_content(R"({"error":{"message":"invalid JSON body"}})", "application/json");
+        return;
+    }
+
+    const std::string key = promptKey(request);
+
+    if (!options.recordFile.empty()) {
+        auto upstream = forward(options, req);
+        if (!upstream) {
+            res.status = 502;
+            res.set_content(R"({"error":{"message":"upstream unreachable"}})", "application/json");
+            return;
+        }
+        if (upstream->status == 200) {
+            json body = json::parse(upstream->body, nullptr, false);
+            if (!body.is_discarded() && body.contains("choices")) {
+                state.appendRecording(key, body["choices"][0]["message"].value("content", ""));
+            }
+        }
+        res.status = upstream->status;
+        res.set_content(upstream->body, "application/json");
+        return;
+    }
+
+    uint64_t bits = state.occurrenceBits(key);
+    int delayMs = options.latencyMs;
+    if (options.jitterMs > 0) {
+        delayMs += static_cast<int>(bits % static_cast<uint64_t>(2 * options.jitterMs + 1)) - options.jitterMs;
+    }
+    if (delayMs > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+    }
+
+    if (unitInterval(mix(bits)) < options.errorRate) {
+        state.injectedErrors++;
+        res.status = options.errorStatus;
+        if (options.errorStatus == 429) res.set_header("Retry-After", "1");
+        res.set_content(R"({"error":{"message":"injected by budgeteer_mock_llm"}})", "application/json");
+        return;
+    }
+
+    auto [status, content] = state.lookup(key, lastUserMessage(request));
+    if (status != 200) {
+        res.status = status;
+        res.set_content(json{{"error", {{"message", content}}}}.dump(), "application/json");
+        return;
+    }
+    if (!request.value("stream", false)) {
+        res.set_content(completion(request, content, id).dump(), "application/json");
+        return;
+    }
+
+    auto events = std::make_shared<std::vector<std::string>>(completionEvents(request, content, id));
+    res.set_chunked_content_provider("text/event-stream", [events, next = size_t{0}](size_t, httplib::DataSink& sink) mutable {
+        if (next == events->size()) {
+            sink.done();
+            return true;
+        }
+        const std::string& event = (*events)[next++];
+        return sink.write(event.data(), event.size());
+    });
+}
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n\n";
+    std::cout << "Options:\n";
+    std::cout << "  --host <addr>          Bind address (default: 127.0.0.1)\n";
+    std::cout << "  --port <num>           Port (default: 8089)\n";
+    std::cout << "  --latency-ms <n>       Base response latency (default: 0)\n";
+    std::cout << "  --jitter-ms <n>        Uniform +/- latency jitter (default: 0)\n";
+    std::cout << "  --error-rate <p>       Fraction of requests that fail (default: 0)\n";
+    std::cout << "  --error-status <code>  Status used for injected errors (default: 429)\n";
+    std::cout << "  --seed <n>             Seed for latency and error decisions (default: 42)\n";
+    std::cout << "  --script <file>        JSON rules: [{\"match\": \"...\", \"response\": \"...\", \"status\": 200}]\n";
+    std::cout << "  --replay <file>        Serve responses recorded with --record\n";
+    std::cout << "  --record <file>        Forward to --upstream and append responses to <file>\n";
+    std::cout << "  --upstream <url>       Upstream base URL for recording (default: https://models.github.ai/inference)\n";
+}
+
+Options parseArgs(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::cerr << "Error: " << arg << " requires a value" << std::endl;
+                std::exit(1);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--host") options.host = next();
+        else if (arg == "--port") options.port = std::stoi(next());
+        else if (arg == "--latency-ms") options.latencyMs = std::max(0, std::stoi(next()));
+        else if (arg == "--jitter-ms") options.jitterMs = std::max(0, std::stoi(next()));
+        else if (arg == "--error-rate") options.errorRate = std::stod(next());
+        else if (arg == "--error-status") options.errorStatus = std::stoi(next());
+        else if (arg == "--seed") options.seed = std::stoull(next());
+        else if (arg == "--script") options.scriptFile = next();
+        else if (arg == "--replay") options.replayFile = next();
+        else if (arg == "--record") options.recordFile = next();
+        else if (arg == "--upstream") options.upstream = next();
+        else if (arg == "--help") {
+            printUsage(argv[0]);
+            std::exit(0);
+        } else {
+            std::cerr << "Error: unknown option " << arg << std::endl;
+            printUsage(argv[0]);
+            std::exit(1);
+        }
+    }
+    if (!options.recordFile.empty() && options.upstream.empty()) {
+        options.upstream = "https://models.github.ai/inference";
+    }
+    return options;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    MockState state(parseArgs(argc, argv));
+    const Options& options = state.getOptions();
+
+    if (!options.scriptFile.empty() && !state.loadScript(options.scriptFile)) {
+        std::cerr << "[MockLLM] Could not load script " << options.scriptFile << std::endl;
+        return 1;
+    }
+    if (!options.replayFile.empty() && !state.loadReplay(options.replayFile)) {
+        std::cerr << "[MockLLM] Could not load replay file " << options.replayFile << std::endl;
+        return 1;
+    }
+
+    httplib::Server svr;
+    auto completions = [&state](const httplib::Request& req, httplib::Response& res) {
+        handleCompletion(state, req, res);
+    };
+    svr.Post("/inference/chat/completions", completions);
+    svr.Post("/chat/completions", completions);
+
+    svr.Get("/health", [](const httplib::Request&, httplib::Response& res) {
+        res.set_content(R"({"status":"ok"})", "application/json");
+    });
+    svr.Get("/stats", [&state](const httplib::Request&, httplib::Response& res) {
+        json stats = {
+            {"requests", state.requests.load()},
+            {"injected_errors", state.injectedErrors.load()},
+            {"replay_hits", state.replayHits.load()},
+            {"script_hits", state.scriptHits.load()},
+            {"builtin_hits", state.builtinHits.load()}
+        };
+        res.set_content(stats.dump(2), "application/json");
+    });
+
+    std::cout << "[MockLLM] Listening on http://" << options.host << ":" << options.port << "/inference" << std::endl;
+    std::cout << "[MockLLM] latency=" << options.latencyMs << "ms jitter=" << options.jitterMs
+              << "ms error_rate=" << options.errorRate << " seed=" << options.seed;
+    if (!options.recordFile.empty()) std::cout << " recording to " << options.recordFile << " via " << options.upstream;
+    if (!options.replayFile.empty()) std::cout << " replaying " << options.replayFile;
+    std::cout << std::endl;
+
+    if (!svr.listen(options.host.c_str(), options.port)) {
+        std::cerr << "[MockLLM] Failed to bind " << options.host << ":" << options.port << std::endl;
+        return 1;
+    }
+    return 0;
+}